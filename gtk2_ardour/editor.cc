@@ -4697,6 +4697,8 @@ Editor::visual_changer (const VisualChange& vc)
 	}
 
 	_summary->set_overlays_dirty ();
+
+	prioritize_visible_peak_building ();
 }
 
 struct EditorOrderTimeAxisSorter {
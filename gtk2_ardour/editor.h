@@ -1121,6 +1121,7 @@ class Editor : public PublicEditor, public PBD::ScopedConnectionList, public ARD
 	sigc::connection control_scroll_connection;
 
 	void tie_vertical_scrolling ();
+	void prioritize_visible_peak_building ();
 	void set_horizontal_position (double);
 	double horizontal_position () const;
 
@@ -23,9 +23,12 @@
 
 #include "gtkmm2ext/utils.h"
 
+#include "ardour/audioregion.h"
+#include "ardour/playlist.h"
 #include "ardour/profile.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/smf_source.h"
+#include "ardour/source_factory.h"
 
 #include "pbd/error.h"
 
@@ -903,6 +906,58 @@ Editor::tie_vertical_scrolling ()
 	if (pending_visual_change.idle_handler_id < 0) {
 		_summary->set_overlays_dirty ();
 	}
+
+	prioritize_visible_peak_building ();
+}
+
+/** Have the peak-building threads start with the sources of audio
+ *  regions that are currently visible in the editor.
+ */
+void
+Editor::prioritize_visible_peak_building ()
+{
+	if (!_session || SourceFactory::peak_work_queue_length () == 0) {
+		return;
+	}
+
+	framepos_t const start = leftmost_frame;
+	framepos_t const end = leftmost_frame + current_page_samples ();
+	double const top = vertical_adjustment.get_value ();
+	double const bottom = top + vertical_adjustment.get_page_size ();
+
+	/* the queue is LIFO as far as prioritizing goes, so walk the
+	   tracks bottom-up to leave the top-most first in line.
+	*/
+	for (TrackViewList::reverse_iterator t = track_views.rbegin(); t != track_views.rend(); ++t) {
+
+		RouteTimeAxisView* rtv = dynamic_cast<RouteTimeAxisView*> (*t);
+
+		if (!rtv || rtv->hidden() || !rtv->is_audio_track()) {
+			continue;
+		}
+
+		if (rtv->y_position() > bottom || rtv->y_position() + rtv->effective_height() < top) {
+			continue;
+		}
+
+		boost::shared_ptr<Playlist> pl = rtv->track()->playlist ();
+
+		if (!pl) {
+			continue;
+		}
+
+		boost::shared_ptr<RegionList> rl = pl->regions_touched (start, end);
+
+		for (RegionList::iterator r = rl->begin(); r != rl->end(); ++r) {
+			boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*r);
+			if (!ar) {
+				continue;
+			}
+			for (uint32_t n = 0; n < ar->n_channels(); ++n) {
+				SourceFactory::prioritize_peak_building (ar->audio_source (n));
+			}
+		}
+	}
 }
 
 void
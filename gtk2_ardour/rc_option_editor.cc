@@ -2156,6 +2156,36 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("General"), procs);
+
+		bo = new BoolOption (
+			"use-work-stealing-scheduler",
+			_("Use lock-free work-stealing DSP scheduler"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_use_work_stealing_scheduler),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_use_work_stealing_scheduler)
+			);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, each signal processing thread keeps its own queue of routes and takes work from other threads when it runs out, instead of sharing a single locked queue. This may reduce DSP overhead with many routes and small buffer sizes."));
+		add_option (_("General"), bo);
+
+		bo = new BoolOption (
+			"graph-critical-path-scheduling",
+			_("Start the most expensive signal paths first"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_critical_path_scheduling),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_critical_path_scheduling)
+			);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, the DSP time of each track and bus is measured, and the ones with the most processing between them and the master bus are started first. This can help sessions where a few tracks carry heavy plugin chains."));
+		add_option (_("General"), bo);
+
+		bo = new BoolOption (
+			"graph-split-sends",
+			_("Process aux sends separately from their tracks"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_split_sends),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_split_sends)
+			);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, the panning and gain of each aux send is done separately from the rest of the track or bus that it belongs to, so that it can run on another processor core."));
+		add_option (_("General"), bo);
 	}
 
 	/* Image cache size */
@@ -2238,6 +2268,15 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("General/Session"), new UndoOptions (_rc_config));
 
+	add_option (_("General/Session"),
+	     new SpinOption<uint32_t> (
+		     "history-memory-limit",
+		     _("Memory for undo history (MB, 0 for no limit)"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_history_memory_limit),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_history_memory_limit),
+		     0, 65536, 16, 256
+		     ));
+
 	add_option (_("General/Session"),
 	     new BoolOption (
 		     "verify-remove-last-capture",
@@ -2685,6 +2724,15 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("Audio"), new BufferingOptions (_rc_config));
 
+	add_option (_("Audio"),
+	     new SpinOption<uint32_t> (
+		     "disk-io-threads",
+		     _("Number of threads used for disk reading and writing"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_disk_io_threads),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_disk_io_threads),
+		     1, 32, 1, 4
+		     ));
+
 	add_option (_("Audio"), new OptionEditorHeading (_("Denormals")));
 
 	add_option (_("Audio"),
@@ -3353,6 +3401,15 @@ RCOptionEditor::RCOptionEditor ()
 	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
 					    _("<b>When enabled</b> plugins will be activated when they are added to tracks/busses. When disabled plugins will be left inactive when they are added to tracks/busses"));
 
+	add_option (_("Plugins"),
+	     new SpinOption<uint32_t> (
+		     "plugin-worker-threads",
+		     _("Number of threads used for plugin background work"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugin_worker_threads),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugin_worker_threads),
+		     1, 16, 1, 4
+		     ));
+
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 	add_option (_("Plugins/VST"), new OptionEditorHeading (_("VST")));
 #if 0
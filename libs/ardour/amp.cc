@@ -108,13 +108,17 @@ Amp::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_frame*/,
 			const double a = 156.825 / _session.nominal_frame_rate(); // 25 Hz LPF; see Amp::apply_gain for details
 			double lpf = _current_gain;
 
+			/* smooth the automation data in place, once for all channels,
+			 * then apply the smoothed gain curve to each of them.
+			 */
+			for (pframes_t nx = 0; nx < nframes; ++nx) {
+				const double target = gab[nx];
+				gab[nx] = lpf;
+				lpf += a * (target - lpf);
+			}
+
 			for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-				Sample* const sp = i->data();
-				lpf = _current_gain;
-				for (pframes_t nx = 0; nx < nframes; ++nx) {
-					sp[nx] *= lpf;
-					lpf += a * (gab[nx] - lpf);
-				}
+				apply_gain_curve_to_buffer (i->data(), nframes, gab);
 			}
 
 			if (fabs (lpf) < GAIN_COEFF_TINY) {
@@ -210,18 +214,28 @@ Amp::apply_gain (BufferSet& bufs, framecnt_t sample_rate, framecnt_t nframes, ga
 	 */
 	const double a = 156.825 / sample_rate; // 25 Hz LPF
 
-	for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-		Sample* const buffer = i->data();
-		double lpf = initial;
+	/* The ramp is the same for every channel: compute it a block at a
+	 * time, and apply each block to all of them.
+	 */
+	gain_t ramp[256];
+	double lpf = initial;
+
+	for (framecnt_t offset = 0; offset < nframes; offset += 256) {
+		const framecnt_t n = std::min ((framecnt_t) 256, nframes - offset);
 
-		for (pframes_t nx = 0; nx < nframes; ++nx) {
-			buffer[nx] *= lpf;
+		for (framecnt_t nx = 0; nx < n; ++nx) {
+			ramp[nx] = lpf;
 			lpf += a * (target - lpf);
 		}
-		if (i == bufs.audio_begin()) {
-			rv = lpf;
+
+		for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
+			apply_gain_curve_to_buffer (i->data() + offset, n, ramp);
 		}
 	}
+
+	if (bufs.count().n_audio() > 0) {
+		rv = lpf;
+	}
 	if (fabsf (rv - target) < GAIN_COEFF_TINY) return target;
 	if (fabsf (rv) < GAIN_COEFF_TINY) return GAIN_COEFF_ZERO;
 	return rv;
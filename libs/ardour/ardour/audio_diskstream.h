@@ -211,7 +211,7 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 
 	/* The two central butler operations */
 	int do_flush (RunContext context, bool force = false);
-	int do_refill () { return _do_refill(_mixdown_buffer, _gain_buffer, 0); }
+	int do_refill ();
 
 
 	int read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
@@ -250,6 +250,8 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 	// Working buffers for do_refill (butler thread)
 	static void allocate_working_buffers();
 	static void free_working_buffers();
+	/* private working buffers for additional (parallel) butler threads */
+	static void allocate_thread_working_buffers();
 
 	static Sample* _mixdown_buffer;
 	static gain_t* _gain_buffer;
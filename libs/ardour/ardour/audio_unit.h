@@ -85,7 +85,7 @@ class LIBARDOUR_API AUPlugin : public ARDOUR::Plugin
 
 	int connect_and_run (BufferSet& bufs,
 			framepos_t start, framepos_t end, double speed,
-			ChanMapping in, ChanMapping out,
+			ChanMapping const& in, ChanMapping const& out,
 			pframes_t nframes, framecnt_t offset);
 	std::set<Evoral::Parameter> automatable() const;
 	std::string describe_parameter (Evoral::Parameter);
@@ -216,7 +216,7 @@ class LIBARDOUR_API AUPlugin : public ARDOUR::Plugin
 	framecnt_t input_offset;
 	framecnt_t *cb_offsets;
 	BufferSet* input_buffers;
-	ChanMapping * input_map;
+	ChanMapping const * input_map;
 	framecnt_t frames_processed;
 	uint32_t   audio_input_cnt;
 
@@ -25,6 +25,7 @@
 #include <boost/enable_shared_from_this.hpp>
 
 #include <time.h>
+#include <vector>
 
 #include <glibmm/threads.h>
 #include <boost/function.hpp>
@@ -36,6 +37,8 @@
 #include "pbd/stateful.h"
 #include "pbd/xml++.h"
 
+class PeakfileLevelsTest;
+
 namespace ARDOUR {
 
 class LIBARDOUR_API AudioSource : virtual public Source,
@@ -169,6 +172,27 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	struct PeakLevel {
+		PeakLevel (framecnt_t f, off_t o, framecnt_t n) : fpp (f), offset (o), npeaks (n) {}
+		framecnt_t fpp;    ///< frames per peak
+		off_t      offset; ///< byte offset of the level's first peak in the peakfile
+		framecnt_t npeaks;
+	};
+
+	/** The levels of peak data in our peakfile, finest first. Empty if the
+	 *  peakfile holds a single level of peaks (as all peakfiles written
+	 *  before the multi-level format do) or is being (re)written.
+	 */
+	std::vector<PeakLevel> _peak_levels;
+	mutable Glib::Threads::Mutex _peak_levels_lock;
+
+	off_t load_peak_levels (off_t file_size);
+	int write_peak_levels (int fd, framecnt_t npeaks);
+	framecnt_t peak_level_fpp (double samples_per_visual_peak) const;
+	bool peak_level_offset (framecnt_t fpp, off_t& offset) const;
+
+	friend class ::PeakfileLevelsTest;
 };
 
 }
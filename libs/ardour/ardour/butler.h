@@ -22,11 +22,14 @@
 
 #include <pthread.h>
 
+#include <vector>
+
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/pool.h"
+#include "pbd/semutils.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/session_handle.h"
@@ -35,6 +38,8 @@
 
 namespace ARDOUR {
 
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -92,6 +97,43 @@ private:
 	void config_changed (std::string);
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
+	bool refill_tracks (RouteList const &);
+
+	/* Disk I/O worker threads. For each refill or flush pass the butler
+	 * queues the tracks, emptiest buffers first, and then works through
+	 * the queue together with the workers.
+	 */
+	enum JobType {
+		Refill,
+		Flush
+	};
+
+	struct Job {
+		Job (boost::shared_ptr<Track> t, float l) : tracks (1, t), load (l) {}
+		bool operator< (Job const & other) const { return load < other.load; }
+		/** Tracks that share a playlist are refilled by one job, since
+		 *  playlist reads (MidiPlaylist's note trackers in particular) must
+		 *  not run in two threads at once.
+		 */
+		std::vector<boost::shared_ptr<Track> > tracks;
+		float load;
+	};
+
+	static void* _worker_thread_work (void *arg);
+	void worker_thread_work ();
+	void set_worker_count (uint32_t);
+	bool run_jobs (JobType, uint32_t& errors);
+	void process_jobs ();
+
+	std::vector<pthread_t> _workers;
+	PBD::Semaphore         _worker_start_sem;
+	PBD::Semaphore         _worker_done_sem;
+	bool                   _workers_should_quit;
+	std::vector<Job>       _jobs;
+	JobType                _job_type;
+	volatile gint          _next_job;
+	volatile gint          _job_work_outstanding;
+	volatile gint          _job_errors;
 
 	/**
 	 * Add request to butler thread request queue
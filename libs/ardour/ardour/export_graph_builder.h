@@ -27,7 +27,6 @@
 #include "audiographer/utils/identity_vertex.h"
 
 #include <boost/ptr_container/ptr_list.hpp>
-#include <glibmm/threadpool.h>
 
 namespace AudioGrapher {
 	class SampleRateConverter;
@@ -41,7 +40,8 @@ namespace AudioGrapher {
 	template <typename T> class SndfileWriter;
 	template <typename T> class SilenceTrimmer;
 	template <typename T> class TmpFile;
-	template <typename T> class Threader;
+	template <typename T> class WorkerThreader;
+	class WorkerThreads;
 	template <typename T> class AllocatingProcessContext;
 }
 
@@ -64,10 +64,13 @@ class LIBARDOUR_API ExportGraphBuilder
 
   public:
 
-	ExportGraphBuilder (Session const & session);
+	ExportGraphBuilder (Session const & session, AudioGrapher::WorkerThreads & workers);
 	~ExportGraphBuilder ();
 
-	int process (framecnt_t frames, bool last_cycle);
+	/** Process @param frames of the channels, starting @param offset frames
+	 *  into the current cycle.
+	 */
+	int process (framecnt_t frames, bool last_cycle, framecnt_t offset = 0);
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -165,7 +168,7 @@ class LIBARDOUR_API ExportGraphBuilder
 		typedef boost::shared_ptr<AudioGrapher::LoudnessReader> LoudnessReaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::Normalizer> NormalizerPtr;
 		typedef boost::shared_ptr<AudioGrapher::TmpFile<Sample> > TmpFilePtr;
-		typedef boost::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
+		typedef boost::shared_ptr<AudioGrapher::WorkerThreader<Sample> > ThreaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::AllocatingProcessContext<Sample> > BufferPtr;
 
 		void prepare_post_processing ();
@@ -269,7 +272,7 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	bool _realtime;
 
-	Glib::ThreadPool thread_pool;
+	AudioGrapher::WorkerThreads & workers;
 };
 
 } // namespace ARDOUR
@@ -22,6 +22,7 @@
 #define __ardour_export_handler_h__
 
 #include <map>
+#include <vector>
 
 #include <boost/operators.hpp>
 #include <boost/shared_ptr.hpp>
@@ -38,6 +39,7 @@
 
 namespace AudioGrapher {
 	class BroadcastInfo;
+	class WorkerThreads;
 }
 
 namespace ARDOUR
@@ -126,11 +128,9 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 
   private:
 
-	void handle_duplicate_format_extensions();
 	int process (framecnt_t frames);
 
 	Session &          session;
-	boost::shared_ptr<ExportGraphBuilder> graph_builder;
 	ExportStatusPtr    export_status;
 
 	/* The timespan and corresponding file specifications that we are exporting;
@@ -143,17 +143,41 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 
 	/* Timespan management */
 
+	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
+
 	void start_timespan ();
 	int  process_timespan (framecnt_t frames);
 	int  post_process ();
 	void finish_timespan ();
+	void handle_duplicate_format_extensions (TimespanBounds const &);
+	bool can_share_pass (ExportTimespanPtr);
 
-	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
-	ExportTimespanPtr     current_timespan;
-	TimespanBounds        timespan_bounds;
+	/* A timespan exported in the current pass over the session. Several
+	   timespans close to each other can be exported in one pass (see
+	   the export-timespans-in-one-pass option), each to its own graph.
+	*/
+	struct TimespanExport {
+		TimespanExport (ExportTimespanPtr ts, boost::shared_ptr<ExportGraphBuilder> gb)
+		  : timespan (ts)
+		  , graph_builder (gb)
+		  , written (false)
+			{}
+
+		ExportTimespanPtr                     timespan;
+		boost::shared_ptr<ExportGraphBuilder> graph_builder;
+		bool                                  written; /* all of the timespan has been processed */
+	};
+
+	/* in order of their start */
+	std::vector<TimespanExport> current_timespans;
+	/* threads shared by the graphs, which are processed one at a time */
+	boost::shared_ptr<AudioGrapher::WorkerThreads> graph_workers;
+	/* one per timespan of the largest pass so far, reused by later passes */
+	std::vector<boost::shared_ptr<ExportGraphBuilder> > graph_builders;
 
 	PBD::ScopedConnection process_connection;
 	framepos_t             process_position;
+	framepos_t             process_end;
 
 	/* CD Marker stuff */
 
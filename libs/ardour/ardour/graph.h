@@ -31,6 +31,7 @@
 #include <glib.h>
 
 #include "pbd/semutils.h"
+#include "pbd/work_stealing_deque.h"
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -56,6 +57,7 @@ class LIBARDOUR_API Graph : public SessionHandleRef
 {
 public:
 	Graph (Session & session);
+	~Graph ();
 
 	void prep();
 	void trigger (GraphNode * n);
@@ -67,6 +69,7 @@ public:
 	void restart_cycle();
 
 	bool run_one();
+	bool run_one_work_stealing();
 	void helper_thread();
 	void main_thread();
 
@@ -93,6 +96,11 @@ private:
 
 	void reset_thread_list ();
 	void drop_threads ();
+	bool run ();
+	void wake_threads (int n);
+	void process_node (GraphNode*);
+	void update_critical_path (int chain);
+	void split_sends (int chain, GraphEdges const &);
 
 	node_list_t _nodes_rt[2];
 
@@ -103,13 +111,44 @@ private:
 
 	PBD::Semaphore _execution_sem;
 
+	/* Work-stealing scheduler: every process thread owns one deque per
+	 * chain, pushes the nodes it triggers onto it and steals from the
+	 * others when it runs dry. Selected per chain at rechain() time.
+	 */
+	typedef PBD::WorkStealingDeque<GraphNode> WorkQueue;
+	typedef std::vector<WorkQueue*> WorkQueues;
+
+	void setup_work_queues (int chain);
+	GraphNode* find_work (int chain);
+
+	bool        _work_stealing[2];
+	WorkQueues  _work_queues[2];
+	WorkQueues  _retired_work_queues;
+
+	/** All nodes of a chain, nodes without input first (cache aligned) */
+	GraphNode** _node_array[2];
+	uint32_t    _node_array_size[2];
+	uint32_t    _n_init_triggers[2];
+
+	/* Critical-path-first scheduling: when enabled, node DSP cost is
+	 * measured and the initial nodes are queued so that the ones with the
+	 * longest estimated path to the end of the graph start first.
+	 */
+	bool     _critical_path_scheduling[2];
+	uint32_t _critical_path_countdown;
+
+	/** The number of nodes queued for the work-stealing scheduler */
+	volatile gint _work_pending;
+	/** The number of processing threads that are asleep, with either scheduler */
+	volatile gint _idle_thread_cnt;
+	/** Used to hand out per-thread work queue indices */
+	volatile gint _n_worker_threads;
+
 	/** Signalled to start a run of the graph for a process callback */
 	PBD::Semaphore _callback_start_sem;
 	PBD::Semaphore _callback_done_sem;
 	PBD::Semaphore _cleanup_sem;
 
-	/** The number of processing threads that are asleep */
-	volatile gint _execution_tokens;
 	/** The number of unprocessed nodes that do not feed any other node; updated during processing */
 	volatile gint _finished_refcount;
 	/** The initial number of nodes that do not feed any other node (for each chain) */
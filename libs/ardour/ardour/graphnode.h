@@ -27,11 +27,14 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include "ardour/types.h"
+
 namespace ARDOUR
 {
 
 class Graph;
 class GraphNode;
+class InternalSend;
 
 typedef boost::shared_ptr<GraphNode> node_ptr_t;
 typedef std::set< node_ptr_t > node_set_t;
@@ -44,12 +47,21 @@ class LIBARDOUR_API GraphNode
 	GraphNode( boost::shared_ptr<Graph> Graph );
 	virtual ~GraphNode();
 
-	void prep( int chain );
+	virtual void prep( int chain );
 	void dec_ref();
 	void finish( int chain );
 
 	virtual void process();
 
+	/** @return smoothed time (in usecs) that processing this node takes */
+	float dsp_cost () const { return _dsp_cost; }
+	/** @return estimated time (in usecs) from the start of this node until
+	 *  all nodes that it (indirectly) feeds in @param chain have been processed.
+	 */
+	float critical_path (int chain) const { return _critical_path[chain]; }
+
+	void update_dsp_cost (microseconds_t elapsed);
+
     private:
 	friend class Graph;
 
@@ -61,6 +73,30 @@ class LIBARDOUR_API GraphNode
 	gint _refcount;
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	gint _init_refcount[2];
+
+	float _dsp_cost;
+	/** Critical path estimate for each chain, since the process thread
+	 *  updates the current chain's while rechain() sets up the other.
+	 */
+	float _critical_path[2];
+};
+
+/** A node which does the processing of an aux send, after the route that
+ *  it sends from has copied the send's input, so that the send need not
+ *  hold up the rest of that route.
+ */
+class LIBARDOUR_API SendGraphNode : public GraphNode
+{
+    public:
+	SendGraphNode (boost::shared_ptr<Graph> graph, boost::shared_ptr<InternalSend> send);
+
+	void prep (int chain);
+	void process ();
+
+	boost::shared_ptr<InternalSend> send () const { return _send; }
+
+    private:
+	boost::shared_ptr<InternalSend> _send;
 };
 
 }
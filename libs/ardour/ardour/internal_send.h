@@ -41,6 +41,13 @@ class LIBARDOUR_API InternalSend : public Send
 
 	void cycle_start (pframes_t);
 	void run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, double speed, pframes_t nframes, bool);
+
+	/** Make the next run() just copy its input, and leave the rest of
+	 *  our processing to run_deferred(), which the process graph calls
+	 *  once the route that we send from has been processed.
+	 */
+	void defer_to_graph () { _deferred = true; }
+	void run_deferred ();
 	bool feeds (boost::shared_ptr<Route> other) const;
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
 	bool configure_io (ChanCount in, ChanCount out);
@@ -64,6 +71,13 @@ class LIBARDOUR_API InternalSend : public Send
 
   private:
 	BufferSet mixbufs;
+	BufferSet inbufs; ///< copy of our input, when our processing is deferred
+	bool _deferred;
+	bool _deferred_pending;
+	framepos_t _deferred_start_frame;
+	framepos_t _deferred_end_frame;
+	double _deferred_speed;
+	pframes_t _deferred_nframes;
 	boost::shared_ptr<Route> _send_from;
 	boost::shared_ptr<Route> _send_to;
 	bool _allow_feedback;
@@ -72,6 +86,7 @@ class LIBARDOUR_API InternalSend : public Send
 	PBD::ScopedConnection source_connection;
 	PBD::ScopedConnectionList target_connections;
 
+	void send_buffers (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, double speed, pframes_t nframes);
 	void send_from_going_away ();
 	void send_to_going_away ();
 	void send_to_property_changed (const PBD::PropertyChange&);
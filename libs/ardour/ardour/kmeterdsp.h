@@ -30,6 +30,9 @@ public:
     ~Kmeterdsp (void);
 
     void process (float const *p, int n);
+    // Process n_meters channels, buffer p[i] for meters[i],
+    // several channels at once (see ARDOUR::meter_lanes).
+    static void process (Kmeterdsp * const *meters, float const * const *p, int n_meters, int n);
     float read ();
     void reset ();
 
@@ -37,6 +40,8 @@ public:
 
 private:
 
+    void store (float z1, float z2);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _rms;         // max rms value since last read()
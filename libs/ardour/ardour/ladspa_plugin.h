@@ -84,7 +84,7 @@ class LIBARDOUR_API LadspaPlugin : public ARDOUR::Plugin
 
 	int connect_and_run (BufferSet& bufs,
 			framepos_t start, framepos_t end, double speed,
-			ChanMapping in, ChanMapping out,
+			ChanMapping const& in, ChanMapping const& out,
 			pframes_t nframes, framecnt_t offset);
 
 	std::string describe_parameter (Evoral::Parameter);
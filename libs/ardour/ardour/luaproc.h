@@ -89,9 +89,11 @@ public:
 
 	int connect_and_run (BufferSet& bufs,
 			framepos_t start, framepos_t end, double speed,
-			ChanMapping in, ChanMapping out,
+			ChanMapping const& in, ChanMapping const& out,
 			pframes_t nframes, framecnt_t offset);
 
+	bool parameter_events_supported (Evoral::Parameter const&) const;
+
 	std::string describe_parameter (Evoral::Parameter);
 	void        print_parameter (uint32_t, char*, uint32_t len) const;
 	boost::shared_ptr<ScalePoints> get_scale_points(uint32_t port_index) const;
@@ -148,6 +150,7 @@ private:
 #endif
 	LuaState lua;
 	luabridge::LuaRef * _lua_dsp;
+	luabridge::LuaRef * _lua_ctrl_events;
 	std::string _script;
 	std::string _origin;
 	std::string _docs;
@@ -110,10 +110,11 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 
 	int set_block_size (pframes_t);
 	bool requires_fixed_sized_buffers () const;
+	bool parameter_events_supported (Evoral::Parameter const&) const;
 
 	int connect_and_run (BufferSet& bufs,
 	                     framepos_t start, framepos_t end, double speed,
-	                     ChanMapping in, ChanMapping out,
+	                     ChanMapping const& in, ChanMapping const& out,
 	                     pframes_t nframes, framecnt_t offset);
 
 	std::string describe_parameter (Evoral::Parameter);
@@ -317,6 +318,7 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	void init (const void* c_plugin, framecnt_t rate);
 	void allocate_atom_event_buffers ();
 	void run (pframes_t nsamples, bool sync_work = false);
+	bool write_parameter_event (LV2_Evbuf*, ParameterEvent const&);
 
 	void load_supported_properties(PropertyDescriptors& descs);
 
@@ -103,6 +103,7 @@ private:
 	std::vector<Iec1ppmdsp *> _iec1meter;
 	std::vector<Iec2ppmdsp *> _iec2meter;
 	std::vector<Vumeterdsp *> _vumeter;
+	std::vector<Sample const *> _audio_data; // per run(), for the meter DSPs
 
 	MeterType _meter_type;
 };
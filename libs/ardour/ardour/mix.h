@@ -45,6 +45,30 @@ extern "C" {
 LIBARDOUR_API void  x86_sse_find_peaks                 (const float * buf, uint32_t nsamples, float *min, float *max);
 LIBARDOUR_API void  x86_sse_avx_find_peaks             (const float * buf, uint32_t nsamples, float *min, float *max);
 
+LIBARDOUR_API void  x86_sse_apply_gain_curve_to_buffer     (float * buf, uint32_t nframes, const float * gain);
+LIBARDOUR_API void  x86_sse_mix_buffers_with_gain_curve    (float * dst, const float * src, uint32_t nframes, const float * gain);
+LIBARDOUR_API void  x86_sse_avx_apply_gain_curve_to_buffer (float * buf, uint32_t nframes, const float * gain);
+LIBARDOUR_API void  x86_sse_avx_mix_buffers_with_gain_curve(float * dst, const float * src, uint32_t nframes, const float * gain);
+
+/* meter ballistics, 4 (SSE) or 8 (AVX) channels at once */
+
+LIBARDOUR_API void  x86_sse_kmeter_process      (const float * const * bufs, uint32_t nframes, float * z1, float * z2, float omega);
+LIBARDOUR_API void  x86_sse_ppm_process         (const float * const * bufs, uint32_t nframes, float * z1, float * z2, float * m, float w1, float w2, float w3);
+LIBARDOUR_API void  x86_sse_vumeter_process     (const float * const * bufs, uint32_t nframes, float * z1, float * z2, float * m, float w);
+LIBARDOUR_API void  x86_sse_avx_kmeter_process  (const float * const * bufs, uint32_t nframes, float * z1, float * z2, float omega);
+LIBARDOUR_API void  x86_sse_avx_ppm_process     (const float * const * bufs, uint32_t nframes, float * z1, float * z2, float * m, float w1, float w2, float w3);
+LIBARDOUR_API void  x86_sse_avx_vumeter_process (const float * const * bufs, uint32_t nframes, float * z1, float * z2, float * m, float w);
+
+/* AVX-512F functions */
+
+LIBARDOUR_API float x86_avx512f_compute_peak               (const float * buf, uint32_t nsamples, float current);
+LIBARDOUR_API void  x86_avx512f_find_peaks                 (const float * buf, uint32_t nsamples, float *min, float *max);
+LIBARDOUR_API void  x86_avx512f_apply_gain_to_buffer       (float * buf, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain      (float * dst, const float * src, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain        (float * dst, const float * src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_apply_gain_curve_to_buffer (float * buf, uint32_t nframes, const float * gain);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain_curve(float * dst, const float * src, uint32_t nframes, const float * gain);
+
 /* debug wrappers for SSE functions */
 
 LIBARDOUR_API float debug_compute_peak               (const ARDOUR::Sample * buf, ARDOUR::pframes_t nsamples, float current);
@@ -62,6 +86,8 @@ LIBARDOUR_API void veclib_find_peaks                 (const ARDOUR::Sample * buf
 LIBARDOUR_API void  veclib_apply_gain_to_buffer      (ARDOUR::Sample * buf, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  veclib_mix_buffers_with_gain     (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  veclib_mix_buffers_no_gain       (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  veclib_apply_gain_curve_to_buffer  (ARDOUR::Sample * buf, ARDOUR::pframes_t nframes, const ARDOUR::gain_t * gain);
+LIBARDOUR_API void  veclib_mix_buffers_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes, const ARDOUR::gain_t * gain);
 
 #endif
 
@@ -73,5 +99,13 @@ LIBARDOUR_API void  default_apply_gain_to_buffer      (ARDOUR::Sample * buf, ARD
 LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector				  (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_apply_gain_curve_to_buffer  (ARDOUR::Sample * buf, ARDOUR::pframes_t nframes, const ARDOUR::gain_t * gain);
+LIBARDOUR_API void  default_mix_buffers_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes, const ARDOUR::gain_t * gain);
+
+/* meter ballistics, 4 channels at once */
+
+LIBARDOUR_API void  default_kmeter_process  (const ARDOUR::Sample * const * bufs, ARDOUR::pframes_t nframes, float * z1, float * z2, float omega);
+LIBARDOUR_API void  default_ppm_process     (const ARDOUR::Sample * const * bufs, ARDOUR::pframes_t nframes, float * z1, float * z2, float * m, float w1, float w2, float w3);
+LIBARDOUR_API void  default_vumeter_process (const ARDOUR::Sample * const * bufs, ARDOUR::pframes_t nframes, float * z1, float * z2, float * m, float w);
 
 #endif /* __ardour_mix_h__ */
@@ -42,6 +42,7 @@
 
 #include "ardour/ardour.h"
 #include "ardour/region.h"
+#include "ardour/region_index.h"
 #include "ardour/session_object.h"
 #include "ardour/data_type.h"
 
@@ -282,6 +283,7 @@ public:
 
 	RegionListProperty   regions;  /* the current list of regions in the playlist */
 	std::set<boost::shared_ptr<Region> > all_regions; /* all regions ever added to this playlist */
+	RegionIndex          region_index; /* the current regions, by position and length */
 	PBD::ScopedConnectionList region_state_changed_connections;
 	PBD::ScopedConnectionList region_drop_references_connections;
 	DataType        _type;
@@ -335,6 +337,7 @@ public:
 	void _set_sort_id ();
 
 	boost::shared_ptr<RegionList> regions_touched_locked (framepos_t start, framepos_t end);
+	void regions_touched_locked (framepos_t start, framepos_t end, std::vector<boost::shared_ptr<Region> >&);
 
 	void notify_region_removed (boost::shared_ptr<Region>);
 	void notify_region_added (boost::shared_ptr<Region>);
@@ -348,6 +351,7 @@ public:
 	void mark_session_dirty();
 
 	void region_changed_proxy (const PBD::PropertyChange&, boost::weak_ptr<Region>);
+	void region_extent_changed (boost::weak_ptr<Region>);
 	virtual bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
 	void region_bounds_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
@@ -111,9 +111,14 @@ class LIBARDOUR_API Plugin : public PBD::StatefulDestructible, public Latent
 	virtual bool requires_fixed_sized_buffers() const { return false; }
 	virtual bool inplace_broken() const { return false; }
 
+	/** @return true if the plugin can apply changes of the given parameter
+	 *  at any frame within a cycle, when given them as parameter events.
+	 */
+	virtual bool parameter_events_supported (Evoral::Parameter const&) const { return false; }
+
 	virtual int connect_and_run (BufferSet& bufs,
 			framepos_t start, framepos_t end, double speed,
-			ChanMapping in, ChanMapping out,
+			ChanMapping const& in, ChanMapping const& out,
 			pframes_t nframes, framecnt_t offset);
 
 	virtual std::set<Evoral::Parameter> automatable() const = 0;
@@ -341,6 +346,23 @@ protected:
 	 */
 	virtual void set_parameter (uint32_t which, float val);
 
+	/** A timestamped parameter change, see parameter_events_supported() */
+	struct ParameterEvent {
+		ParameterEvent (Evoral::Parameter const& p, float v, pframes_t w)
+			: param (p), value (v), when (w) {}
+		bool operator< (ParameterEvent const& other) const { return when < other.when; }
+		Evoral::Parameter param;
+		float value;
+		pframes_t when; ///< frame offset into the next connect_and_run() cycle
+	};
+	typedef std::vector<ParameterEvent> ParameterEvents;
+
+	/** Queue a parameter change for the next connect_and_run().
+	 *  @return false if the queue is full.
+	 */
+	bool queue_parameter_event (Evoral::Parameter const&, float val, pframes_t when);
+	void clear_parameter_events () { _parameter_events.clear (); }
+
 	/** Do the actual saving of the current plugin settings to a preset of the provided name.
 	 *  Should return a URI on success, or an empty string on failure.
 	 */
@@ -356,6 +378,11 @@ protected:
 
 	SessionObject*           _owner;
 
+	/** queued parameter events, in time order. Derived types that support
+	 *  them apply and clear them in connect_and_run().
+	 */
+	ParameterEvents          _parameter_events;
+
 private:
 
 	/** Fill _presets with our presets */
@@ -25,6 +25,8 @@
 
 #include <boost/weak_ptr.hpp>
 
+#include "pbd/rcu.h"
+
 #include "ardour/ardour.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/chan_mapping.h"
@@ -338,7 +340,6 @@ class LIBARDOUR_API PluginInsert : public Processor
 	bool _strict_io;
 	bool _custom_cfg;
 	bool _maps_from_state;
-	bool _mapping_changed;
 
 	Match private_can_support_io_configuration (ChanCount const &, ChanCount &) const;
 	Match internal_can_support_io_configuration (ChanCount const &, ChanCount &) const;
@@ -352,10 +353,76 @@ class LIBARDOUR_API PluginInsert : public Processor
 	PinMappings _out_map;
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
+	/** The pin mappings compiled into what the process thread needs:
+	 *  the maps handed to each plugin instance, and flat per-type tables
+	 *  saying where each buffer comes from, so that processing neither
+	 *  copies nor searches any maps.
+	 *
+	 *  Processing buffers past the end of an output table are unconnected
+	 *  (silenced), bypass leaves buffers past the configured outputs alone.
+	 */
+	struct PinRouting {
+		/** what happens to an output buffer; values >= 0 are the index of
+		 *  the (input) buffer that it is copied from.
+		 */
+		enum Source {
+			Silence = -1,   ///< nothing feeds it
+			Plugin = -2,    ///< a plugin output
+			Untouched = -3  ///< MIDI bypass
+		};
+
+		struct Instance {
+			ChanMapping in_map;
+			ChanMapping out_map;
+			/** out_map, with the outputs after the inputs in the no-inplace buffers */
+			ChanMapping noinplace_out_map;
+			/** no-inplace: the buffer to copy to each input pin, or Silence */
+			std::vector<int32_t> noinplace_in[DataType::num_types];
+		};
+
+		PinRouting () : no_inplace (false) {}
+
+		bool no_inplace;
+		ChanCount natural_in;
+		std::vector<Instance> instances;
+
+		/** identity maps of the plugin's inputs and outputs */
+		ChanMapping natural_in_map;
+		ChanMapping natural_out_map;
+#ifdef MIXBUS
+		ChanMapping mb_in_map;
+		ChanMapping mb_out_map;
+#endif
+
+		/** in-place Split: the input pins that get a copy of the first buffer */
+		std::vector<uint32_t> split_copies[DataType::num_types];
+		/** no-inplace: the Source of each output */
+		std::vector<int32_t> noinplace_out[DataType::num_types];
+		/** in-place: the Source of each output, only Silence is acted upon */
+		std::vector<int32_t> inplace_out[DataType::num_types];
+
+		/** bypass, in-place Split: as split_copies, for the inputs without side-chain */
+		std::vector<uint32_t> bypass_split_copies[DataType::num_types];
+		/** bypass: the Source of each configured output (Plugin is never used).
+		 *  no-inplace sources are read from a copy of the inputs.
+		 */
+		std::vector<int32_t> bypass_out[DataType::num_types];
+	};
+
+	SerializedRCUManager<PinRouting> _routing;
+	void update_routing ();
+
 	void automation_run (BufferSet& bufs, framepos_t start, framepos_t end, double speed, pframes_t nframes);
+	bool queue_automation_events (framepos_t start, framepos_t end, pframes_t nframes);
+	void set_automation_event_values ();
+	/** For each of controls(), in order: whether queue_automation_events()
+	 *  queued a value for it in this cycle, and the last one it queued.
+	 *  Sized when the controls are created, so it is not resized when running.
+	 */
+	std::vector<std::pair<bool, float> > _automation_event_values;
 	void connect_and_run (BufferSet& bufs, framepos_t start, framecnt_t end, double speed, pframes_t nframes, framecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
-	void inplace_silence_unconnected (BufferSet&, const PinMappings&, framecnt_t nframes, framecnt_t offset) const;
+	void inplace_silence_unconnected (BufferSet&, PinRouting const &, framecnt_t nframes, framecnt_t offset) const;
 
 	void create_automatable_parameters ();
 	void control_list_automation_state_changed (Evoral::Parameter, AutoState);
@@ -40,6 +40,7 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class AudioPort;
 class Session;
 
 class LIBARDOUR_API PortManager
@@ -177,9 +178,24 @@ class LIBARDOUR_API PortManager
 	boost::shared_ptr<Port> register_port (DataType type, const std::string& portname, bool input, bool async = false, PortFlags extra_flags = PortFlags (0));
 	void port_registration_failure (const std::string& portname);
 
-	/** List of ports to be used between ::cycle_start() and ::cycle_end()
+	/** The ports as flat arrays for the passes over all of them in each
+	 *  cycle, rebuilt whenever a port is registered or unregistered.
 	 */
-	boost::shared_ptr<Ports> _cycle_ports;
+	struct PortTable {
+		PortTable () : n_audio (0) {}
+		boost::shared_ptr<Ports> ports;   ///< the map this table was built from, keeps the ports alive
+		std::vector<Port*>       all;     ///< all ports, the first n_audio are audio ports
+		size_t                   n_audio;
+		std::vector<AudioPort*>  audio_outputs;
+		std::vector<Port*>       midi_outputs; ///< excluding asynchronous MIDI ports
+	};
+
+	SerializedRCUManager<PortTable> _port_table;
+	void update_port_table ();
+
+	/** Table of ports to be used between ::cycle_start() and ::cycle_end()
+	 */
+	boost::shared_ptr<PortTable> _cycle_port_table;
 
 	void fade_out (gain_t, gain_t, pframes_t);
 	void silence (pframes_t nframes, Session *s = 0);
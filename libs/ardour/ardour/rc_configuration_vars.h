@@ -96,6 +96,7 @@ CONFIG_VARIABLE (BufferingPreset, buffering_preset, "buffering-preset", Medium)
 CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
+CONFIG_VARIABLE (uint32_t, disk_io_threads, "disk-io-threads", 1)
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
@@ -212,6 +213,7 @@ CONFIG_VARIABLE (bool, verify_remove_last_capture, "verify-remove-last-capture",
 CONFIG_VARIABLE (bool, save_history, "save-history", true)
 CONFIG_VARIABLE (int32_t, saved_history_depth, "save-history-depth", 20)
 CONFIG_VARIABLE (int32_t, history_depth, "history-depth", 20)
+CONFIG_VARIABLE (uint32_t, history_memory_limit, "history-memory-limit", 256) /* MB, older transactions are spilled to disk */
 CONFIG_VARIABLE (bool, use_overlap_equivalency, "use-overlap-equivalency", false)
 CONFIG_VARIABLE (bool, periodic_safety_backups, "periodic-safety-backups", true)
 CONFIG_VARIABLE (uint32_t, periodic_safety_backup_interval, "periodic-safety-backup-interval", 120)
@@ -225,6 +227,9 @@ CONFIG_VARIABLE_SPECIAL (std::string, default_session_parent_dir, "default-sessi
 #endif
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, use_work_stealing_scheduler, "use-work-stealing-scheduler", false)
+CONFIG_VARIABLE (bool, graph_critical_path_scheduling, "graph-critical-path-scheduling", false)
+CONFIG_VARIABLE (bool, graph_split_sends, "graph-split-sends", false)
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
 CONFIG_VARIABLE (uint32_t, max_recent_templates, "max-recent-templates", 10)
@@ -245,6 +250,9 @@ CONFIG_VARIABLE (bool, verbose_plugin_scan, "verbose-plugin-scan", false)
 CONFIG_VARIABLE (int, vst_scan_timeout, "vst-scan-timeout", 1200) /* deciseconds, per plugin, <= 0 no timeout */
 CONFIG_VARIABLE (bool, discover_audio_units, "discover-audio-units", false)
 CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
+CONFIG_VARIABLE (bool, plugin_automation_events, "plugin-automation-events", false)
+CONFIG_VARIABLE (uint32_t, plugin_automation_min_block, "plugin-automation-min-block", 32) /* samples, with plugin-automation-events */
+CONFIG_VARIABLE (uint32_t, plugin_worker_threads, "plugin-worker-threads", 2)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
 
 /* custom user plugin paths */
@@ -282,3 +290,4 @@ CONFIG_VARIABLE (bool, show_video_server_dialog, "show-video-server-dialog", fal
 
 CONFIG_VARIABLE (float, export_preroll, "export-preroll", 10.0) // seconds
 CONFIG_VARIABLE (float, export_silence_threshold, "export-silence-threshold", -INFINITY) // dB
+CONFIG_VARIABLE (bool, export_timespans_in_one_pass, "export-timespans-in-one-pass", false) // timespans less than export-preroll apart
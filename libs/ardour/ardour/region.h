@@ -94,6 +94,12 @@ class LIBARDOUR_API Region
 
 	static PBD::Signal2<void,boost::shared_ptr<ARDOUR::Region>, const PBD::PropertyChange&> RegionPropertyChanged;
 
+	/** Emitted when the position or length of this region changes, even
+	 *  while its property changes are suspended (PropertyChanged is only
+	 *  sent once they are resumed).
+	 */
+	PBD::Signal0<void> ExtentChanged;
+
 	virtual ~Region();
 
 	/** Note: changing the name of a Region does not constitute an edit */
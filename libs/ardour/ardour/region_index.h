@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef __ardour_region_index_h__
+#define __ardour_region_index_h__
+
+#include <map>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class Region;
+
+/** An interval tree of the regions on a playlist, keyed by their extent
+ *  on the timeline, so that the regions touching a given range can be
+ *  found in O(log n + k) rather than by scanning the whole region list.
+ *
+ *  It is a treap ordered by region position, with every node holding the
+ *  largest last frame in its subtree. The extent of each region is noted
+ *  when it is indexed; the playlist must call update() whenever a region's
+ *  position or length changes.
+ *
+ *  The index has its own lock, so that it can be updated from region
+ *  change signals whether or not the playlist's region lock is held.
+ */
+class LIBARDOUR_API RegionIndex
+{
+  public:
+	RegionIndex ();
+	~RegionIndex ();
+
+	void add (boost::shared_ptr<Region>);
+	void remove (boost::shared_ptr<Region>);
+	void update (boost::shared_ptr<Region>);
+	void clear ();
+
+	size_t size () const;
+
+	/** Append the regions that touch the range [@param start, @param end]
+	 *  (inclusive) to @param result, in order of ascending position.
+	 */
+	void find (framepos_t start, framepos_t end, std::vector<boost::shared_ptr<Region> >& result) const;
+
+  private:
+	RegionIndex (RegionIndex const &);
+	RegionIndex& operator= (RegionIndex const &);
+
+	struct Node {
+		Node (boost::shared_ptr<Region>, uint32_t priority);
+
+		bool before (Node const * other) const {
+			return first < other->first || (first == other->first && region.get() < other->region.get());
+		}
+
+		void fix ();
+
+		boost::shared_ptr<Region> region;
+		framepos_t first;   ///< region's first frame when indexed
+		framepos_t last;    ///< region's last frame when indexed
+		framepos_t max_last; ///< largest last frame in this subtree
+		uint32_t priority;
+		Node* left;
+		Node* right;
+	};
+
+	typedef std::map<Region const *, Node*> NodeMap;
+
+	void add_locked (boost::shared_ptr<Region>);
+	void remove_locked (Region const *);
+	uint32_t next_priority ();
+
+	static void split (Node* t, Node const * key, Node*& l, Node*& r);
+	static Node* merge (Node* l, Node* r);
+	static Node* erase (Node* t, Node const * key);
+	static void find (Node const * t, framepos_t start, framepos_t end, std::vector<boost::shared_ptr<Region> >& result);
+	static void destroy (Node*);
+
+	mutable Glib::Threads::RWLock _lock;
+	Node*    _root;
+	NodeMap  _nodes;
+	uint32_t _seed;
+};
+
+} /* namespace */
+
+#endif /* __ardour_region_index_h__ */
@@ -23,9 +23,18 @@
 
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <glibmm/threads.h>
 
 namespace ARDOUR {
 
+class IO;
+class Processor;
+
 typedef boost::shared_ptr<Route> GraphVertex;
 
 /** A list of edges for a directed graph for routes.
@@ -70,6 +79,61 @@ private:
 	EdgeMapWithSends _from_to_with_sends;
 };
 
+/** A record of which routes each route directly feeds, either by port
+ *  connections or by internal sends, as Route::direct_feeds_according_to_reality()
+ *  would find them.
+ *
+ *  Finding the edges of the route graph from scratch means asking the
+ *  backend about every pair of routes. Instead, each route's feeds are
+ *  kept here and only recomputed for routes that have been invalidated:
+ *  those whose ports were connected or disconnected, those whose
+ *  processors changed, and those that are new. A route's feeds are found
+ *  from the connections of its own outputs, so the cost of an update is
+ *  proportional to the number of ports involved rather than to the square
+ *  of the number of routes.
+ *
+ *  The invalidate methods may be called from any thread; update() and
+ *  feeds() must only be called by one thread at a time (the session calls
+ *  them with its route list's RCU writer held).
+ */
+class LIBARDOUR_API RouteFeeds
+{
+public:
+	/** routes fed, with a flag which is true if the feed is via sends only,
+	 *  in order of route.
+	 */
+	typedef std::vector<std::pair<GraphVertex, bool> > Feeds;
+
+	RouteFeeds ();
+
+	void invalidate (GraphVertex);
+	void invalidate_port (std::string const &);
+	void invalidate_all ();
+
+	bool update (boost::shared_ptr<RouteList>);
+	Feeds const & feeds (GraphVertex) const;
+	void clear ();
+
+private:
+	typedef std::map<GraphVertex, Feeds> FeedMap;
+	typedef std::map<std::string, GraphVertex> PortOwners;
+
+	void add_ports (boost::shared_ptr<const IO>, GraphVertex);
+	void connected_routes (boost::shared_ptr<const IO>, std::set<GraphVertex>&) const;
+	void add_processor_feeds (boost::weak_ptr<Processor>, GraphVertex, boost::shared_ptr<RouteList>, std::set<GraphVertex>*) const;
+	void find_feeds (GraphVertex, boost::shared_ptr<RouteList>, Feeds&) const;
+
+	FeedMap _feeds;
+	/** map of the (relative) names of all the routes' ports to their routes */
+	PortOwners _port_owners;
+
+	Glib::Threads::Mutex _lock;
+	/* these are protected by _lock */
+	std::set<GraphVertex> _dirty_routes;
+	std::set<std::string> _dirty_ports;
+	bool _all_dirty;
+};
+
 boost::shared_ptr<RouteList> topological_sort (
 	boost::shared_ptr<RouteList>,
 	GraphEdges
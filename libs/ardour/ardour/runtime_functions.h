@@ -31,6 +31,12 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t)	(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)		(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)			    (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*apply_gain_curve_to_buffer_t)  (ARDOUR::Sample *, pframes_t, const ARDOUR::gain_t *);
+	typedef void  (*mix_buffers_with_gain_curve_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, const ARDOUR::gain_t *);
+
+	typedef void  (*kmeter_process_t)  (const ARDOUR::Sample * const *, pframes_t, float *, float *, float);
+	typedef void  (*ppm_process_t)     (const ARDOUR::Sample * const *, pframes_t, float *, float *, float *, float, float, float);
+	typedef void  (*vumeter_process_t) (const ARDOUR::Sample * const *, pframes_t, float *, float *, float *, float);
 
 	LIBARDOUR_API extern compute_peak_t		compute_peak;
 	LIBARDOUR_API extern find_peaks_t               find_peaks;
@@ -38,6 +44,33 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t	mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t	mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t			copy_vector;
+
+	/** Multiply each sample of a buffer by the corresponding gain of a
+	 *  gain curve (such as automation data or a declick ramp).
+	 */
+	LIBARDOUR_API extern apply_gain_curve_to_buffer_t  apply_gain_curve_to_buffer;
+
+	/** Mix a buffer into another, scaling each sample by the corresponding
+	 *  gain of a gain curve.
+	 */
+	LIBARDOUR_API extern mix_buffers_with_gain_curve_t mix_buffers_with_gain_curve;
+
+	/** The number of channels (at most max_meter_lanes) that the meter
+	 *  ballistics routines below process at once. The state of channel i
+	 *  is element i of each state array, and the routines give the same
+	 *  results as the per-channel process() of the meter DSP classes.
+	 */
+	LIBARDOUR_API extern uint32_t meter_lanes;
+	static const uint32_t max_meter_lanes = 8;
+
+	/** Kmeterdsp filters, with state z1, z2 and filter coefficient omega */
+	LIBARDOUR_API extern kmeter_process_t  kmeter_process;
+
+	/** Iec1ppmdsp and Iec2ppmdsp filters, with state z1, z2, maximum m and coefficients w1, w2, w3 */
+	LIBARDOUR_API extern ppm_process_t     ppm_process;
+
+	/** Vumeterdsp filters, with state z1, z2, maximum m and coefficient w */
+	LIBARDOUR_API extern vumeter_process_t vumeter_process;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
@@ -1739,7 +1739,8 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	boost::shared_ptr<Route> XMLRouteFactory (const XMLNode&, int);
 	boost::shared_ptr<Route> XMLRouteFactory_2X (const XMLNode&, int);
 
-	void route_processors_changed (RouteProcessorChange);
+	void route_processors_changed (RouteProcessorChange, boost::weak_ptr<Route> = boost::weak_ptr<Route> ());
+	void port_connected_or_disconnected (std::string const &, std::string const &);
 
 	bool find_route_name (std::string const &, uint32_t& id, std::string& name, bool);
 	void count_existing_track_channels (ChanCount& in, ChanCount& out);
@@ -1876,6 +1877,8 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	int load_bundles (XMLNode const &);
 
 	UndoHistory      _history;
+	/** where _history keeps transactions beyond its memory limit */
+	std::string      _history_spill_dir;
 	/** current undo transaction, or 0 */
 	UndoTransaction* _current_trans;
 	/** GQuarks to describe the reversible commands that are currently in progress.
@@ -1968,6 +1971,9 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	XMLNode& get_control_protocol_state ();
 
 	void set_history_depth (uint32_t depth);
+	void set_history_memory_limit (uint32_t megabytes);
+	UndoTransaction* undo_transaction_from_state (XMLNode const &);
+	bool can_restore_undo_transaction (XMLNode const &) const;
 
 	static bool _disable_all_loaded_plugins;
 	static bool _bypass_all_loaded_plugins;
@@ -2045,6 +2051,8 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	    and solo/mute computations.
 	*/
 	GraphEdges _current_route_graph;
+	/** the direct feeds of each route, from which the graph is built */
+	RouteFeeds _route_feeds;
 
 	void ensure_route_presentation_info_gap (PresentationInfo::order_t, uint32_t gap_size);
 
@@ -70,6 +70,11 @@ class LIBARDOUR_API SourceFactory {
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (boost::shared_ptr<Source>, bool async);
+
+	/** Move @param s to the front of the queue of sources waiting for
+	 *  their peakfile to be built, if it is queued at all.
+	 */
+	static void prioritize_peak_building (boost::shared_ptr<Source> s);
 };
 
 }
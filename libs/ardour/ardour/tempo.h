@@ -26,6 +26,9 @@
 #include <cmath>
 #include <glibmm/threads.h>
 
+#include <boost/shared_ptr.hpp>
+
+#include "pbd/rcu.h"
 #include "pbd/undo.h"
 
 #include "pbd/stateful.h"
@@ -584,6 +587,38 @@ private:
 	framecnt_t                    _frame_rate;
 	mutable Glib::Threads::RWLock lock;
 
+	/** An immutable copy of the active tempo sections and the meter
+	 *  sections of _metrics, in order, with their positions held in
+	 *  arrays of their own so that they can be binary-searched.
+	 *
+	 *  It is republished (RCU) whenever _metrics is recomputed, so the
+	 *  common frame/beat/quarter-note conversions can use it without
+	 *  taking the lock or walking the list.
+	 */
+	struct SectionIndex {
+		std::vector<boost::shared_ptr<const TempoSection> > tempos;
+		std::vector<double>     tempo_minutes;
+		std::vector<double>     tempo_pulses;
+		std::vector<framepos_t> tempo_frames;
+
+		std::vector<boost::shared_ptr<const MeterSection> > meters;
+		std::vector<double>     meter_minutes;
+		std::vector<double>     meter_pulses;
+		std::vector<double>     meter_beats;
+	};
+
+	SerializedRCUManager<SectionIndex> _index;
+
+	void publish_index ();
+
+	double pulse_at_minute_indexed (const SectionIndex&, const double& minute) const;
+	double minute_at_pulse_indexed (const SectionIndex&, const double& pulse) const;
+	double beat_at_minute_indexed (const SectionIndex&, const double& minute) const;
+	double minute_at_beat_indexed (const SectionIndex&, const double& beat) const;
+	double pulse_at_beat_indexed (const SectionIndex&, const double& beat) const;
+	double beat_at_pulse_indexed (const SectionIndex&, const double& pulse) const;
+	double quarter_notes_between_frames_indexed (const SectionIndex&, const framecnt_t start, const framecnt_t end) const;
+
 	void recompute_tempi (Metrics& metrics);
 	void recompute_meters (Metrics& metrics);
 	void recompute_map (Metrics& metrics, framepos_t end = -1);
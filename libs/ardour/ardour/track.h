@@ -158,6 +158,22 @@ class LIBARDOUR_API Track : public Route, public Recordable, public PublicDiskst
 	float capture_buffer_load () const;
 	int do_refill ();
 	int do_flush (RunContext, bool force = false);
+
+	/** Time taken by do_refill(), as measured by whichever butler thread
+	 *  ran it. Also shown by the Butler debug trace, and available to Lua
+	 *  scripts as Track:refill_stats().
+	 */
+	struct RefillStats {
+		RefillStats () : count (0), last (0), max (0), total (0) {}
+		uint64_t       count;
+		microseconds_t last;
+		microseconds_t max;
+		microseconds_t total;
+	};
+
+	RefillStats refill_stats () const;
+	void reset_refill_stats ();
+
 	void set_pending_overwrite (bool);
 	int seek (framepos_t, bool complete_refill = false);
 	bool hidden () const;
@@ -257,6 +273,9 @@ private:
 	void parameter_changed (std::string const & p);
 
 	std::string _diskstream_name;
+	/** written by the butler or one of its workers, read by anyone */
+	RefillStats _refill_stats;
+	mutable Glib::Threads::Mutex _refill_stats_lock;
 };
 
 }; /* namespace ARDOUR*/
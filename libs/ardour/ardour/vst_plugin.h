@@ -73,7 +73,7 @@ public:
 
 	int connect_and_run (BufferSet&,
 			framepos_t start, framepos_t end, double speed,
-			ChanMapping in, ChanMapping out,
+			ChanMapping const& in, ChanMapping const& out,
 			pframes_t nframes, framecnt_t offset
 			);
 
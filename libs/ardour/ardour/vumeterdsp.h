@@ -30,6 +30,8 @@ public:
     ~Vumeterdsp (void);
 
     void process (float const *p, int n);
+    // meters[i] processes p[i], as Kmeterdsp::process (meters, ...).
+    static void process (Vumeterdsp * const *meters, float const * const *p, int n_meters, int n);
     float read (void);
     void reset ();
 
@@ -37,6 +39,9 @@ public:
 
 private:
 
+    float start (void);
+    void store (float z1, float z2, float m);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _m;           // max value since last read()
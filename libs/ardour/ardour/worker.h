@@ -21,11 +21,16 @@
 #define __ardour_worker_h__
 
 #include <stdint.h>
+#include <pthread.h>
 
+#include <vector>
+
+#include <glib.h>
 #include <glibmm/threads.h>
 
 #include "pbd/ringbuffer.h"
 #include "pbd/semutils.h"
+#include "pbd/signals.h"
 
 #include "ardour/libardour_visibility.h"
 
@@ -54,9 +59,9 @@ public:
 /**
    A worker for non-realtime tasks scheduled from another thread.
 
-   A worker may be a separate thread that runs to execute scheduled work
-   asynchronously, or unthreaded, in which case work is executed immediately
-   upon scheduling by the calling thread.
+   A worker may be threaded, in which case scheduled work is executed
+   asynchronously by the threads of the WorkerPool, or unthreaded, in which
+   case work is executed immediately upon scheduling by the calling thread.
 */
 class LIBARDOUR_API Worker
 {
@@ -92,7 +97,17 @@ public:
 	void set_synchronous(bool synchronous) { _synchronous = synchronous; }
 
 private:
-	void run();
+	friend class WorkerPool;
+
+	/**
+	   Execute the next request (pool thread).
+	   @param buf scratch buffer of the calling thread, grown as needed.
+	   @param buf_size size of @param buf.
+	   @param latency set to the time in usecs the request was queued.
+	   @return false if no request could be read.
+	*/
+	bool work_next(void*& buf, size_t& buf_size, int64_t& latency);
+
 	/**
 	   Peek in RB, get size and check if a block of 'size' is available.
 
@@ -100,18 +115,87 @@ private:
 	   responder writing 'size' and 'data'.
 
 	   @param rb the ringbuffer to check
+	   @param header size of the message header following 'size'
 	   @return true if the message is complete, false otherwise
 	*/
-	bool verify_message_completeness(RingBuffer<uint8_t>* rb);
+	bool verify_message_completeness(RingBuffer<uint8_t>* rb, uint32_t header = 0);
 
 	Workee*                _workee;
 	RingBuffer<uint8_t>*   _requests;
 	RingBuffer<uint8_t>*   _responses;
 	uint8_t*               _response;
-	PBD::Semaphore         _sem;
-	Glib::Threads::Thread* _thread;
-	bool                   _exit;
 	bool                   _synchronous;
+
+	/* WorkerPool state. _queued is set while there are requests that no
+	 * pool thread has taken on yet, _claimed (protected by the pool's
+	 * lock) while a pool thread executes one of them.
+	 */
+	volatile gint          _queued;
+	bool                   _claimed;
+};
+
+/**
+   The threads that execute the work of all threaded Workers.
+
+   Each Worker is served by at most one thread at a time, so its requests
+   are executed (and its responses queued) in the order they were scheduled.
+   Threads take one request at a time from the Workers with pending work,
+   round-robin, so that a plugin scheduling a lot of work cannot starve the
+   others.
+
+   The number of threads is set by the plugin-worker-threads preference.
+*/
+class LIBARDOUR_API WorkerPool
+{
+public:
+	struct Stats {
+		Stats () : requests (0), queued (0), max_queued (0), avg_latency (0), max_latency (0) {}
+		uint64_t requests;    ///< requests executed
+		uint32_t queued;      ///< workers currently waiting for a thread
+		uint32_t max_queued;  ///< most workers waiting for a thread at once
+		uint64_t avg_latency; ///< usecs between scheduling and execution of a request
+		uint64_t max_latency;
+	};
+
+	static WorkerPool& instance ();
+	static void destroy ();
+
+	uint32_t thread_count () const;
+	void set_thread_count (uint32_t);
+
+	Stats stats () const;
+	void reset_stats ();
+
+private:
+	friend class Worker;
+
+	WorkerPool ();
+	~WorkerPool ();
+
+	void add (Worker*);
+	void remove (Worker*);
+	void queue (Worker*);
+
+	static void* _thread_work (void* arg);
+	void thread_work ();
+	void config_changed (std::string);
+
+	static WorkerPool* _instance;
+
+	mutable Glib::Threads::Mutex _lock;
+	Glib::Threads::Cond          _idle;
+	std::vector<Worker*>         _workers;
+	size_t                       _next;
+
+	std::vector<pthread_t>       _threads;
+	PBD::Semaphore               _sem;
+	bool                         _quit;
+
+	volatile gint                _n_queued;
+	Stats                        _stats;
+	uint64_t                     _total_latency;
+
+	PBD::ScopedConnection        _config_connection;
 };
 
 } // namespace ARDOUR
@@ -151,6 +151,47 @@ AudioDiskstream::free_working_buffers()
 	_gain_buffer          = 0;
 }
 
+namespace {
+struct RefillBuffers {
+	RefillBuffers ()
+		: mixdown (new Sample[2*1048576])
+		, gain (new gain_t[2*1048576])
+	{}
+	~RefillBuffers () {
+		delete [] mixdown;
+		delete [] gain;
+	}
+	Sample* mixdown;
+	gain_t* gain;
+};
+}
+
+/* deleted when the thread exits */
+static Glib::Threads::Private<RefillBuffers> thread_refill_buffers;
+
+/** Give the calling thread its own refill buffers, so that it can
+ *  do_refill() concurrently with the butler thread.
+ */
+void
+AudioDiskstream::allocate_thread_working_buffers()
+{
+	if (!thread_refill_buffers.get ()) {
+		thread_refill_buffers.set (new RefillBuffers);
+	}
+}
+
+int
+AudioDiskstream::do_refill ()
+{
+	RefillBuffers* rb = thread_refill_buffers.get ();
+
+	if (rb) {
+		return _do_refill (rb->mixdown, rb->gain, 0);
+	}
+
+	return _do_refill (_mixdown_buffer, _gain_buffer, 0);
+}
+
 void
 AudioDiskstream::non_realtime_input_change ()
 {
@@ -140,7 +140,7 @@ AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, fram
 
 /** Sort by descending layer and then by ascending position */
 struct ReadSorter {
-    bool operator() (boost::shared_ptr<Region> a, boost::shared_ptr<Region> b) {
+    bool operator() (boost::shared_ptr<Region> const & a, boost::shared_ptr<Region> const & b) const {
 	    if (a->layer() != b->layer()) {
 		    return a->layer() > b->layer();
 	    }
@@ -157,6 +157,11 @@ struct Segment {
 	Evoral::Range<framepos_t> range;       ///< range of the region to read, in session frames
 };
 
+/** Per-thread list of the regions touched by a read, kept between reads
+ *  so that finding them does not allocate.
+ */
+static Glib::Threads::Private<vector<boost::shared_ptr<Region> > > thread_read_regions;
+
 /** @param start Start position in session frames.
  *  @param cnt Number of frames to read.
  */
@@ -191,8 +196,15 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 	/* Find all the regions that are involved in the bit we are reading,
 	   and sort them by descending layer and ascending position.
 	*/
-	boost::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt - 1);
-	all->sort (ReadSorter ());
+	vector<boost::shared_ptr<Region> >* all = thread_read_regions.get ();
+	if (!all) {
+		all = new vector<boost::shared_ptr<Region> >;
+		thread_read_regions.set (all);
+	}
+
+	all->clear ();
+	regions_touched_locked (start, start + cnt - 1, *all);
+	sort (all->begin(), all->end(), ReadSorter ());
 
 	/* This will be a list of the bits of our read range that we have
 	   handled completely (ie for which no more regions need to be read).
@@ -204,7 +216,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 	list<Segment> to_do;
 
 	/* Now go through the `all' list filling in `to_do' and `done' */
-	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
+	for (vector<boost::shared_ptr<Region> >::iterator i = all->begin(); i != all->end(); ++i) {
 		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
 
 		/* muted regions don't figure into it at all */
@@ -253,6 +265,9 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 		i->region->read_at (buf + i->range.from - start, mixdown_buffer, gain_buffer, i->range.from, i->range.to - i->range.from + 1, chan_n);
 	}
 
+	/* don't hold on to the regions until the next read */
+	all->clear ();
+
 	return cnt;
 }
 
@@ -298,6 +313,7 @@ AudioPlaylist::destroy_region (boost::shared_ptr<Region> region)
 
 			if ((*i) == region) {
 				regions.erase (i);
+				region_index.remove (region);
 				changed = true;
 			}
 
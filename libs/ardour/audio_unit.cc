@@ -1630,7 +1630,7 @@ AUPlugin::render_callback(AudioUnitRenderActionFlags*,
 int
 AUPlugin::connect_and_run (BufferSet& bufs,
 		framepos_t start, framepos_t end, double speed,
-		ChanMapping in_map, ChanMapping out_map,
+		ChanMapping const& in_map, ChanMapping const& out_map,
 		pframes_t nframes, framecnt_t offset)
 {
 	Plugin::connect_and_run(bufs, start, end, speed, in_map, out_map, nframes, offset);
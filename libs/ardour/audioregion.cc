@@ -643,9 +643,7 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 		}
 
 		/* Mix our newly-read data in, with the fade */
-		for (framecnt_t n = 0; n < fade_in_limit; ++n) {
-			buf[n] += mixdown_buffer[n] * gain_buffer[n];
-		}
+		mix_buffers_with_gain_curve (buf, mixdown_buffer, fade_in_limit, gain_buffer);
 	}
 
 	if (fade_out_limit != 0) {
@@ -686,9 +684,7 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 		/* Mix our newly-read data with whatever was already there,
 		   with the fade out applied to our data.
 		*/
-		for (framecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-			buf[m] += mixdown_buffer[m] * gain_buffer[n];
-		}
+		mix_buffers_with_gain_curve (buf + fade_out_offset, mixdown_buffer + fade_out_offset, fade_out_limit, gain_buffer);
 	}
 
 	/* MIX OR COPY THE REGION BODY FROM mixdown_buffer INTO buf */
@@ -76,6 +76,28 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+/* Peakfiles hold the peaks at _FPP frames-per-peak, followed by up to
+   MAX_PEAK_LEVELS-1 coarser levels, each decimated by PEAK_LEVEL_RATIO
+   from the one before (256, 4096 and 65536 fpp), and end with a
+   PeakFileTrailer describing the levels. The _FPP level always starts at
+   the beginning of the file, so a file without a trailer (written by
+   older versions) is simply a peakfile with just that one level.
+*/
+#define PEAK_LEVEL_RATIO 16
+#define MAX_PEAK_LEVELS 3
+
+struct PeakFileTrailer {
+	uint64_t offset[MAX_PEAK_LEVELS]; ///< in bytes from the start of the file
+	uint64_t npeaks[MAX_PEAK_LEVELS];
+	uint32_t fpp[MAX_PEAK_LEVELS];
+	uint32_t n_levels;
+	uint32_t version;
+	char     magic[4];
+};
+
+static const char     peakfile_magic[4] = { 'A', 'P', 'K', 'L' };
+static const uint32_t peakfile_version = 2;
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _length (0)
@@ -286,8 +308,8 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 				*/
 				DEBUG_TRACE(DEBUG::Peaks, string_compose("Error when calling stat on Peakfile %1\n", _peakpath));
 
-				_peaks_built = true;
-				_peak_byte_max = statbuf.st_size;
+				_peak_byte_max = load_peak_levels (statbuf.st_size);
+				_peaks_built = (_peak_byte_max >= 0);
 
 			} else {
 
@@ -299,14 +321,24 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 					_peaks_built = false;
 					_peak_byte_max = 0;
 				} else {
-					_peaks_built = true;
-					_peak_byte_max = statbuf.st_size;
+					_peak_byte_max = load_peak_levels (statbuf.st_size);
+					_peaks_built = (_peak_byte_max >= 0);
 				}
 			}
 		}
 	}
 
-	if (!empty() && !_peaks_built && _build_missing_peakfiles && _build_peakfiles) {
+	if (_peak_byte_max < 0) {
+		_peak_byte_max = 0;
+	}
+
+	if (_peaks_built) {
+		/* anyone who asked for peaks before the (possibly
+		   asynchronous) peakfile setup got here is waiting for this.
+		*/
+		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+		PeaksReady (); /* EMIT SIGNAL */
+	} else if (!empty() && _build_missing_peakfiles && _build_peakfiles) {
 		build_peaks_from_scratch ();
 	}
 
@@ -334,7 +366,48 @@ AudioSource::write (Sample *dst, framecnt_t cnt)
 int
 AudioSource::read_peaks (PeakData *peaks, framecnt_t npeaks, framepos_t start, framecnt_t cnt, double samples_per_visual_peak) const
 {
-	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, peak_level_fpp (samples_per_visual_peak));
+}
+
+/** @return the frames-per-peak of the coarsest level in our peakfile
+ *  that still has at least one peak per visual peak.
+ */
+framecnt_t
+AudioSource::peak_level_fpp (double samples_per_visual_peak) const
+{
+	Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+	framecnt_t fpp = _FPP;
+
+	for (vector<PeakLevel>::const_iterator l = _peak_levels.begin(); l != _peak_levels.end(); ++l) {
+		if (l->fpp <= samples_per_visual_peak) {
+			fpp = max (fpp, l->fpp);
+		}
+	}
+
+	return fpp;
+}
+
+/** Find the byte offset of the level holding peaks at @param fpp frames-per-peak.
+ *  @return false if there is no such level.
+ */
+bool
+AudioSource::peak_level_offset (framecnt_t fpp, off_t& offset) const
+{
+	if (fpp == _FPP) {
+		offset = 0;
+		return true;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+
+	for (vector<PeakLevel>::const_iterator l = _peak_levels.begin(); l != _peak_levels.end(); ++l) {
+		if (l->fpp == fpp) {
+			offset = l->offset;
+			return true;
+		}
+	}
+
+	return false;
 }
 
 /** @param peaks Buffer to write peak data.
@@ -360,9 +433,18 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 #endif
 	framecnt_t read_npeaks = npeaks;
 	framecnt_t zero_fill = 0;
+	off_t level_offset;
 
 	GStatBuf statbuf;
 
+	if (!peak_level_offset (samples_per_file_peak, level_offset)) {
+		/* the level went away since the caller chose it (the peakfile is
+		   being rebuilt), use the finest one, which is always present.
+		*/
+		samples_per_file_peak = _FPP;
+		level_offset = 0;
+	}
+
 	expected_peaks = (cnt / (double) samples_per_file_peak);
 	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
 		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
@@ -383,13 +465,17 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 		 *
 		 */
 
-		const off_t expected_file_size = (_length / (double) samples_per_file_peak) * sizeof (PeakData);
+		const off_t expected_file_size = (_length / (double) _FPP) * sizeof (PeakData);
 
 		if (statbuf.st_size < expected_file_size) {
 			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), _peakpath, expected_file_size, statbuf.st_size) << endmsg;
 			lm.release(); // build_peaks_from_scratch() takes _lock
 			const_cast<AudioSource*>(this)->build_peaks_from_scratch ();
 			lm.acquire ();
+			/* the peakfile's levels have been rewritten, stick to the finest one */
+			samples_per_file_peak = _FPP;
+			level_offset = 0;
+			expected_peaks = (cnt / (double) samples_per_file_peak);
 			if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
 				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), _peakpath, strerror (errno)) << endmsg;
 			}
@@ -450,7 +536,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 	}
 
 	if (scale == 1.0) {
-		off_t first_peak_byte = (start / samples_per_file_peak) * sizeof (PeakData);
+		off_t first_peak_byte = level_offset + (start / samples_per_file_peak) * sizeof (PeakData);
 		size_t bytes_to_read = sizeof (PeakData) * read_npeaks;
 		/* open, read, close */
 
@@ -548,7 +634,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 
 		/* open ... close during out: handling */
 
-		off_t  map_off =  (uint32_t) (ceil (start / (double) samples_per_file_peak)) * sizeof(PeakData);
+		off_t  map_off =  level_offset + (uint32_t) (ceil (start / (double) samples_per_file_peak)) * sizeof(PeakData);
 		off_t  read_map_off = map_off & ~(bufsize - 1);
 		off_t  map_delta = map_off - read_map_off;
 		size_t raw_map_length = chunksize * sizeof(PeakData);
@@ -731,6 +817,9 @@ AudioSource::build_peaks_from_scratch ()
 
 		Glib::Threads::Mutex::Lock lp (_lock);
 
+		/* all of the peakfile is rewritten */
+		_peak_byte_max = 0;
+
 		if (prepare_for_peakfile_writes ()) {
 			goto out;
 		}
@@ -817,6 +906,21 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+
+	/* the coarser levels are about to be out of date; drop them and
+	   their table from the file too, so that it can't describe stale
+	   peaks if we are interrupted before done_with_peakfile_writes().
+	*/
+	if (ftruncate (_peakfile_fd, _peak_byte_max)) {
+		error << string_compose (_("could not truncate peakfile %1 to %2 (error: %3)"), _peakpath, _peak_byte_max, errno) << endmsg;
+		close (_peakfile_fd);
+		_peakfile_fd = -1;
+		return -1;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+	_peak_levels.clear ();
+
 	return 0;
 }
 
@@ -836,6 +940,8 @@ AudioSource::done_with_peakfile_writes (bool done)
 	}
 
 	if (done) {
+		write_peak_levels (_peakfile_fd, _peak_byte_max / sizeof (PeakData));
+
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
 		PeaksReady (); /* EMIT SIGNAL */
@@ -981,7 +1087,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, framecnt_t first_frame, frame
 		peakbuf[peaks_computed].max = buf[0];
 		peakbuf[peaks_computed].min = buf[0];
 
-		ARDOUR::find_peaks (buf+1, this_time-1, &peakbuf[peaks_computed].min, &peakbuf[peaks_computed].max);
+		/* start at buf rather than buf+1: it is only a compare more, but
+		   keeps the whole block aligned for the SIMD find_peaks().
+		*/
+		ARDOUR::find_peaks (buf, this_time, &peakbuf[peaks_computed].min, &peakbuf[peaks_computed].max);
 
 		peaks_computed++;
 		buf += this_time;
@@ -1063,6 +1172,191 @@ AudioSource::truncate_peakfile ()
 	}
 }
 
+/** Read the level table from the end of our peakfile, and upgrade
+ *  single-level peakfiles to multi-level ones if we are building peaks.
+ *  @param file_size Size of the peakfile.
+ *  @return size of the finest level of peaks in bytes, or -1 if the
+ *  peakfile is not usable and needs to be rebuilt.
+ */
+off_t
+AudioSource::load_peak_levels (off_t file_size)
+{
+	PeakFileTrailer t;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+		_peak_levels.clear ();
+	}
+
+	if (file_size >= (off_t) sizeof (t)) {
+
+		ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+
+		if (sfd < 0) {
+			error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+			return -1;
+		}
+
+		if (lseek (sfd, file_size - sizeof (t), SEEK_SET) != (off_t) (file_size - sizeof (t))
+		    || ::read (sfd, &t, sizeof (t)) != (ssize_t) sizeof (t)) {
+			error << string_compose (_("Cannot read peakfile @ %1 (%2)"), _peakpath, strerror (errno)) << endmsg;
+			return -1;
+		}
+
+		if (memcmp (t.magic, peakfile_magic, sizeof (t.magic)) == 0) {
+
+			uint64_t const data_end = file_size - sizeof (t);
+
+			if (t.version != peakfile_version || t.n_levels == 0 || t.n_levels > MAX_PEAK_LEVELS || t.fpp[0] != _FPP || t.offset[0] != 0) {
+				warning << string_compose (_("peakfile %1 has an unknown format (version %2) and will be rebuilt"), _peakpath, t.version) << endmsg;
+				return -1;
+			}
+
+			vector<PeakLevel> levels;
+
+			for (uint32_t n = 0; n < t.n_levels; ++n) {
+				if (t.offset[n] + t.npeaks[n] * sizeof (PeakData) > data_end) {
+					warning << string_compose (_("peakfile %1 is truncated and will be rebuilt"), _peakpath) << endmsg;
+					return -1;
+				}
+				levels.push_back (PeakLevel (t.fpp[n], t.offset[n], t.npeaks[n]));
+			}
+
+			DEBUG_TRACE (DEBUG::Peaks, string_compose ("Peakfile %1 has %2 levels\n", _peakpath, levels.size()));
+
+			Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+			_peak_levels.swap (levels);
+			return t.npeaks[0] * sizeof (PeakData);
+		}
+	}
+
+	/* a single-level peakfile, written by an older version */
+
+	if (_build_peakfiles) {
+		ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDWR, 0664));
+		if (sfd >= 0) {
+			DEBUG_TRACE (DEBUG::Peaks, string_compose ("Adding peak levels to Peakfile %1\n", _peakpath));
+			if (write_peak_levels (sfd, file_size / sizeof (PeakData)) == 0) {
+				return (file_size / sizeof (PeakData)) * sizeof (PeakData);
+			}
+		}
+	}
+
+	return file_size;
+}
+
+/** Append the peaks in @param src, reduced by PEAK_LEVEL_RATIO, to @param dst */
+static void
+decimate_peaks (PeakData const * src, framecnt_t n, vector<PeakData>& dst)
+{
+	for (framecnt_t i = 0; i < n; i += PEAK_LEVEL_RATIO) {
+		framecnt_t const end = min (i + (framecnt_t) PEAK_LEVEL_RATIO, n);
+		PeakData p = src[i];
+		for (framecnt_t j = i + 1; j < end; ++j) {
+			p.max = max (p.max, src[j].max);
+			p.min = min (p.min, src[j].min);
+		}
+		dst.push_back (p);
+	}
+}
+
+/** Compute the coarser levels of peaks from the @param npeaks finest
+ *  ones at the start of the peakfile open on @param fd, and append them
+ *  and the level table to the file.
+ *  @return 0 on success (including when the file is too short to bother)
+ */
+int
+AudioSource::write_peak_levels (int fd, framecnt_t npeaks)
+{
+	if (fd < 0 || npeaks < PEAK_LEVEL_RATIO) {
+		return 0;
+	}
+
+	const framecnt_t chunksize = PEAK_LEVEL_RATIO * 4096;
+	boost::scoped_array<PeakData> buf (new PeakData[chunksize]);
+	vector<PeakData> levels[MAX_PEAK_LEVELS - 1];
+
+	levels[0].reserve (npeaks / PEAK_LEVEL_RATIO + 1);
+
+	if (lseek (fd, 0, SEEK_SET) != 0) {
+		error << string_compose(_("%1: could not seek in peak file data (%2)"), _name, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	/* chunksize is a multiple of the ratio, so every chunk starts a new coarse peak */
+
+	for (framecnt_t done = 0; done < npeaks; ) {
+		framecnt_t const n = min (chunksize, npeaks - done);
+		if (::read (fd, buf.get(), n * sizeof (PeakData)) != (ssize_t) (n * sizeof (PeakData))) {
+			error << string_compose(_("%1: could not read peak file data (%2)"), _name, strerror (errno)) << endmsg;
+			return -1;
+		}
+		decimate_peaks (buf.get(), n, levels[0]);
+		done += n;
+	}
+
+	for (uint32_t n = 1; n < MAX_PEAK_LEVELS - 1 && levels[n-1].size() >= PEAK_LEVEL_RATIO; ++n) {
+		decimate_peaks (&levels[n-1][0], levels[n-1].size(), levels[n]);
+	}
+
+	PeakFileTrailer t;
+	vector<PeakLevel> table;
+	off_t const level_start = npeaks * sizeof (PeakData);
+	off_t pos = level_start;
+
+	memset (&t, 0, sizeof (t));
+	table.push_back (PeakLevel (_FPP, 0, npeaks));
+
+	for (uint32_t n = 0; n < MAX_PEAK_LEVELS - 1 && !levels[n].empty(); ++n) {
+
+		ssize_t const bytes = levels[n].size() * sizeof (PeakData);
+
+		if (lseek (fd, pos, SEEK_SET) != pos || ::write (fd, &levels[n][0], bytes) != bytes) {
+			error << string_compose(_("%1: could not write peak file data (%2)"), _name, strerror (errno)) << endmsg;
+			goto fail;
+		}
+
+		table.push_back (PeakLevel (table.back().fpp * PEAK_LEVEL_RATIO, pos, levels[n].size()));
+		pos += bytes;
+	}
+
+	for (uint32_t n = 0; n < table.size(); ++n) {
+		t.offset[n] = table[n].offset;
+		t.npeaks[n] = table[n].npeaks;
+		t.fpp[n] = table[n].fpp;
+	}
+
+	t.n_levels = table.size();
+	t.version = peakfile_version;
+	memcpy (t.magic, peakfile_magic, sizeof (t.magic));
+
+	if (::write (fd, &t, sizeof (t)) != (ssize_t) sizeof (t)) {
+		error << string_compose(_("%1: could not write peak file data (%2)"), _name, strerror (errno)) << endmsg;
+		goto fail;
+	}
+
+	pos += sizeof (t);
+
+	if (ftruncate (fd, pos)) {
+		error << string_compose (_("could not truncate peakfile %1 to %2 (error: %3)"), _peakpath, pos, errno) << endmsg;
+		goto fail;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peak_levels_lock);
+		_peak_levels.swap (table);
+	}
+
+	return 0;
+
+  fail:
+	/* leave a valid single-level peakfile behind */
+	if (ftruncate (fd, level_start)) {
+		/* nothing more we can do */
+	}
+	return -1;
+}
+
 framecnt_t
 AudioSource::available_peaks (double zoom_factor) const
 {
@@ -25,12 +25,17 @@
 #include <poll.h>
 #endif
 
+#include <algorithm>
+#include <map>
+
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
+#include "ardour/audio_diskstream.h"
 #include "ardour/debug.h"
 #include "ardour/butler.h"
 #include "ardour/io.h"
 #include "ardour/midi_diskstream.h"
+#include "ardour/playlist.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
 #include "ardour/auditioner.h"
@@ -49,9 +54,16 @@ Butler::Butler(Session& s)
 	, audio_dstream_playback_buffer_size(0)
 	, midi_dstream_buffer_size(0)
 	, pool_trash(16)
+	, _worker_start_sem ("butler_worker_start", 0)
+	, _worker_done_sem ("butler_worker_done", 0)
+	, _workers_should_quit (false)
+	, _job_type (Refill)
 	, _xthread (true)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
+	g_atomic_int_set(&_next_job, 0);
+	g_atomic_int_set(&_job_work_outstanding, 0);
+	g_atomic_int_set(&_job_errors, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
         /* catch future changes to parameters */
@@ -146,6 +158,164 @@ Butler::terminate_thread ()
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
 	}
+
+	/* the butler thread is gone, nobody else touches the workers */
+	set_worker_count (0);
+}
+
+/** Start or stop disk I/O worker threads so that there are @param n of
+ *  them. Only called from the butler thread between passes (or once it
+ *  has finished), when all workers are idle.
+ */
+void
+Butler::set_worker_count (uint32_t n)
+{
+	if (n == _workers.size ()) {
+		return;
+	}
+
+	if (!_workers.empty ()) {
+		_workers_should_quit = true;
+		for (uint32_t i = 0; i < _workers.size (); ++i) {
+			_worker_start_sem.signal ();
+		}
+		for (std::vector<pthread_t>::iterator i = _workers.begin(); i != _workers.end(); ++i) {
+			void* status;
+			pthread_join (*i, &status);
+		}
+		_workers.clear ();
+		_workers_should_quit = false;
+	}
+
+	for (uint32_t i = 0; i < n; ++i) {
+		pthread_t t;
+		if (pthread_create_and_store ("disk worker", &t, _worker_thread_work, this)) {
+			error << _("Session: could not create disk worker thread") << endmsg;
+			break;
+		}
+		_workers.push_back (t);
+	}
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler now has %1 disk worker threads\n", _workers.size()));
+}
+
+void *
+Butler::_worker_thread_work (void* arg)
+{
+	pthread_set_name (X_("disk worker"));
+	AudioDiskstream::allocate_thread_working_buffers ();
+	((Butler *) arg)->worker_thread_work ();
+	return 0;
+}
+
+void
+Butler::worker_thread_work ()
+{
+	while (true) {
+		_worker_start_sem.wait ();
+
+		if (_workers_should_quit) {
+			break;
+		}
+
+		process_jobs ();
+		_worker_done_sem.signal ();
+	}
+}
+
+/** Called by the butler and all workers: take tracks off the job queue and
+ *  refill or flush them, until the queue is empty or the butler has
+ *  something more urgent to do.
+ */
+void
+Butler::process_jobs ()
+{
+	gint const n_jobs = _jobs.size ();
+
+	while (!transport_work_requested() && should_run) {
+
+		gint const n = g_atomic_int_add (&_next_job, 1);
+
+		if (n >= n_jobs) {
+			break;
+		}
+
+		Job const & job (_jobs[n]);
+
+		for (std::vector<boost::shared_ptr<Track> >::const_iterator t = job.tracks.begin(); t != job.tracks.end(); ++t) {
+
+			boost::shared_ptr<Track> tr = *t;
+			int ret;
+
+			if (_job_type == Refill) {
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), job.load));
+				ret = tr->do_refill ();
+			} else {
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), job.load));
+				ret = tr->do_flush (ButlerContext, false);
+			}
+
+			switch (ret) {
+			case 0:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack %1 done %2\n", (_job_type == Refill ? "refill" : "flush"), tr->name()));
+				break;
+
+			case 1:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack %1 unfinished %2\n", (_job_type == Refill ? "refill" : "flush"), tr->name()));
+				g_atomic_int_set (&_job_work_outstanding, 1);
+				break;
+
+			default:
+				if (_job_type == Refill) {
+					error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+					std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+				} else {
+					g_atomic_int_inc (&_job_errors);
+					error << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << endmsg;
+					std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << std::endl;
+				}
+				break;
+			}
+		}
+	}
+}
+
+/** Run the jobs in _jobs, spread across the butler and its workers.
+ *  @return true if there is more disk work to do.
+ */
+bool
+Butler::run_jobs (JobType type, uint32_t& errors)
+{
+	if (_jobs.empty ()) {
+		return false;
+	}
+
+	/* emptiest buffers first */
+	std::stable_sort (_jobs.begin(), _jobs.end());
+
+	_job_type = type;
+	g_atomic_int_set (&_next_job, 0);
+	g_atomic_int_set (&_job_work_outstanding, 0);
+	g_atomic_int_set (&_job_errors, 0);
+
+	uint32_t const n_workers = std::min (_workers.size (), _jobs.size () - 1);
+
+	for (uint32_t i = 0; i < n_workers; ++i) {
+		_worker_start_sem.signal ();
+	}
+
+	process_jobs ();
+
+	for (uint32_t i = 0; i < n_workers; ++i) {
+		_worker_done_sem.wait ();
+	}
+
+	errors += g_atomic_int_get (&_job_errors);
+
+	/* the queue may have been abandoned for transport work, in
+	   which case we didn't get to all the streams
+	*/
+	return g_atomic_int_get (&_job_work_outstanding) || g_atomic_int_get (&_next_job) < (gint) _jobs.size ();
 }
 
 void *
@@ -162,7 +332,6 @@ Butler::thread_work ()
 	uint32_t err = 0;
 
 	bool disk_work_outstanding = false;
-	RouteList::iterator i;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time()));
@@ -219,47 +388,14 @@ Butler::thread_work ()
 			_session.the_auditioner()->seek_response(audition_seek);
 		}
 
+		set_worker_count (std::max (Config->get_disk_io_threads (), (uint32_t) 1) - 1);
+
 		boost::shared_ptr<RouteList> rl = _session.get_routes();
 
 		RouteList rl_with_auditioner = *rl;
 		rl_with_auditioner.push_back (_session.the_auditioner());
 
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
-
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			boost::shared_ptr<IO> io = tr->input ();
-
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
-
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
-
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
-			}
-
-		}
-
-		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
-			/* we didn't get to all the streams */
+		if (refill_tracks (rl_with_auditioner)) {
 			disk_work_outstanding = true;
 		}
 
@@ -307,14 +443,18 @@ Butler::thread_work ()
 	return (0);
 }
 
+/** Refill the playback buffers of all active tracks in @param rl.
+ *  @return true if there is more disk work to do.
+ */
 bool
-Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+Butler::refill_tracks (RouteList const & rl)
 {
 	bool disk_work_outstanding = false;
+	std::map<Playlist const *, size_t> jobs_by_playlist;
 
-	for (RouteList::iterator i = rl->begin(); !transport_work_requested() && should_run && i != rl->end(); ++i) {
+	_jobs.clear ();
 
-		// cerr << "write behind for " << (*i)->name () << endl;
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
 
 		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
 
@@ -322,36 +462,90 @@ Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t&
 			continue;
 		}
 
-		/* note that we still try to flush diskstreams attached to inactive routes
-		 */
+		boost::shared_ptr<IO> io = tr->input ();
 
-		int ret;
+		if (io && !io->active()) {
+			/* don't read inactive tracks */
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+			continue;
+		}
 
-		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
-		ret = tr->do_flush (ButlerContext, false);
-		switch (ret) {
-		case 0:
-			DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
-			break;
+		if (!_workers.empty ()) {
+			/* compound regions are read via AudioPlaylistSource, whose
+			   mixdown buffers are shared by all threads: keep those
+			   tracks in the butler thread.
+			*/
+			boost::shared_ptr<Playlist> pl = tr->playlist ();
+			if (pl && pl->max_source_level () > 0) {
+				if (transport_work_requested() || !should_run) {
+					return true;
+				}
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1 (compound), playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+				switch (tr->do_refill ()) {
+				case 0:
+					break;
+				case 1:
+					disk_work_outstanding = true;
+					break;
+				default:
+					error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+					std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+					break;
+				}
+				continue;
+			}
+		}
 
-		case 1:
-			DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
-			disk_work_outstanding = true;
-			break;
+		boost::shared_ptr<Playlist> pl = tr->playlist ();
+		std::map<Playlist const *, size_t>::const_iterator j = jobs_by_playlist.find (pl.get ());
 
-		default:
-			errors++;
-			error << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << endmsg;
-			std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << std::endl;
-			/* don't break - try to flush all streams in case they
-			   are split across disks.
-			*/
+		if (pl && j != jobs_by_playlist.end ()) {
+			Job& job (_jobs[j->second]);
+			job.tracks.push_back (tr);
+			job.load = std::min (job.load, tr->playback_buffer_load ());
+			continue;
+		}
+
+		if (pl) {
+			jobs_by_playlist[pl.get ()] = _jobs.size ();
 		}
+		_jobs.push_back (Job (tr, tr->playback_buffer_load ()));
+	}
+
+	uint32_t errors = 0;
+
+	if (run_jobs (Refill, errors)) {
+		disk_work_outstanding = true;
 	}
 
 	return disk_work_outstanding;
 }
 
+bool
+Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+{
+	_jobs.clear ();
+
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		/* note that we still try to flush diskstreams attached to inactive routes.
+		   capture_buffer_load() is the free space, so fullest buffers go first.
+		*/
+		_jobs.push_back (Job (tr, tr->capture_buffer_load ()));
+	}
+
+	/* errors do not stop the pass - we try to flush all streams in case
+	   they are split across disks.
+	*/
+	return run_jobs (Flush, errors);
+}
+
 bool
 Butler::flush_tracks_to_disk_after_locate (boost::shared_ptr<RouteList> rl, uint32_t& errors)
 {
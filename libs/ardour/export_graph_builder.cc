@@ -34,7 +34,7 @@
 #include "audiographer/general/sample_format_converter.h"
 #include "audiographer/general/sr_converter.h"
 #include "audiographer/general/silence_trimmer.h"
-#include "audiographer/general/threader.h"
+#include "audiographer/general/worker_threader.h"
 #include "audiographer/sndfile/tmp_file.h"
 #include "audiographer/sndfile/tmp_file_rt.h"
 #include "audiographer/sndfile/tmp_file_sync.h"
@@ -49,16 +49,15 @@
 #include "ardour/sndfile_helpers.h"
 
 #include "pbd/file_utils.h"
-#include "pbd/cpus.h"
 
 using namespace AudioGrapher;
 using std::string;
 
 namespace ARDOUR {
 
-ExportGraphBuilder::ExportGraphBuilder (Session const & session)
+ExportGraphBuilder::ExportGraphBuilder (Session const & session, WorkerThreads & workers)
 	: session (session)
-	, thread_pool (hardware_concurrency())
+	, workers (workers)
 {
 	process_buffer_frames = session.engine().samples_per_cycle();
 }
@@ -68,14 +67,14 @@ ExportGraphBuilder::~ExportGraphBuilder ()
 }
 
 int
-ExportGraphBuilder::process (framecnt_t frames, bool last_cycle)
+ExportGraphBuilder::process (framecnt_t frames, bool last_cycle, framecnt_t offset)
 {
-	assert(frames <= process_buffer_frames);
+	assert(offset + frames <= process_buffer_frames);
 
 	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
 		Sample const * process_buffer = 0;
-		it->first->read (process_buffer, frames);
-		ConstProcessContext<Sample> context(process_buffer, frames, 1);
+		it->first->read (process_buffer, offset + frames);
+		ConstProcessContext<Sample> context(process_buffer + offset, frames, 1);
 		if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
 		it->second->process (context);
 	}
@@ -440,7 +439,7 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 	}
 
 	normalizer.reset (new AudioGrapher::Normalizer (use_loudness ? 0.0 : config.format->normalize_dbfs()));
-	threader.reset (new Threader<Sample> (parent.thread_pool));
+	threader.reset (new WorkerThreader<Sample> (parent.workers));
 	normalizer->alloc_buffer (max_frames_out);
 	normalizer->add_output (threader);
 
@@ -20,11 +20,16 @@
 
 #include "ardour/export_handler.h"
 
+#include <algorithm>
+
 #include "pbd/gstdio_compat.h"
 #include <glibmm.h>
 #include <glibmm/convert.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
+
+#include "audiographer/general/worker_threader.h"
 
 #include "ardour/audioengine.h"
 #include "ardour/audiofile_tagger.h"
@@ -36,6 +41,7 @@
 #include "ardour/export_status.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/soundcloud_upload.h"
 #include "ardour/system_exec.h"
 #include "pbd/openuri.h"
@@ -110,17 +116,21 @@ ExportElementFactory::add_filename_copy (ExportFilenamePtr other)
 ExportHandler::ExportHandler (Session & session)
   : ExportElementFactory (session)
   , session (session)
-  , graph_builder (new ExportGraphBuilder (session))
   , export_status (session.get_export_status ())
   , post_processing (false)
   , cue_tracknum (0)
   , cue_indexnum (0)
 {
+	/* the thread processing the graph runs part of it, too */
+	graph_workers.reset (new AudioGrapher::WorkerThreads (std::max (hardware_concurrency (), 1U) - 1));
+	graph_builders.push_back (boost::shared_ptr<ExportGraphBuilder> (new ExportGraphBuilder (session, *graph_workers)));
 }
 
 ExportHandler::~ExportHandler ()
 {
-	graph_builder->cleanup (export_status->aborted () );
+	for (std::vector<boost::shared_ptr<ExportGraphBuilder> >::iterator i = graph_builders.begin(); i != graph_builders.end(); ++i) {
+		(*i)->cleanup (export_status->aborted () );
+	}
 }
 
 /** Add an export to the `to-do' list */
@@ -164,6 +174,35 @@ ExportHandler::do_export ()
 	start_timespan ();
 }
 
+struct TimespanSortByStart {
+	bool operator() (ExportTimespanPtr a, ExportTimespanPtr b) {
+		return a->get_start() < b->get_start();
+	}
+};
+
+/** @return true if @param timespan can be exported in the same pass over
+ *  the session as other timespans. Region exports read the regions
+ *  themselves, with a position of their own, and realtime exports are
+ *  done one at a time.
+ */
+bool
+ExportHandler::can_share_pass (ExportTimespanPtr timespan)
+{
+	if (timespan->realtime ()) {
+		return false;
+	}
+
+	TimespanBounds bounds = config_map.equal_range (timespan);
+
+	for (ConfigMap::iterator it = bounds.first; it != bounds.second; ++it) {
+		if (it->second.channel_config->region_processing_type () != RegionExportChannelFactory::None) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void
 ExportHandler::start_timespan ()
 {
@@ -175,65 +214,124 @@ ExportHandler::start_timespan ()
 		return;
 	}
 
-	/* finish_timespan pops the config_map entry that has been done, so
-	   this is the timespan to do this time
+	/* finish_timespan pops the config_map entries that have been done, so
+	   the first timespan left is the one to do this time, possibly
+	   along with others close to it.
 	*/
-	current_timespan = config_map.begin()->first;
+	std::vector<ExportTimespanPtr> timespans;
+	timespans.push_back (config_map.begin()->first);
 
-	export_status->total_frames_current_timespan = current_timespan->get_length();
-	export_status->timespan_name = current_timespan->name();
-	export_status->processed_frames_current_timespan = 0;
+	if (Config->get_export_timespans_in_one_pass () && can_share_pass (timespans.front ())) {
+
+		/* rendering the session between two timespans costs no more
+		 * than the preroll of a separate pass.
+		 */
+		framecnt_t const max_gap = Config->get_export_preroll() * session.nominal_frame_rate ();
+		framepos_t start = timespans.front()->get_start();
+		framepos_t end = timespans.front()->get_end();
+
+		std::list<ExportTimespanPtr> others;
+		for (ConfigMap::iterator it = config_map.upper_bound (timespans.front ()); it != config_map.end(); it = config_map.upper_bound (it->first)) {
+			if (can_share_pass (it->first)) {
+				others.push_back (it->first);
+			}
+		}
+
+		bool grown = true;
+
+		while (grown) {
+			grown = false;
+			for (std::list<ExportTimespanPtr>::iterator i = others.begin(); i != others.end(); ) {
+				if ((*i)->get_start() <= end + max_gap && (*i)->get_end() + max_gap >= start) {
+					start = std::min (start, (*i)->get_start());
+					end = std::max (end, (*i)->get_end());
+					timespans.push_back (*i);
+					i = others.erase (i);
+					grown = true;
+				} else {
+					++i;
+				}
+			}
+		}
+
+		TimespanSortByStart cmp;
+		std::sort (timespans.begin(), timespans.end(), cmp);
+	}
 
-	/* Register file configurations to graph builder */
+	export_status->timespan += timespans.size () - 1;
 
-	/* Here's the config_map entries that use this timespan */
-	timespan_bounds = config_map.equal_range (current_timespan);
-	graph_builder->reset ();
-	graph_builder->set_current_timespan (current_timespan);
-	handle_duplicate_format_extensions();
-	bool realtime = current_timespan->realtime ();
+	while (graph_builders.size () < timespans.size ()) {
+		graph_builders.push_back (boost::shared_ptr<ExportGraphBuilder> (new ExportGraphBuilder (session, *graph_workers)));
+	}
+
+	current_timespans.clear ();
+	process_position = timespans.front()->get_start();
+	process_end = process_position;
+
+	bool const realtime = timespans.front()->realtime ();
 	bool region_export = true;
 	bool incl_master_bus = false;
-	for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
-		// Filenames can be shared across timespans
-		FileSpec & spec = it->second;
-		spec.filename->set_timespan (it->first);
-		switch (spec.channel_config->region_processing_type ()) {
-			case RegionExportChannelFactory::None:
-			case RegionExportChannelFactory::Processed:
-				region_export = false;
-				break;
-			default:
-				break;
-		}
+
+	for (size_t n = 0; n < timespans.size (); ++n) {
+
+		ExportTimespanPtr timespan = timespans[n];
+		boost::shared_ptr<ExportGraphBuilder> graph_builder = graph_builders[n];
+
+		current_timespans.push_back (TimespanExport (timespan, graph_builder));
+		process_end = std::max (process_end, timespan->get_end());
+
+		/* Register file configurations to graph builder */
+
+		/* Here's the config_map entries that use this timespan */
+		TimespanBounds timespan_bounds = config_map.equal_range (timespan);
+		graph_builder->reset ();
+		graph_builder->set_current_timespan (timespan);
+		handle_duplicate_format_extensions (timespan_bounds);
+		for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+			// Filenames can be shared across timespans
+			FileSpec & spec = it->second;
+			if (timespans.size () > 1) {
+				/* ... but these are all in use at the same time */
+				spec.filename = add_filename_copy (spec.filename);
+			}
+			spec.filename->set_timespan (it->first);
+			switch (spec.channel_config->region_processing_type ()) {
+				case RegionExportChannelFactory::None:
+				case RegionExportChannelFactory::Processed:
+					region_export = false;
+					break;
+				default:
+					break;
+			}
 #if 1 // hack alert -- align master bus, compensate master latency
 
-		/* there's no easier way to get this information here.
-		 * Ports are configured in the PortExportChannelSelector GUI,
-		 * This ExportHandler has no context of routes.
-		 */
-		boost::shared_ptr<Route> master_bus = session.master_out ();
-		if (master_bus) {
-			const PortSet& ps = master_bus->output ()->ports();
+			/* there's no easier way to get this information here.
+			 * Ports are configured in the PortExportChannelSelector GUI,
+			 * This ExportHandler has no context of routes.
+			 */
+			boost::shared_ptr<Route> master_bus = session.master_out ();
+			if (master_bus) {
+				const PortSet& ps = master_bus->output ()->ports();
 
-			const ExportChannelConfiguration::ChannelList& channels = spec.channel_config->get_channels ();
-			for (ExportChannelConfiguration::ChannelList::const_iterator it = channels.begin(); it != channels.end(); ++it) {
+				const ExportChannelConfiguration::ChannelList& channels = spec.channel_config->get_channels ();
+				for (ExportChannelConfiguration::ChannelList::const_iterator it = channels.begin(); it != channels.end(); ++it) {
 
-				boost::shared_ptr <PortExportChannel> pep = boost::dynamic_pointer_cast<PortExportChannel> (*it);
-				if (!pep) {
-					continue;
-				}
-				PortExportChannel::PortSet const& ports = pep->get_ports ();
-				for (PortExportChannel::PortSet::const_iterator it = ports.begin(); it != ports.end(); ++it) {
-					boost::shared_ptr<AudioPort> ap = (*it).lock();
-					if (ps.contains (ap)) {
-						incl_master_bus = true;
+					boost::shared_ptr <PortExportChannel> pep = boost::dynamic_pointer_cast<PortExportChannel> (*it);
+					if (!pep) {
+						continue;
+					}
+					PortExportChannel::PortSet const& ports = pep->get_ports ();
+					for (PortExportChannel::PortSet::const_iterator it = ports.begin(); it != ports.end(); ++it) {
+						boost::shared_ptr<AudioPort> ap = (*it).lock();
+						if (ps.contains (ap)) {
+							incl_master_bus = true;
+						}
 					}
 				}
 			}
-		}
 #endif
-		graph_builder->add_config (spec, realtime);
+			graph_builder->add_config (spec, realtime);
+		}
 	}
 
 	// ExportDialog::update_realtime_selection does not allow this
@@ -241,15 +339,22 @@ ExportHandler::start_timespan ()
 
 	/* start export */
 
+	if (timespans.size () > 1) {
+		export_status->timespan_name = string_compose ("%1 - %2", timespans.front()->name(), timespans.back()->name());
+	} else {
+		export_status->timespan_name = timespans.front()->name();
+	}
+	export_status->total_frames_current_timespan = process_end - process_position;
+	export_status->processed_frames_current_timespan = 0;
+
 	post_processing = false;
 	session.ProcessExport.connect_same_thread (process_connection, boost::bind (&ExportHandler::process, this, _1));
-	process_position = current_timespan->get_start();
 	// TODO check if it's a RegionExport.. set flag to skip  process_without_events()
 	session.start_audio_export (process_position, realtime, region_export, incl_master_bus);
 }
 
 void
-ExportHandler::handle_duplicate_format_extensions()
+ExportHandler::handle_duplicate_format_extensions (TimespanBounds const & timespan_bounds)
 {
 	typedef std::map<std::string, int> ExtCountMap;
 
@@ -295,7 +400,7 @@ ExportHandler::process_timespan (framecnt_t frames)
 	/* update position */
 
 	framecnt_t frames_to_read = 0;
-	framepos_t const end = current_timespan->get_end();
+	framepos_t const end = process_end;
 
 	bool const last_cycle = (process_position + frames >= end);
 
@@ -306,18 +411,47 @@ ExportHandler::process_timespan (framecnt_t frames)
 		frames_to_read = frames;
 	}
 
-	process_position += frames_to_read;
-	export_status->processed_frames += frames_to_read;
-	export_status->processed_frames_current_timespan += frames_to_read;
+	/* Do actual processing, of the part of this cycle within each timespan */
+
+	int ret = 0;
+	framepos_t const cycle_end = process_position + frames_to_read;
+
+	for (std::vector<TimespanExport>::iterator t = current_timespans.begin(); t != current_timespans.end(); ++t) {
+
+		if (t->written) {
+			continue;
+		}
 
-	/* Do actual processing */
-	int ret = graph_builder->process (frames_to_read, last_cycle);
+		framepos_t const start = std::max (process_position, t->timespan->get_start());
+		framepos_t const stop = std::min (cycle_end, t->timespan->get_end());
+
+		if (start > stop || (start == stop && stop < t->timespan->get_end())) {
+			/* not started yet */
+			continue;
+		}
+
+		t->written = (stop >= t->timespan->get_end());
+		ret |= t->graph_builder->process (stop - start, t->written, start - process_position);
+		export_status->processed_frames += stop - start;
+	}
+
+	process_position = cycle_end;
+	export_status->processed_frames_current_timespan += frames_to_read;
 
 	/* Start post-processing/normalizing if necessary */
 	if (last_cycle) {
-		post_processing = graph_builder->need_postprocessing ();
+		post_processing = false;
+		unsigned cycles = 0;
+
+		for (std::vector<TimespanExport>::iterator t = current_timespans.begin(); t != current_timespans.end(); ++t) {
+			if (t->graph_builder->need_postprocessing ()) {
+				post_processing = true;
+				cycles = std::max (cycles, t->graph_builder->get_postprocessing_cycle_count());
+			}
+		}
+
 		if (post_processing) {
-			export_status->total_postprocessing_cycles = graph_builder->get_postprocessing_cycle_count();
+			export_status->total_postprocessing_cycles = cycles;
 			export_status->current_postprocessing_cycle = 0;
 		} else {
 			finish_timespan ();
@@ -331,11 +465,19 @@ ExportHandler::process_timespan (framecnt_t frames)
 int
 ExportHandler::post_process ()
 {
-	if (graph_builder->post_process ()) {
+	bool done = true;
+
+	for (std::vector<TimespanExport>::iterator t = current_timespans.begin(); t != current_timespans.end(); ++t) {
+		if (!t->graph_builder->post_process ()) {
+			done = false;
+		}
+	}
+
+	if (done) {
 		finish_timespan ();
 		export_status->active_job = ExportStatus::Exporting;
 	} else {
-		if (graph_builder->realtime ()) {
+		if (current_timespans.front().graph_builder->realtime ()) {
 			export_status->active_job = ExportStatus::Encoding;
 		} else {
 			export_status->active_job = ExportStatus::Normalizing;
@@ -357,137 +499,146 @@ ExportHandler::command_output(std::string output, size_t size)
 void
 ExportHandler::finish_timespan ()
 {
-	graph_builder->get_analysis_results (export_status->result_map);
+	for (std::vector<TimespanExport>::iterator t = current_timespans.begin(); t != current_timespans.end(); ++t) {
+		t->graph_builder->get_analysis_results (export_status->result_map);
+	}
 
-	while (config_map.begin() != timespan_bounds.second) {
+	for (std::vector<TimespanExport>::iterator t = current_timespans.begin(); t != current_timespans.end(); ++t) {
+		ExportTimespanPtr current_timespan = t->timespan;
+		boost::shared_ptr<ExportGraphBuilder> graph_builder = t->graph_builder;
+		TimespanBounds timespan_bounds = config_map.equal_range (current_timespan);
 
-		ExportFormatSpecPtr fmt = config_map.begin()->second.format;
-		std::string filename = config_map.begin()->second.filename->get_path(fmt);
-		if (fmt->with_cue()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
-		}
+		for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
 
-		if (fmt->with_toc()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerTOC);
-		}
+			ExportFormatSpecPtr fmt = it->second.format;
+			std::string filename = it->second.filename->get_path(fmt);
+			if (fmt->with_cue()) {
+				export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
+			}
 
-		if (fmt->with_mp4chaps()) {
-			export_cd_marker_file (current_timespan, fmt, filename, MP4Chaps);
-		}
+			if (fmt->with_toc()) {
+				export_cd_marker_file (current_timespan, fmt, filename, CDMarkerTOC);
+			}
 
-		Session::Exported (current_timespan->name(), filename); /* EMIT SIGNAL */
+			if (fmt->with_mp4chaps()) {
+				export_cd_marker_file (current_timespan, fmt, filename, MP4Chaps);
+			}
 
-		/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
-		 * The process cannot access the file because it is being used.
-		 * ditto for post-export and upload.
-		 */
-		graph_builder->reset ();
+			Session::Exported (current_timespan->name(), filename); /* EMIT SIGNAL */
 
-		if (fmt->tag()) {
-			/* TODO: check Umlauts and encoding in filename.
-			 * TagLib eventually calls CreateFileA(),
+			/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
+			 * The process cannot access the file because it is being used.
+			 * ditto for post-export and upload.
 			 */
-			export_status->active_job = ExportStatus::Tagging;
-			AudiofileTagger::tag_file(filename, *SessionMetadata::Metadata());
-		}
+			graph_builder->reset ();
+
+			if (fmt->tag()) {
+				/* TODO: check Umlauts and encoding in filename.
+				 * TagLib eventually calls CreateFileA(),
+				 */
+				export_status->active_job = ExportStatus::Tagging;
+				AudiofileTagger::tag_file(filename, *SessionMetadata::Metadata());
+			}
 
-		if (!fmt->command().empty()) {
-			SessionMetadata const & metadata (*SessionMetadata::Metadata());
+			if (!fmt->command().empty()) {
+				SessionMetadata const & metadata (*SessionMetadata::Metadata());
 
 #if 0	// would be nicer with C++11 initialiser...
-			std::map<char, std::string> subs {
-				{ 'f', filename },
-				{ 'd', Glib::path_get_dirname(filename)  + G_DIR_SEPARATOR },
-				{ 'b', PBD::basename_nosuffix(filename) },
-				...
-			};
+				std::map<char, std::string> subs {
+					{ 'f', filename },
+					{ 'd', Glib::path_get_dirname(filename)  + G_DIR_SEPARATOR },
+					{ 'b', PBD::basename_nosuffix(filename) },
+					...
+				};
 #endif
-			export_status->active_job = ExportStatus::Command;
-			PBD::ScopedConnection command_connection;
-			std::map<char, std::string> subs;
-
-			std::stringstream track_number;
-			track_number << metadata.track_number ();
-			std::stringstream total_tracks;
-			total_tracks << metadata.total_tracks ();
-			std::stringstream year;
-			year << metadata.year ();
-
-			subs.insert (std::pair<char, std::string> ('a', metadata.artist ()));
-			subs.insert (std::pair<char, std::string> ('b', PBD::basename_nosuffix (filename)));
-			subs.insert (std::pair<char, std::string> ('c', metadata.copyright ()));
-			subs.insert (std::pair<char, std::string> ('d', Glib::path_get_dirname (filename) + G_DIR_SEPARATOR));
-			subs.insert (std::pair<char, std::string> ('f', filename));
-			subs.insert (std::pair<char, std::string> ('l', metadata.lyricist ()));
-			subs.insert (std::pair<char, std::string> ('n', session.name ()));
-			subs.insert (std::pair<char, std::string> ('s', session.path ()));
-			subs.insert (std::pair<char, std::string> ('o', metadata.conductor ()));
-			subs.insert (std::pair<char, std::string> ('t', metadata.title ()));
-			subs.insert (std::pair<char, std::string> ('z', metadata.organization ()));
-			subs.insert (std::pair<char, std::string> ('A', metadata.album ()));
-			subs.insert (std::pair<char, std::string> ('C', metadata.comment ()));
-			subs.insert (std::pair<char, std::string> ('E', metadata.engineer ()));
-			subs.insert (std::pair<char, std::string> ('G', metadata.genre ()));
-			subs.insert (std::pair<char, std::string> ('L', total_tracks.str ()));
-			subs.insert (std::pair<char, std::string> ('M', metadata.mixer ()));
-			subs.insert (std::pair<char, std::string> ('N', current_timespan->name())); // =?= config_map.begin()->first->name ()
-			subs.insert (std::pair<char, std::string> ('O', metadata.composer ()));
-			subs.insert (std::pair<char, std::string> ('P', metadata.producer ()));
-			subs.insert (std::pair<char, std::string> ('S', metadata.disc_subtitle ()));
-			subs.insert (std::pair<char, std::string> ('T', track_number.str ()));
-			subs.insert (std::pair<char, std::string> ('Y', year.str ()));
-			subs.insert (std::pair<char, std::string> ('Z', metadata.country ()));
-
-			ARDOUR::SystemExec *se = new ARDOUR::SystemExec(fmt->command(), subs);
-			info << "Post-export command line : {" << se->to_s () << "}" << endmsg;
-			se->ReadStdout.connect_same_thread(command_connection, boost::bind(&ExportHandler::command_output, this, _1, _2));
-			int ret = se->start (2);
-			if (ret == 0) {
-				// successfully started
-				while (se->is_running ()) {
-					// wait for system exec to terminate
-					Glib::usleep (1000);
+				export_status->active_job = ExportStatus::Command;
+				PBD::ScopedConnection command_connection;
+				std::map<char, std::string> subs;
+
+				std::stringstream track_number;
+				track_number << metadata.track_number ();
+				std::stringstream total_tracks;
+				total_tracks << metadata.total_tracks ();
+				std::stringstream year;
+				year << metadata.year ();
+
+				subs.insert (std::pair<char, std::string> ('a', metadata.artist ()));
+				subs.insert (std::pair<char, std::string> ('b', PBD::basename_nosuffix (filename)));
+				subs.insert (std::pair<char, std::string> ('c', metadata.copyright ()));
+				subs.insert (std::pair<char, std::string> ('d', Glib::path_get_dirname (filename) + G_DIR_SEPARATOR));
+				subs.insert (std::pair<char, std::string> ('f', filename));
+				subs.insert (std::pair<char, std::string> ('l', metadata.lyricist ()));
+				subs.insert (std::pair<char, std::string> ('n', session.name ()));
+				subs.insert (std::pair<char, std::string> ('s', session.path ()));
+				subs.insert (std::pair<char, std::string> ('o', metadata.conductor ()));
+				subs.insert (std::pair<char, std::string> ('t', metadata.title ()));
+				subs.insert (std::pair<char, std::string> ('z', metadata.organization ()));
+				subs.insert (std::pair<char, std::string> ('A', metadata.album ()));
+				subs.insert (std::pair<char, std::string> ('C', metadata.comment ()));
+				subs.insert (std::pair<char, std::string> ('E', metadata.engineer ()));
+				subs.insert (std::pair<char, std::string> ('G', metadata.genre ()));
+				subs.insert (std::pair<char, std::string> ('L', total_tracks.str ()));
+				subs.insert (std::pair<char, std::string> ('M', metadata.mixer ()));
+				subs.insert (std::pair<char, std::string> ('N', current_timespan->name())); // =?= config_map.begin()->first->name ()
+				subs.insert (std::pair<char, std::string> ('O', metadata.composer ()));
+				subs.insert (std::pair<char, std::string> ('P', metadata.producer ()));
+				subs.insert (std::pair<char, std::string> ('S', metadata.disc_subtitle ()));
+				subs.insert (std::pair<char, std::string> ('T', track_number.str ()));
+				subs.insert (std::pair<char, std::string> ('Y', year.str ()));
+				subs.insert (std::pair<char, std::string> ('Z', metadata.country ()));
+
+				ARDOUR::SystemExec *se = new ARDOUR::SystemExec(fmt->command(), subs);
+				info << "Post-export command line : {" << se->to_s () << "}" << endmsg;
+				se->ReadStdout.connect_same_thread(command_connection, boost::bind(&ExportHandler::command_output, this, _1, _2));
+				int ret = se->start (2);
+				if (ret == 0) {
+					// successfully started
+					while (se->is_running ()) {
+						// wait for system exec to terminate
+						Glib::usleep (1000);
+					}
+				} else {
+					error << "Post-export command FAILED with Error: " << ret << endmsg;
 				}
-			} else {
-				error << "Post-export command FAILED with Error: " << ret << endmsg;
+				delete (se);
 			}
-			delete (se);
-		}
 
-		// XXX THIS IS IN REALTIME CONTEXT, CALLED FROM
-		// AudioEngine::process_callback()
-		// freewheeling, yes, but still uploading here is NOT
-		// a good idea.
-		//
-		// even less so, since SoundcloudProgress is using
-		// connect_same_thread() - GUI updates from the RT thread
-		// will cause crashes. http://pastebin.com/UJKYNGHR
-		if (fmt->soundcloud_upload()) {
-			SoundcloudUploader *soundcloud_uploader = new SoundcloudUploader;
-			std::string token = soundcloud_uploader->Get_Auth_Token(soundcloud_username, soundcloud_password);
-			DEBUG_TRACE (DEBUG::Soundcloud, string_compose(
-						"uploading %1 - username=%2, password=%3, token=%4",
-						filename, soundcloud_username, soundcloud_password, token) );
-			std::string path = soundcloud_uploader->Upload (
-					filename,
-					PBD::basename_nosuffix(filename), // title
-					token,
-					soundcloud_make_public,
-					soundcloud_downloadable,
-					this);
-
-			if (path.length() != 0) {
-				info << string_compose ( _("File %1 uploaded to %2"), filename, path) << endmsg;
-				if (soundcloud_open_page) {
-					DEBUG_TRACE (DEBUG::Soundcloud, string_compose ("opening %1", path) );
-					open_uri(path.c_str());  // open the soundcloud website to the new file
+			// XXX THIS IS IN REALTIME CONTEXT, CALLED FROM
+			// AudioEngine::process_callback()
+			// freewheeling, yes, but still uploading here is NOT
+			// a good idea.
+			//
+			// even less so, since SoundcloudProgress is using
+			// connect_same_thread() - GUI updates from the RT thread
+			// will cause crashes. http://pastebin.com/UJKYNGHR
+			if (fmt->soundcloud_upload()) {
+				SoundcloudUploader *soundcloud_uploader = new SoundcloudUploader;
+				std::string token = soundcloud_uploader->Get_Auth_Token(soundcloud_username, soundcloud_password);
+				DEBUG_TRACE (DEBUG::Soundcloud, string_compose(
+							"uploading %1 - username=%2, password=%3, token=%4",
+							filename, soundcloud_username, soundcloud_password, token) );
+				std::string path = soundcloud_uploader->Upload (
+						filename,
+						PBD::basename_nosuffix(filename), // title
+						token,
+						soundcloud_make_public,
+						soundcloud_downloadable,
+						this);
+
+				if (path.length() != 0) {
+					info << string_compose ( _("File %1 uploaded to %2"), filename, path) << endmsg;
+					if (soundcloud_open_page) {
+						DEBUG_TRACE (DEBUG::Soundcloud, string_compose ("opening %1", path) );
+						open_uri(path.c_str());  // open the soundcloud website to the new file
+					}
+				} else {
+					error << _("upload to Soundcloud failed. Perhaps your email or password are incorrect?\n") << endmsg;
 				}
-			} else {
-				error << _("upload to Soundcloud failed. Perhaps your email or password are incorrect?\n") << endmsg;
+				delete soundcloud_uploader;
 			}
-			delete soundcloud_uploader;
 		}
-		config_map.erase (config_map.begin());
+
+		config_map.erase (timespan_bounds.first, timespan_bounds.second);
 	}
 
 	start_timespan ();
@@ -116,6 +116,7 @@
 #ifdef LV2_SUPPORT
 #include "ardour/uri_map.h"
 #endif
+#include "ardour/worker.h"
 #include "audiographer/routines.h"
 
 #if defined (__APPLE__)
@@ -140,6 +141,12 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain = 0;
 copy_vector_t			ARDOUR::copy_vector = 0;
+apply_gain_curve_to_buffer_t  ARDOUR::apply_gain_curve_to_buffer = 0;
+mix_buffers_with_gain_curve_t ARDOUR::mix_buffers_with_gain_curve = 0;
+uint32_t                ARDOUR::meter_lanes = 4;
+kmeter_process_t        ARDOUR::kmeter_process = 0;
+ppm_process_t           ARDOUR::ppm_process = 0;
+vumeter_process_t       ARDOUR::vumeter_process = 0;
 
 PBD::Signal1<void,std::string> ARDOUR::BootMessage;
 PBD::Signal3<void,std::string,std::string,bool> ARDOUR::PluginScanMessage;
@@ -171,24 +178,51 @@ setup_hardware_optimization (bool try_optimization)
 
 #if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
 
-#ifdef PLATFORM_WINDOWS
-		/* We have AVX-optimized code for Windows */
+		/* FMA is not used, even where it is available: a fused
+		 * multiply-add rounds differently from the default routines,
+		 * and mixing results should not depend on the CPU.
+		 */
 
-		if (fpu->has_avx()) {
-#else
-		/* AVX code doesn't compile on Linux yet */
+#ifndef PLATFORM_WINDOWS
+		if (fpu->has_avx512f()) {
+
+			info << "Using AVX-512F optimized routines" << endmsg;
+
+			// AVX-512F SET
+			compute_peak                = x86_avx512f_compute_peak;
+			find_peaks                  = x86_avx512f_find_peaks;
+			apply_gain_to_buffer        = x86_avx512f_apply_gain_to_buffer;
+			mix_buffers_with_gain       = x86_avx512f_mix_buffers_with_gain;
+			mix_buffers_no_gain         = x86_avx512f_mix_buffers_no_gain;
+			copy_vector                 = default_copy_vector;
+			apply_gain_curve_to_buffer  = x86_avx512f_apply_gain_curve_to_buffer;
+			mix_buffers_with_gain_curve = x86_avx512f_mix_buffers_with_gain_curve;
+			meter_lanes                 = 8;
+			kmeter_process              = x86_sse_avx_kmeter_process;
+			ppm_process                 = x86_sse_avx_ppm_process;
+			vumeter_process             = x86_sse_avx_vumeter_process;
 
-		if (false) {
+			generic_mix_functions = false;
+
+		} else
 #endif
+		if (fpu->has_avx()) {
+
 			info << "Using AVX optimized routines" << endmsg;
 
 			// AVX SET
-			compute_peak          = x86_sse_avx_compute_peak;
-			find_peaks            = x86_sse_avx_find_peaks;
-			apply_gain_to_buffer  = x86_sse_avx_apply_gain_to_buffer;
-			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
-			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
-			copy_vector           = x86_sse_avx_copy_vector;
+			compute_peak                = x86_sse_avx_compute_peak;
+			find_peaks                  = x86_sse_avx_find_peaks;
+			apply_gain_to_buffer        = x86_sse_avx_apply_gain_to_buffer;
+			mix_buffers_with_gain       = x86_sse_avx_mix_buffers_with_gain;
+			mix_buffers_no_gain         = x86_sse_avx_mix_buffers_no_gain;
+			copy_vector                 = x86_sse_avx_copy_vector;
+			apply_gain_curve_to_buffer  = x86_sse_avx_apply_gain_curve_to_buffer;
+			mix_buffers_with_gain_curve = x86_sse_avx_mix_buffers_with_gain_curve;
+			meter_lanes                 = 8;
+			kmeter_process              = x86_sse_avx_kmeter_process;
+			ppm_process                 = x86_sse_avx_ppm_process;
+			vumeter_process             = x86_sse_avx_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -197,12 +231,18 @@ setup_hardware_optimization (bool try_optimization)
 			info << "Using SSE optimized routines" << endmsg;
 
 			// SSE SET
-			compute_peak          = x86_sse_compute_peak;
-			find_peaks            = x86_sse_find_peaks;
-			apply_gain_to_buffer  = x86_sse_apply_gain_to_buffer;
-			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
-			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
-			copy_vector           = default_copy_vector;
+			compute_peak                = x86_sse_compute_peak;
+			find_peaks                  = x86_sse_find_peaks;
+			apply_gain_to_buffer        = x86_sse_apply_gain_to_buffer;
+			mix_buffers_with_gain       = x86_sse_mix_buffers_with_gain;
+			mix_buffers_no_gain         = x86_sse_mix_buffers_no_gain;
+			copy_vector                 = default_copy_vector;
+			apply_gain_curve_to_buffer  = x86_sse_apply_gain_curve_to_buffer;
+			mix_buffers_with_gain_curve = x86_sse_mix_buffers_with_gain_curve;
+			meter_lanes                 = 4;
+			kmeter_process              = x86_sse_kmeter_process;
+			ppm_process                 = x86_sse_ppm_process;
+			vumeter_process             = x86_sse_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -217,6 +257,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain  = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain    = veclib_mix_buffers_no_gain;
 			copy_vector            = default_copy_vector;
+			apply_gain_curve_to_buffer  = veclib_apply_gain_curve_to_buffer;
+			mix_buffers_with_gain_curve = veclib_mix_buffers_with_gain_curve;
+			meter_lanes            = 4;
+			kmeter_process         = default_kmeter_process;
+			ppm_process            = default_ppm_process;
+			vumeter_process        = default_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -237,6 +283,12 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		apply_gain_curve_to_buffer  = default_apply_gain_curve_to_buffer;
+		mix_buffers_with_gain_curve = default_mix_buffers_with_gain_curve;
+		meter_lanes           = 4;
+		kmeter_process        = default_kmeter_process;
+		ppm_process           = default_ppm_process;
+		vumeter_process       = default_vumeter_process;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
@@ -604,6 +656,7 @@ ARDOUR::cleanup ()
 #ifdef LXVST_SUPPORT
 	vstfx_exit();
 #endif
+	WorkerPool::destroy ();
 	delete &PluginManager::instance();
 	delete Config;
 	PBD::cleanup ();
@@ -21,11 +21,17 @@
 #include <cmath>
 
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/debug_rt_alloc.h"
+#include "pbd/malign.h"
 #include "pbd/pthread_utils.h"
 
+#include "ardour/ardour.h"
 #include "ardour/debug.h"
 #include "ardour/graph.h"
+#include "ardour/graphnode.h"
+#include "ardour/internal_send.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/types.h"
 #include "ardour/session.h"
 #include "ardour/route.h"
@@ -51,6 +57,41 @@ int alloc_allowed ()
 }
 #endif
 
+/** Index of the calling process thread, used to pick its own work queue */
+static Glib::Threads::Private<int> graph_thread_index;
+
+static inline uint32_t
+thread_index ()
+{
+	int* i = graph_thread_index.get ();
+	return i ? *i : 0;
+}
+
+/** Re-estimate the critical path every this many cycles */
+static const uint32_t critical_path_interval = 256;
+
+#ifndef NDEBUG
+static std::string
+node_name (node_ptr_t const & node)
+{
+	if (boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route> (node)) {
+		return r->name ();
+	}
+	if (boost::shared_ptr<SendGraphNode> s = boost::dynamic_pointer_cast<SendGraphNode> (node)) {
+		return string_compose ("%1 (send)", s->send()->name ());
+	}
+	return "?";
+}
+#endif
+
+struct CriticalPathLess {
+	CriticalPathLess (int c) : chain (c) {}
+	bool operator() (node_ptr_t const & a, node_ptr_t const & b) const {
+		return a->critical_path (chain) < b->critical_path (chain);
+	}
+	int chain;
+};
+
 Graph::Graph (Session & session)
         : SessionHandleRef (session)
         , _threads_active (false)
@@ -66,13 +107,24 @@ Graph::Graph (Session & session)
 	*/
 	_trigger_queue.reserve (8192);
 
-        _execution_tokens = 0;
-
         _current_chain = 0;
         _pending_chain = 0;
         _setup_chain   = 1;
         _graph_empty = true;
 
+	_work_pending = 0;
+	_idle_thread_cnt = 0;
+	_n_worker_threads = 0;
+	_critical_path_countdown = critical_path_interval;
+
+	for (int c = 0; c < 2; ++c) {
+		_work_stealing[c] = false;
+		_critical_path_scheduling[c] = false;
+		_node_array[c] = 0;
+		_node_array_size[c] = 0;
+		_n_init_triggers[c] = 0;
+	}
+
 
 	ARDOUR::AudioEngine::instance()->Running.connect_same_thread (engine_connections, boost::bind (&Graph::reset_thread_list, this));
 	ARDOUR::AudioEngine::instance()->Stopped.connect_same_thread (engine_connections, boost::bind (&Graph::engine_stopped, this));
@@ -86,6 +138,20 @@ Graph::Graph (Session & session)
 #endif
 }
 
+Graph::~Graph ()
+{
+	for (int c = 0; c < 2; ++c) {
+		for (WorkQueues::iterator i = _work_queues[c].begin(); i != _work_queues[c].end(); ++i) {
+			delete *i;
+		}
+		cache_aligned_free (_node_array[c]);
+	}
+
+	for (WorkQueues::iterator i = _retired_work_queues.begin(); i != _retired_work_queues.end(); ++i) {
+		delete *i;
+	}
+}
+
 void
 Graph::engine_stopped ()
 {
@@ -118,6 +184,7 @@ Graph::reset_thread_list ()
         }
 
         _threads_active = true;
+	_n_worker_threads = 0;
 
 	if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::main_thread, this)) != 0) {
 		throw failed_constructor ();
@@ -141,6 +208,22 @@ Graph::session_going_away()
         _init_trigger_list[0].clear();
         _init_trigger_list[1].clear();
         _trigger_queue.clear();
+
+	for (int c = 0; c < 2; ++c) {
+		for (WorkQueues::iterator i = _work_queues[c].begin(); i != _work_queues[c].end(); ++i) {
+			delete *i;
+		}
+		_work_queues[c].clear ();
+		cache_aligned_free (_node_array[c]);
+		_node_array[c] = 0;
+		_node_array_size[c] = 0;
+		_n_init_triggers[c] = 0;
+	}
+
+	for (WorkQueues::iterator i = _retired_work_queues.begin(); i != _retired_work_queues.end(); ++i) {
+		delete *i;
+	}
+	_retired_work_queues.clear ();
 }
 
 void
@@ -163,7 +246,8 @@ Graph::drop_threads ()
 
 	AudioEngine::instance()->join_process_threads ();
 
-	_execution_tokens = 0;
+	_idle_thread_cnt = 0;
+	_work_pending = 0;
 }
 
 void
@@ -209,6 +293,40 @@ Graph::prep()
 
         chain = _current_chain;
 
+	if (_critical_path_scheduling[chain] && --_critical_path_countdown == 0) {
+		update_critical_path (chain);
+		_critical_path_countdown = critical_path_interval;
+	}
+
+	if (_work_stealing[chain]) {
+		GraphNode** nodes = _node_array[chain];
+		uint32_t const n_nodes = _node_array_size[chain];
+
+		for (uint32_t n = 0; n < n_nodes; ++n) {
+			nodes[n]->prep (chain);
+		}
+		_graph_empty = (n_nodes == 0);
+		_finished_refcount = _init_finished_refcount[chain];
+
+		/* The initial triggers are at the front of the node array. Queue
+		   them on our own deque, the other threads will steal them.
+		   We pop from the bottom while thieves take from the top, so
+		   when they are sorted by critical path (longest first) queue
+		   the longest one last: this thread starts it right away and
+		   the other threads pick up the next longest ones.
+		*/
+		uint32_t const n_init = _n_init_triggers[chain];
+		if (n_init > 0) {
+			WorkQueue* q = _work_queues[chain][thread_index () % _work_queues[chain].size ()];
+			for (uint32_t n = 1; n < n_init; ++n) {
+				q->push (nodes[n]);
+			}
+			q->push (nodes[0]);
+			g_atomic_int_add (&_work_pending, n_init);
+		}
+		return;
+	}
+
         _graph_empty = true;
         for (i=_nodes_rt[chain].begin(); i!=_nodes_rt[chain].end(); i++) {
                 (*i)->prep( chain);
@@ -228,6 +346,15 @@ Graph::prep()
 void
 Graph::trigger (GraphNode* n)
 {
+	int const chain = _current_chain;
+
+	if (_work_stealing[chain]) {
+		/* only the owning thread pushes onto a deque */
+		_work_queues[chain][thread_index () % _work_queues[chain].size ()]->push (n);
+		g_atomic_int_inc (&_work_pending);
+		return;
+	}
+
 	pthread_mutex_lock (&_trigger_mutex);
         _trigger_queue.push_back (n);
 	pthread_mutex_unlock (&_trigger_mutex);
@@ -344,10 +471,122 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const & edges
 		}
         }
 
+        if (Config->get_graph_split_sends ()) {
+                split_sends (chain, edges);
+        }
+
+        _work_stealing[chain] = Config->get_use_work_stealing_scheduler ();
+        _critical_path_scheduling[chain] = Config->get_graph_critical_path_scheduling ();
+        setup_work_queues (chain);
+
+        if (_critical_path_scheduling[chain]) {
+                update_critical_path (chain);
+        }
+
         _pending_chain = chain;
         dump(chain);
 }
 
+/** Give each aux send between two routes of @param chain a node of its
+ *  own, fed by the route that it sends from and feeding its target, so
+ *  that its panning and gain can run in parallel with other routes.
+ *  Called with the swap mutex held, after the routes have been chained.
+ */
+void
+Graph::split_sends (int chain, GraphEdges const & edges)
+{
+	node_list_t nodes;
+
+	for (node_list_t::iterator ni = _nodes_rt[chain].begin(); ni != _nodes_rt[chain].end(); ++ni) {
+
+		boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route> (*ni);
+		set<GraphVertex> fed_from_r = edges.from (r);
+
+		/* keep the list in topological order: the send nodes go
+		   after the route they send from and so before their targets.
+		*/
+		nodes.push_back (*ni);
+
+		for (set<GraphVertex>::iterator i = fed_from_r.begin(); i != fed_from_r.end(); ++i) {
+
+			boost::shared_ptr<InternalSend> send = boost::dynamic_pointer_cast<InternalSend> (r->internal_send_for (*i));
+
+			if (!send || send->role () != Delivery::Aux) {
+				continue;
+			}
+
+			node_ptr_t sn (new SendGraphNode (r->_graph, send));
+
+			sn->_init_refcount[chain] = 1;
+			sn->_activation_set[chain].insert (*i);
+			(*i)->_init_refcount[chain] += 1;
+			r->_activation_set[chain].insert (sn);
+
+			DEBUG_TRACE (DEBUG::Graph, string_compose ("%1 gets a node for its send to %2\n", r->name(), (*i)->name()));
+
+			nodes.push_back (sn);
+		}
+	}
+
+	_nodes_rt[chain].swap (nodes);
+}
+
+/** Build the flat node array and per-thread work queues used by the
+ *  work-stealing scheduler for @param chain. Called with the swap mutex
+ *  held, on the chain that is not being processed.
+ */
+void
+Graph::setup_work_queues (int chain)
+{
+	uint32_t const n_nodes = _nodes_rt[chain].size ();
+
+	cache_aligned_free (_node_array[chain]);
+	_node_array[chain] = 0;
+	_node_array_size[chain] = 0;
+	_n_init_triggers[chain] = 0;
+
+	if (!_work_stealing[chain] || n_nodes == 0) {
+		return;
+	}
+
+	cache_aligned_malloc ((void**) &_node_array[chain], n_nodes * sizeof (GraphNode*));
+
+	/* nodes that need to be triggered initially go first */
+	uint32_t n = 0;
+	for (node_list_t::iterator i = _init_trigger_list[chain].begin(); i != _init_trigger_list[chain].end(); ++i) {
+		_node_array[chain][n++] = i->get ();
+	}
+	_n_init_triggers[chain] = n;
+
+	for (node_list_t::iterator i = _nodes_rt[chain].begin(); i != _nodes_rt[chain].end(); ++i) {
+		if ((*i)->_init_refcount[chain] > 0) {
+			_node_array[chain][n++] = i->get ();
+		}
+	}
+	assert (n == n_nodes);
+	_node_array_size[chain] = n;
+
+	/* There is one deque for each process thread; how_many_dsp_threads()
+	   never creates more than this. Every deque must be able to hold all
+	   nodes at once since any thread may end up triggering all of them.
+	*/
+	uint32_t const n_queues = max (hardware_concurrency (), (uint32_t) 2);
+
+	if (_work_queues[chain].size () == n_queues && _work_queues[chain].front ()->capacity () >= n_nodes) {
+		return;
+	}
+
+	/* a thread that was preempted in the middle of a steal may still look at
+	   the old queues; keep them around until the session goes away.
+	*/
+	_retired_work_queues.insert (_retired_work_queues.end (), _work_queues[chain].begin (), _work_queues[chain].end ());
+	_work_queues[chain].clear ();
+
+	for (uint32_t q = 0; q < n_queues; ++q) {
+		_work_queues[chain].push_back (new WorkQueue (n_nodes));
+	}
+}
+
 /** Called by both the main thread and all helpers.
  *  @return true to quit, false to carry on.
  */
@@ -364,40 +603,23 @@ Graph::run_one()
                 to_run = 0;
         }
 
-	/* the number of threads that are asleep */
-	int et = _execution_tokens;
-	/* the number of nodes that need to be run */
-	int ts = _trigger_queue.size();
-
-	/* hence how many threads to wake up */
-        int wakeup = min (et, ts);
-	/* update the number of threads that will still be sleeping */
-        _execution_tokens -= wakeup;
-
-        DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 signals %2\n", pthread_name(), wakeup));
-
-        for (int i = 0; i < wakeup; i++) {
-                _execution_sem.signal ();
-        }
+	/* wake up as many sleeping threads as there are nodes left to run */
+	wake_threads (_trigger_queue.size());
 
-        while (to_run == 0) {
-                _execution_tokens += 1;
+        if (to_run == 0) {
+                g_atomic_int_inc (&_idle_thread_cnt);
                 pthread_mutex_unlock (&_trigger_mutex);
                 DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name()));
                 _execution_sem.wait ();
-                if (!_threads_active) {
-                        return true;
-                }
                 DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name()));
-                pthread_mutex_lock (&_trigger_mutex);
-                if (_trigger_queue.size()) {
-                        to_run = _trigger_queue.back();
-                        _trigger_queue.pop_back();
-                }
+                /* the chain may have swapped to the other scheduler while
+                   we slept, so let run() pick it again.
+                */
+                return !_threads_active;
         }
         pthread_mutex_unlock (&_trigger_mutex);
 
-        to_run->process();
+        process_node (to_run);
         to_run->finish (_current_chain);
 
         DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name()));
@@ -405,17 +627,171 @@ Graph::run_one()
         return !_threads_active;
 }
 
+/** Estimate, for every node of @param chain, the time from its start until
+ *  everything that it (indirectly) feeds is done, from the measured node
+ *  DSP cost. Then order the initial triggers so that nodes on the longest
+ *  path get started first.
+ *
+ *  This does not allocate and is called from prep() in the process thread
+ *  every critical_path_interval cycles, as well as from rechain(). Each
+ *  only touches the estimates of its own chain, so the two never race.
+ */
+void
+Graph::update_critical_path (int chain)
+{
+	/* _nodes_rt is in topological order (see Session::resort_routes_using),
+	   so walking it backwards visits every node after the nodes it feeds.
+	*/
+	for (node_list_t::reverse_iterator ni = _nodes_rt[chain].rbegin(); ni != _nodes_rt[chain].rend(); ++ni) {
+		float longest = 0;
+		for (node_set_t::iterator ai = (*ni)->_activation_set[chain].begin(); ai != (*ni)->_activation_set[chain].end(); ++ai) {
+			longest = max (longest, (*ai)->_critical_path[chain]);
+		}
+		(*ni)->_critical_path[chain] = (*ni)->_dsp_cost + longest;
+	}
+
+	if (_work_stealing[chain]) {
+		/* insertion sort, longest critical path first */
+		GraphNode** nodes = _node_array[chain];
+		for (uint32_t n = 1; n < _n_init_triggers[chain]; ++n) {
+			GraphNode* node = nodes[n];
+			uint32_t m = n;
+			for (; m > 0 && nodes[m - 1]->_critical_path[chain] < node->_critical_path[chain]; --m) {
+				nodes[m] = nodes[m - 1];
+			}
+			nodes[m] = node;
+		}
+	} else {
+		/* _trigger_queue is run from the back, so longest goes last */
+		_init_trigger_list[chain].sort (CriticalPathLess (chain));
+	}
+}
+
+/** Process @param node, measuring its DSP cost when needed */
+void
+Graph::process_node (GraphNode* node)
+{
+	if (!_critical_path_scheduling[_current_chain]) {
+		node->process ();
+		return;
+	}
+
+	microseconds_t const then = get_microseconds ();
+	node->process ();
+	node->update_dsp_cost (get_microseconds () - then);
+}
+
+/** Pop a node from the calling thread's own queue, or steal one from
+ *  another thread's queue.
+ *  @return the node, or 0 if no work could be found.
+ */
+GraphNode*
+Graph::find_work (int chain)
+{
+	if (g_atomic_int_get (&_work_pending) <= 0) {
+		return 0;
+	}
+
+	WorkQueues const & queues (_work_queues[chain]);
+	uint32_t const n_queues = queues.size ();
+	uint32_t const self = thread_index () % n_queues;
+
+	GraphNode* node = queues[self]->pop ();
+
+	for (uint32_t i = 1; !node && i < n_queues; ++i) {
+		node = queues[(self + i) % n_queues]->steal ();
+	}
+
+	if (node) {
+		g_atomic_int_add (&_work_pending, -1);
+	}
+
+	return node;
+}
+
+/** Work-stealing equivalent of run_one(), which takes no locks.
+ *  @return true to quit, false to carry on.
+ */
+bool
+Graph::run_one_work_stealing()
+{
+	GraphNode* to_run = find_work (_current_chain);
+
+	/* Wake up idle threads, but no more than there is work left
+	   for them to steal.
+	*/
+	wake_threads (g_atomic_int_get (&_work_pending));
+
+	if (to_run == 0) {
+		/* Nothing to do. Any node queued by another thread while we go
+		   to sleep will be run by that thread itself, so no work is lost.
+		*/
+		g_atomic_int_inc (&_idle_thread_cnt);
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name()));
+		_execution_sem.wait ();
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name()));
+		/* as in run_one(), let run() pick the scheduler again */
+		return !_threads_active;
+	}
+
+	process_node (to_run);
+	to_run->finish (_current_chain);
+
+	DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 has finished run_one_work_stealing()\n", pthread_name()));
+
+	return !_threads_active;
+}
+
+/** Wake up to @param n sleeping threads. Both schedulers sleep on
+ *  _execution_sem and count sleepers in _idle_thread_cnt; the threads that
+ *  are woken are taken off the count here, so that no two threads wake the
+ *  same sleeper.
+ */
+void
+Graph::wake_threads (int n)
+{
+	while (n > 0) {
+		int const idle = g_atomic_int_get (&_idle_thread_cnt);
+		int const wakeup = min (idle, n);
+
+		if (wakeup <= 0) {
+			return;
+		}
+
+		if (g_atomic_int_compare_and_exchange (&_idle_thread_cnt, idle, idle - wakeup)) {
+			DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 signals %2\n", pthread_name(), wakeup));
+			for (int i = 0; i < wakeup; ++i) {
+				_execution_sem.signal ();
+			}
+			return;
+		}
+	}
+}
+
+/** Run one node using the scheduler selected for the current chain.
+ *  @return true to quit, false to carry on.
+ */
+bool
+Graph::run ()
+{
+	if (_work_stealing[_current_chain]) {
+		return run_one_work_stealing ();
+	}
+	return run_one ();
+}
+
 void
 Graph::helper_thread()
 {
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
+	graph_thread_index.set (new int (g_atomic_int_add (&_n_worker_threads, 1)));
 	resume_rt_malloc_checks ();
 
 	pt->get_buffers();
 
 	while(1) {
-		if (run_one()) {
+		if (run()) {
 			break;
 		}
 	}
@@ -430,6 +806,7 @@ Graph::main_thread()
 {
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
+	graph_thread_index.set (new int (g_atomic_int_add (&_n_worker_threads, 1)));
 	resume_rt_malloc_checks ();
 
 	pt->get_buffers();
@@ -454,7 +831,7 @@ again:
 	/* This loop will run forever */
 	while (1) {
 		DEBUG_TRACE(DEBUG::ProcessThreads, "main thread runs one graph node\n");
-		if (run_one()) {
+		if (run()) {
 			break;
 		}
 	}
@@ -474,16 +851,16 @@ Graph::dump (int chain)
 
         DEBUG_TRACE (DEBUG::Graph, "--------------------------------------------Graph dump:\n");
         for (ni=_nodes_rt[chain].begin(); ni!=_nodes_rt[chain].end(); ni++) {
-                boost::shared_ptr<Route> rp = boost::dynamic_pointer_cast<Route>( *ni);
-                DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", rp->name().c_str(), (*ni)->_init_refcount[chain]));
+                DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2 cost: %3 critical path: %4\n", node_name (*ni), (*ni)->_init_refcount[chain],
+                                                           (*ni)->_dsp_cost, (*ni)->_critical_path[chain]));
                 for (ai=(*ni)->_activation_set[chain].begin(); ai!=(*ni)->_activation_set[chain].end(); ai++) {
-                        DEBUG_TRACE (DEBUG::Graph, string_compose ("  triggers: %1\n", boost::dynamic_pointer_cast<Route>(*ai)->name().c_str()));
+                        DEBUG_TRACE (DEBUG::Graph, string_compose ("  triggers: %1\n", node_name (*ai)));
                 }
         }
 
         DEBUG_TRACE (DEBUG::Graph, "------------- trigger list:\n");
         for (ni=_init_trigger_list[chain].begin(); ni!=_init_trigger_list[chain].end(); ni++) {
-                DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", boost::dynamic_pointer_cast<Route>(*ni)->name().c_str(), (*ni)->_init_refcount[chain]));
+                DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", node_name (*ni), (*ni)->_init_refcount[chain]));
         }
 
         DEBUG_TRACE (DEBUG::Graph, string_compose ("final activation refcount: %1\n", _init_finished_refcount[chain]));
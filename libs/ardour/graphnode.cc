@@ -20,13 +20,17 @@
 
 #include "ardour/graph.h"
 #include "ardour/graphnode.h"
+#include "ardour/internal_send.h"
 #include "ardour/route.h"
 
 using namespace ARDOUR;
 
 GraphNode::GraphNode (boost::shared_ptr<Graph> graph)
         : _graph(graph)
+	, _dsp_cost (0)
 {
+	_critical_path[0] = 0;
+	_critical_path[1] = 0;
 }
 
 GraphNode::~GraphNode()
@@ -73,8 +77,37 @@ GraphNode::finish (int chain)
 }
 
 
+/** Fold the measured time of one run of this node into the smoothed cost
+ *  used by the graph's critical path estimate.
+ */
+void
+GraphNode::update_dsp_cost (microseconds_t elapsed)
+{
+	_dsp_cost += 0.05f * ((float) elapsed - _dsp_cost);
+}
+
 void
 GraphNode::process()
 {
         _graph->process_one_route (dynamic_cast<Route *>(this));
 }
+
+SendGraphNode::SendGraphNode (boost::shared_ptr<Graph> graph, boost::shared_ptr<InternalSend> send)
+	: GraphNode (graph)
+	, _send (send)
+{
+}
+
+void
+SendGraphNode::prep (int chain)
+{
+	GraphNode::prep (chain);
+	/* prep is called for all nodes before any of them are processed */
+	_send->defer_to_graph ();
+}
+
+void
+SendGraphNode::process ()
+{
+	_send->run_deferred ();
+}
@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include "ardour/iec1ppmdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float Iec1ppmdsp::_w1;
@@ -47,8 +48,7 @@ void Iec1ppmdsp::process (float const *p, int n)
 
     z1 = _z1 > 20 ? 20 : (_z1 < 0 ? 0 : _z1);
     z2 = _z2 > 20 ? 20 : (_z2 < 0 ? 0 : _z2);
-    m = _res ? 0: _m;
-    _res = false;
+    m = start ();
 
     n /= 4;
     while (n--)
@@ -77,6 +77,48 @@ void Iec1ppmdsp::process (float const *p, int n)
 }
 
 
+void Iec1ppmdsp::process (Iec1ppmdsp * const *meters, float const * const *p, int n_meters, int n)
+{
+    const int lanes = ARDOUR::meter_lanes;
+    float z1 [ARDOUR::max_meter_lanes];
+    float z2 [ARDOUR::max_meter_lanes];
+    float m [ARDOUR::max_meter_lanes];
+    int   i = 0;
+
+    for (; i + lanes <= n_meters; i += lanes)
+    {
+	for (int c = 0; c < lanes; ++c)
+	{
+	    Iec1ppmdsp *k = meters [i + c];
+	    z1 [c] = k->_z1 > 20 ? 20 : (k->_z1 < 0 ? 0 : k->_z1);
+	    z2 [c] = k->_z2 > 20 ? 20 : (k->_z2 < 0 ? 0 : k->_z2);
+	    m [c] = k->start ();
+	}
+	ARDOUR::ppm_process (p + i, n, z1, z2, m, _w1, _w2, _w3);
+	for (int c = 0; c < lanes; ++c)
+	{
+	    Iec1ppmdsp *k = meters [i + c];
+	    k->_z1 = z1 [c] + 1e-10f;
+	    k->_z2 = z2 [c] + 1e-10f;
+	    k->_m = m [c];
+	}
+    }
+    for (; i < n_meters; ++i)
+    {
+	meters [i]->process (p [i], n);
+    }
+}
+
+
+float Iec1ppmdsp::start (void)
+{
+    // Maximum to continue from, 0 after read().
+    float m = _res ? 0: _m;
+    _res = false;
+    return m;
+}
+
+
 float Iec1ppmdsp::read (void)
 {
     _res = true;
@@ -50,6 +50,12 @@ InternalSend::InternalSend (Session& s,
 	: Send (s, p, mm, role, ignore_bitslot)
 	, _send_from (sendfrom)
 	, _allow_feedback (false)
+	, _deferred (false)
+	, _deferred_pending (false)
+	, _deferred_start_frame (0)
+	, _deferred_end_frame (0)
+	, _deferred_speed (0)
+	, _deferred_nframes (0)
 {
 	if (sendto) {
 		if (use_target (sendto)) {
@@ -141,6 +147,37 @@ InternalSend::run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame
 		return;
 	}
 
+	if (_deferred && inbufs.available () >= bufs.count ()) {
+		/* bufs belong to the process thread, and will be reused once
+		   our route is done, so keep a copy for run_deferred().
+		*/
+		inbufs.set_count (bufs.count ());
+		inbufs.read_from (bufs, nframes);
+		_deferred_start_frame = start_frame;
+		_deferred_end_frame = end_frame;
+		_deferred_speed = speed;
+		_deferred_nframes = nframes;
+		_deferred_pending = true;
+		return;
+	}
+
+	send_buffers (bufs, start_frame, end_frame, speed, nframes);
+}
+
+void
+InternalSend::run_deferred ()
+{
+	if (_deferred_pending) {
+		send_buffers (inbufs, _deferred_start_frame, _deferred_end_frame, _deferred_speed, _deferred_nframes);
+	}
+
+	_deferred = false;
+	_deferred_pending = false;
+}
+
+void
+InternalSend::send_buffers (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, double speed, pframes_t nframes)
+{
 	// we have to copy the input, because we may alter the buffers with the amp
 	// in-place, which a send must never do.
 
@@ -269,6 +306,11 @@ InternalSend::set_block_size (pframes_t nframes)
 		mixbufs.ensure_buffers (_send_to->internal_return()->input_streams(), nframes);
 	}
 
+	if (_role == Aux) {
+		/* aux sends may be processed by the graph, see run() */
+		inbufs.ensure_buffers (_configured_input, nframes);
+	}
+
         return 0;
 }
 
@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include "ardour/kmeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float  Kmeterdsp::_omega;
@@ -75,6 +76,42 @@ void Kmeterdsp::process (float const *p, int n)
         z2 += 4 * _omega * (z1 - z2); // Update second filter.
     }
 
+    store (z1, z2);
+}
+
+void Kmeterdsp::process (Kmeterdsp * const *meters, float const * const *p, int n_meters, int n)
+{
+    const int lanes = ARDOUR::meter_lanes;
+    float z1 [ARDOUR::max_meter_lanes];
+    float z2 [ARDOUR::max_meter_lanes];
+    int   i = 0;
+
+    // Whole groups of channels go through the same filters
+    // side by side, the rest one by one.
+    for (; i + lanes <= n_meters; i += lanes)
+    {
+	for (int c = 0; c < lanes; ++c)
+	{
+	    Kmeterdsp *k = meters [i + c];
+	    z1 [c] = k->_z1 > 50 ? 50 : (k->_z1 < 0 ? 0 : k->_z1);
+	    z2 [c] = k->_z2 > 50 ? 50 : (k->_z2 < 0 ? 0 : k->_z2);
+	}
+	ARDOUR::kmeter_process (p + i, n, z1, z2, _omega);
+	for (int c = 0; c < lanes; ++c)
+	{
+	    meters [i + c]->store (z1 [c], z2 [c]);
+	}
+    }
+    for (; i < n_meters; ++i)
+    {
+	meters [i]->process (p [i], n);
+    }
+}
+
+void Kmeterdsp::store (float z1, float z2)
+{
+    float  s;
+
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     // Save filter state. The added constants avoid denormals.
@@ -1047,6 +1047,13 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("set_note_mode", &MidiPlaylist::set_note_mode)
 		.endClass ()
 
+		.beginClass <Track::RefillStats> ("RefillStats")
+		.addData ("count", &Track::RefillStats::count, false)
+		.addData ("last", &Track::RefillStats::last, false)
+		.addData ("max", &Track::RefillStats::max, false)
+		.addData ("total", &Track::RefillStats::total, false)
+		.endClass ()
+
 		.deriveWSPtrClass <Track, Route> ("Track")
 		.addCast<AudioTrack> ("to_audio_track")
 		.addCast<MidiTrack> ("to_midi_track")
@@ -1056,6 +1063,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("bounce", &Track::bounce)
 		.addFunction ("bounce_range", &Track::bounce_range)
 		.addFunction ("playlist", &Track::playlist)
+		.addFunction ("refill_stats", &Track::refill_stats)
+		.addFunction ("reset_refill_stats", &Track::reset_refill_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <AudioTrack, Track> ("AudioTrack")
@@ -2008,6 +2017,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("mix_buffers_no_gain", ARDOUR::mix_buffers_no_gain)
 		.addFunction ("mix_buffers_with_gain", ARDOUR::mix_buffers_with_gain)
 		.addFunction ("copy_vector", ARDOUR::copy_vector)
+		.addFunction ("apply_gain_curve_to_buffer", ARDOUR::apply_gain_curve_to_buffer)
+		.addFunction ("mix_buffers_with_gain_curve", ARDOUR::mix_buffers_with_gain_curve)
 		.addFunction ("dB_to_coefficient", &dB_to_coefficient)
 		.addFunction ("fast_coefficient_to_dB", &fast_coefficient_to_dB)
 		.addFunction ("accurate_coefficient_to_dB", &accurate_coefficient_to_dB)
@@ -55,6 +55,7 @@ LuaProc::LuaProc (AudioEngine& engine,
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 #endif
 	, _lua_dsp (0)
+	, _lua_ctrl_events (0)
 	, _script (script)
 	, _lua_does_channelmapping (false)
 	, _lua_has_inline_display (false)
@@ -86,6 +87,7 @@ LuaProc::LuaProc (const LuaProc &other)
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 #endif
 	, _lua_dsp (0)
+	, _lua_ctrl_events (0)
 	, _script (other.script ())
 	, _origin (other._origin)
 	, _lua_does_channelmapping (false)
@@ -124,6 +126,7 @@ LuaProc::~LuaProc () {
 #endif
 	lua.do_command ("collectgarbage();");
 	delete (_lua_dsp);
+	delete (_lua_ctrl_events);
 	delete [] _control_data;
 	delete [] _shadow_data;
 }
@@ -230,6 +233,12 @@ LuaProc::load_script ()
 		assert (0);
 	}
 
+	// optional: timestamped control changes, see parameter_events_supported ()
+	luabridge::LuaRef lua_ctrl_events = luabridge::getGlobal (L, "dsp_ctrl_events");
+	if (lua_ctrl_events.type () == LUA_TFUNCTION) {
+		_lua_ctrl_events = new luabridge::LuaRef (lua_ctrl_events);
+	}
+
 	// initialize the DSP if needed
 	luabridge::LuaRef lua_dsp_init = luabridge::getGlobal (L, "dsp_init");
 	if (lua_dsp_init.type () == LUA_TFUNCTION) {
@@ -595,7 +604,7 @@ LuaProc::configure_io (ChanCount in, ChanCount out)
 int
 LuaProc::connect_and_run (BufferSet& bufs,
 		framepos_t start, framepos_t end, double speed,
-		ChanMapping in, ChanMapping out,
+		ChanMapping const& in, ChanMapping const& out,
 		pframes_t nframes, framecnt_t offset)
 {
 	if (!_lua_dsp) {
@@ -625,6 +634,37 @@ LuaProc::connect_and_run (BufferSet& bufs,
 #endif
 
 	try {
+		if (_lua_ctrl_events && !_parameter_events.empty ()) {
+			/* values at the start of the cycle go to the control ports,
+			 * the script is given the changes within the cycle as
+			 * { time = sample (1-based), port = (1-based), value = .. }
+			 * in time order.
+			 */
+			lua_State* L = lua.getState ();
+			luabridge::LuaRef lua_events (luabridge::newTable (L));
+			int e = 1;
+			for (ParameterEvents::const_iterator i = _parameter_events.begin (); i != _parameter_events.end (); ++i) {
+				const uint32_t port = i->param.id ();
+				if (i->when == 0) {
+					_control_data[port] = i->value;
+					continue;
+				}
+				luabridge::LuaRef lua_event (luabridge::newTable (L));
+				lua_event["time"] = 1 + i->when;
+				lua_event["port"] = 1 + port;
+				lua_event["value"] = i->value;
+				lua_events[e++] = lua_event;
+			}
+			/* the last values remain once the cycle is over */
+			for (ParameterEvents::const_iterator i = _parameter_events.begin (); i != _parameter_events.end (); ++i) {
+				_shadow_data[i->param.id ()] = i->value;
+			}
+			_parameter_events.clear ();
+			if (e > 1) {
+				(*_lua_ctrl_events)(lua_events);
+			}
+		}
+
 		if (_lua_does_channelmapping) {
 			// run the DSP function
 			(*_lua_dsp)(&bufs, in, out, nframes, offset);
@@ -731,6 +771,7 @@ LuaProc::connect_and_run (BufferSet& bufs,
 #ifndef NDEBUG
 		std::cerr << "LuaException: " << e.what () << "\n";
 #endif
+		_parameter_events.clear ();
 		return -1;
 	}
 #ifdef WITH_LUAPROC_STATS
@@ -962,6 +1003,18 @@ LuaProc::parameter_is_output (uint32_t port) const
 	return (_ctrl_params[port].first);
 }
 
+/** Scripts that define dsp_ctrl_events () are given automation of their
+ *  input control ports as events, see LuaProc::connect_and_run ()
+ */
+bool
+LuaProc::parameter_events_supported (Evoral::Parameter const& param) const
+{
+	return _lua_ctrl_events
+		&& param.type () == PluginAutomation
+		&& param.id () < _ctrl_params.size ()
+		&& parameter_is_input (param.id ());
+}
+
 std::set<Evoral::Parameter>
 LuaProc::automatable () const
 {
@@ -863,6 +863,31 @@ LV2Plugin::requires_fixed_sized_buffers () const
 	return _no_sample_accurate_ctrl;
 }
 
+bool
+LV2Plugin::parameter_events_supported (Evoral::Parameter const& param) const
+{
+	/* Control ports have no notion of time, but property changes
+	 * are patch:Set messages which can be sent at any frame.
+	 */
+	if (param.type() != PluginPropertyAutomation || _patch_port_in_index == (uint32_t)-1) {
+		return false;
+	}
+	PropertyDescriptors::const_iterator p = _property_descriptors.find(param.id());
+	if (p == _property_descriptors.end()) {
+		return false;
+	}
+	switch (p->second.datatype) {
+	case Variant::BOOL:
+	case Variant::DOUBLE:
+	case Variant::FLOAT:
+	case Variant::INT:
+	case Variant::LONG:
+		return true;
+	default:
+		return false;
+	}
+}
+
 LV2Plugin::~LV2Plugin ()
 {
 	DEBUG_TRACE(DEBUG::LV2, string_compose("%1 destroy\n", name()));
@@ -2491,10 +2516,46 @@ write_position(LV2_Atom_Forge*     forge,
 	                       (const uint8_t*)(atom + 1));
 }
 
+/** Write a patch:Set message for a property parameter event to an
+ * LV2 event buffer.
+ * @return true on success.
+ */
+bool
+LV2Plugin::write_parameter_event(LV2_Evbuf* buf, ParameterEvent const& ev)
+{
+	PropertyDescriptors::const_iterator p = _property_descriptors.find(ev.param.id());
+	if (p == _property_descriptors.end()) {
+		return false;
+	}
+	const Variant value(p->second.datatype, ev.value);
+
+	LV2_Atom_Forge* forge = &_impl->forge;
+	uint8_t         msg_buf[256];
+	lv2_atom_forge_set_buffer(forge, msg_buf, sizeof(msg_buf));
+	LV2_Atom_Forge_Frame frame;
+#ifdef HAVE_LV2_1_10_0
+	lv2_atom_forge_object(forge, &frame, 0, _uri_map.urids.patch_Set);
+	lv2_atom_forge_key(forge, _uri_map.urids.patch_property);
+	lv2_atom_forge_urid(forge, ev.param.id());
+	lv2_atom_forge_key(forge, _uri_map.urids.patch_value);
+#else
+	lv2_atom_forge_blank(forge, &frame, 0, _uri_map.urids.patch_Set);
+	lv2_atom_forge_property_head(forge, _uri_map.urids.patch_property, 0);
+	lv2_atom_forge_urid(forge, ev.param.id());
+	lv2_atom_forge_property_head(forge, _uri_map.urids.patch_value, 0);
+#endif
+	forge_variant(forge, value);
+
+	LV2_Evbuf_Iterator    end  = lv2_evbuf_end(buf);
+	const LV2_Atom* const atom = (const LV2_Atom*)msg_buf;
+	return lv2_evbuf_write(&end, ev.when, 0, atom->type, atom->size,
+	                       (const uint8_t*)(atom + 1));
+}
+
 int
 LV2Plugin::connect_and_run(BufferSet& bufs,
 		framepos_t start, framepos_t end, double speed,
-		ChanMapping in_map, ChanMapping out_map,
+		ChanMapping const& in_map, ChanMapping const& out_map,
 		pframes_t nframes, framecnt_t offset)
 {
 	DEBUG_TRACE(DEBUG::LV2, string_compose("%1 run %2 offset %3\n", name(), nframes, offset));
@@ -2536,6 +2597,7 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 	uint32_t midi_in_index   = 0;
 	uint32_t midi_out_index  = 0;
 	uint32_t atom_port_index = 0;
+	bool     parameter_events_written = false;
 	for (uint32_t port_index = 0; port_index < num_ports; ++port_index) {
 		void*     buf   = NULL;
 		uint32_t  index = nil_index;
@@ -2606,15 +2668,28 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 					? bufs.get_midi(index).end()
 					: m;
 
-				// Now merge MIDI and any transport events into the buffer
+				// Parameter events go to the patch port
+				ParameterEvents::const_iterator pe     = _parameter_events.end();
+				ParameterEvents::const_iterator pe_end = _parameter_events.end();
+				if (port_index == _patch_port_in_index) {
+					pe = _parameter_events.begin();
+					parameter_events_written = true;
+				}
+
+				// Now merge MIDI, parameter and any transport events into the buffer
 				const uint32_t     type = _uri_map.urids.midi_MidiEvent;
 				const framepos_t   tend = end;
 				++metric_i;
-				while (m != m_end || (metric_i != tmap.metrics_end() &&
+				while (m != m_end || pe != pe_end || (metric_i != tmap.metrics_end() &&
 				                      (*metric_i)->frame() < tend)) {
 					MetricSection* metric = (metric_i != tmap.metrics_end())
 						? *metric_i : NULL;
-					if (m != m_end && (!metric || metric->frame() > (*m).time())) {
+					if (pe != pe_end
+					    && (m == m_end || (framepos_t) pe->when <= (*m).time())
+					    && (!metric || metric->frame() - start > (framepos_t) pe->when)) {
+						write_parameter_event(_ev_buffers[port_index], *pe);
+						++pe;
+					} else if (m != m_end && (!metric || metric->frame() > (*m).time())) {
 						const Evoral::Event<framepos_t> ev(*m, false);
 						if (ev.time() < nframes) {
 							LV2_Evbuf_Iterator eend = lv2_evbuf_end(_ev_buffers[port_index]);
@@ -2649,6 +2724,14 @@ LV2Plugin::connect_and_run(BufferSet& bufs,
 		lilv_instance_connect_port(_impl->instance, port_index, buf);
 	}
 
+	// Parameter events for a patch port that is not otherwise connected
+	if (!parameter_events_written && _patch_port_in_index != (uint32_t)-1) {
+		for (ParameterEvents::const_iterator i = _parameter_events.begin(); i != _parameter_events.end(); ++i) {
+			write_parameter_event(_ev_buffers[_patch_port_in_index], *i);
+		}
+	}
+	_parameter_events.clear();
+
 	// Read messages from UI and push into appropriate buffers
 	if (_from_ui) {
 		uint32_t read_space = _from_ui->read_space();
@@ -166,17 +166,22 @@ PeakMeter::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_fr
 			}
 		}
 
+		_audio_data[i] = bufs.get_audio(i).data();
+	}
+
+	/* the ballistics filters run on several channels at once */
+	if (n_audio > 0) {
 		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-			_kmeter[i]->process(bufs.get_audio(i).data(), nframes);
+			Kmeterdsp::process (&_kmeter[0], &_audio_data[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
-			_iec1meter[i]->process(bufs.get_audio(i).data(), nframes);
+			Iec1ppmdsp::process (&_iec1meter[0], &_audio_data[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
-			_iec2meter[i]->process(bufs.get_audio(i).data(), nframes);
+			Iec2ppmdsp::process (&_iec2meter[0], &_audio_data[0], n_audio, nframes);
 		}
 		if (_meter_type & MeterVU) {
-			_vumeter[i]->process(bufs.get_audio(i).data(), nframes);
+			Vumeterdsp::process (&_vumeter[0], &_audio_data[0], n_audio, nframes);
 		}
 	}
 
@@ -314,6 +319,7 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert(_iec1meter.size() == n_audio);
 	assert(_iec2meter.size() == n_audio);
 	assert(_vumeter.size() == n_audio);
+	_audio_data.resize (n_audio);
 
 	reset();
 	reset_max();
@@ -258,16 +258,20 @@ MidiModel::NoteDiffCommand::operator() ()
 		/* notes we modify in a way that requires remove-then-add to maintain ordering */
 		set<NotePtr> temporary_removals;
 
-		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
-			Property prop = i->property;
+		/* note not found during deserialization, so try again now that
+		 * the model state is different. do this before changing
+		 * anything, so that looking notes up by ID stays cheap.
+		 */
 
+		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
 			if (!i->note) {
-				/* note found during deserialization, so try
-				   again now that the model state is different.
-				*/
 				i->note = _model->find_note (i->note_id);
 				assert (i->note);
 			}
+		}
+
+		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+			Property prop = i->property;
 
 			switch (prop) {
 			case NoteNumber:
@@ -1569,17 +1573,11 @@ MidiModel::find_note (NotePtr other)
 Evoral::Sequence<MidiModel::TimeType>::NotePtr
 MidiModel::find_note (gint note_id)
 {
-	/* used only for looking up notes when reloading history from disk,
-	   so we don't care about performance *too* much.
+	/* used for looking up notes when reloading history from disk, which
+	   may refer to every note in a large model.
 	*/
 
-	for (Notes::iterator l = notes().begin(); l != notes().end(); ++l) {
-		if ((*l)->id() == note_id) {
-			return *l;
-		}
-	}
-
-	return NotePtr();
+	return note_by_id (note_id);
 }
 
 MidiModel::PatchChangePtr
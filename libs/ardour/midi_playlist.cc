@@ -364,6 +364,7 @@ MidiPlaylist::destroy_region (boost::shared_ptr<Region> region)
 
 			if ((*i) == region) {
 				regions.erase (i);
+				region_index.remove (region);
 				changed = true;
 			}
 
@@ -142,6 +142,133 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+void
+default_apply_gain_curve_to_buffer (ARDOUR::Sample * buf, pframes_t nframes, const gain_t * gain)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		buf[i] *= gain[i];
+	}
+}
+
+void
+default_mix_buffers_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, const gain_t * gain)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] += src[i] * gain[i];
+	}
+}
+
+/* The meter ballistics routines run the filters of the meter DSP classes
+ * one step at a time for all lanes, in the same order of operations, so
+ * that each lane gets exactly the result of the per-channel code. As
+ * there, any trailing (nframes % 4) samples are ignored. The state is
+ * kept in local arrays, which the compiler need not assume to alias the
+ * buffers.
+ */
+
+void
+default_kmeter_process (const ARDOUR::Sample * const * bufs, pframes_t nframes, float * z1p, float * z2p, float omega)
+{
+	float const omega4 = 4 * omega;
+	float z1[4], z2[4];
+
+	for (int c = 0; c < 4; ++c) {
+		z1[c] = z1p[c];
+		z2[c] = z2p[c];
+	}
+
+	for (pframes_t i = 0; i + 4 <= nframes; i += 4) {
+		for (int j = 0; j < 4; ++j) {
+			for (int c = 0; c < 4; ++c) {
+				float const s = bufs[c][i + j] * bufs[c][i + j];
+				z1[c] += omega * (s - z1[c]);
+			}
+		}
+		for (int c = 0; c < 4; ++c) {
+			z2[c] += omega4 * (z1[c] - z2[c]);
+		}
+	}
+
+	for (int c = 0; c < 4; ++c) {
+		z1p[c] = z1[c];
+		z2p[c] = z2[c];
+	}
+}
+
+void
+default_ppm_process (const ARDOUR::Sample * const * bufs, pframes_t nframes, float * z1p, float * z2p, float * mp, float w1, float w2, float w3)
+{
+	float z1[4], z2[4], m[4];
+
+	for (int c = 0; c < 4; ++c) {
+		z1[c] = z1p[c];
+		z2[c] = z2p[c];
+		m[c] = mp[c];
+	}
+
+	for (pframes_t i = 0; i + 4 <= nframes; i += 4) {
+		for (int c = 0; c < 4; ++c) {
+			z1[c] *= w3;
+			z2[c] *= w3;
+		}
+		for (int j = 0; j < 4; ++j) {
+			for (int c = 0; c < 4; ++c) {
+				/* select rather than branch, as SIMD code would */
+				float const t  = fabsf (bufs[c][i + j]);
+				float const a1 = z1[c] + w1 * (t - z1[c]);
+				float const a2 = z2[c] + w2 * (t - z2[c]);
+				z1[c] = t > z1[c] ? a1 : z1[c];
+				z2[c] = t > z2[c] ? a2 : z2[c];
+			}
+		}
+		for (int c = 0; c < 4; ++c) {
+			float const t = z1[c] + z2[c];
+			m[c] = t > m[c] ? t : m[c];
+		}
+	}
+
+	for (int c = 0; c < 4; ++c) {
+		z1p[c] = z1[c];
+		z2p[c] = z2[c];
+		mp[c] = m[c];
+	}
+}
+
+void
+default_vumeter_process (const ARDOUR::Sample * const * bufs, pframes_t nframes, float * z1p, float * z2p, float * mp, float w)
+{
+	float const w4 = 4 * w;
+	float z1[4], z2[4], m[4], t2[4];
+
+	for (int c = 0; c < 4; ++c) {
+		z1[c] = z1p[c];
+		z2[c] = z2p[c];
+		m[c] = mp[c];
+	}
+
+	for (pframes_t i = 0; i + 4 <= nframes; i += 4) {
+		for (int c = 0; c < 4; ++c) {
+			t2[c] = z2[c] / 2;
+		}
+		for (int j = 0; j < 4; ++j) {
+			for (int c = 0; c < 4; ++c) {
+				float const t1 = fabsf (bufs[c][i + j]) - t2[c];
+				z1[c] += w * (t1 - z1[c]);
+			}
+		}
+		for (int c = 0; c < 4; ++c) {
+			z2[c] += w4 * (z1[c] - z2[c]);
+			m[c] = z2[c] > m[c] ? z2[c] : m[c];
+		}
+	}
+
+	for (int c = 0; c < 4; ++c) {
+		z1p[c] = z1[c];
+		z2p[c] = z2[c];
+		mp[c] = m[c];
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -180,6 +307,18 @@ veclib_mix_buffers_no_gain (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pf
 	vDSP_vsma(src, 1, &gain, dst, 1, dst, 1, nframes);
 }
 
+void
+veclib_apply_gain_curve_to_buffer (ARDOUR::Sample * buf, pframes_t nframes, const gain_t * gain)
+{
+	vDSP_vmul(buf, 1, gain, 1, buf, 1, nframes);
+}
+
+void
+veclib_mix_buffers_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, const gain_t * gain)
+{
+	vDSP_vma(src, 1, gain, 1, dst, 1, dst, 1, nframes);
+}
+
 #endif
 
 
@@ -762,6 +762,7 @@ Playlist::add_region_internal (boost::shared_ptr<Region> region, framepos_t posi
 
 	regions.insert (upper_bound (regions.begin(), regions.end(), region, cmp), region);
 	all_regions.insert (region);
+	region_index.add (region);
 
 	possibly_splice_unlocked (position, region->length(), region);
 
@@ -774,6 +775,7 @@ Playlist::add_region_internal (boost::shared_ptr<Region> region, framepos_t posi
 
 	notify_region_added (region);
 
+	region->ExtentChanged.connect_same_thread (region_state_changed_connections, boost::bind (&Playlist::region_extent_changed, this, boost::weak_ptr<Region> (region)));
 	region->PropertyChanged.connect_same_thread (region_state_changed_connections, boost::bind (&Playlist::region_changed_proxy, this, _1, boost::weak_ptr<Region> (region)));
 	region->DropReferences.connect_same_thread (region_drop_references_connections, boost::bind (&Playlist::region_going_away, this, boost::weak_ptr<Region> (region)));
 
@@ -823,6 +825,7 @@ Playlist::remove_region_internal (boost::shared_ptr<Region> region)
 			framecnt_t distance = (*i)->length();
 
 			regions.erase (i);
+			region_index.remove (region);
 
 			possibly_splice_unlocked (pos, -distance);
 
@@ -1691,6 +1694,21 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 	 region_changed (what_changed, region);
  }
 
+ /** Keep the index in step with a region's extent as soon as it changes,
+  *  whatever state we or the region are in; PropertyChanged is held back
+  *  while the region's property changes are suspended (e.g. during a trim
+  *  drag), but reads must still find it where it is now.
+  */
+ void
+ Playlist::region_extent_changed (boost::weak_ptr<Region> weak_region)
+ {
+	 boost::shared_ptr<Region> region (weak_region.lock());
+
+	 if (region) {
+		 region_index.update (region);
+	 }
+ }
+
  bool
  Playlist::region_changed (const PropertyChange& what_changed, boost::shared_ptr<Region> region)
  {
@@ -1746,6 +1764,7 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 	 RegionWriteLock rl (this);
 	 regions.clear ();
 	 all_regions.clear ();
+	 region_index.clear ();
  }
 
  void
@@ -1774,6 +1793,7 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 		 }
 
 		 regions.clear ();
+		 region_index.clear ();
 
 		 for (set<boost::shared_ptr<Region> >::iterator s = pending_removes.begin(); s != pending_removes.end(); ++s) {
 			 remove_dependents (*s);
@@ -1891,8 +1911,11 @@ Playlist::find_regions_at (framepos_t frame)
 	/* Caller must hold lock */
 
 	boost::shared_ptr<RegionList> rlist (new RegionList);
+	vector<boost::shared_ptr<Region> > touched;
 
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	region_index.find (frame, frame, touched);
+
+	for (vector<boost::shared_ptr<Region> >::iterator i = touched.begin(); i != touched.end(); ++i) {
 		if ((*i)->covers (frame)) {
 			rlist->push_back (*i);
 		}
@@ -1946,14 +1969,34 @@ boost::shared_ptr<RegionList>
 Playlist::regions_touched_locked (framepos_t start, framepos_t end)
 {
 	boost::shared_ptr<RegionList> rlist (new RegionList);
+	vector<boost::shared_ptr<Region> > touched;
 
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	regions_touched_locked (start, end, touched);
+	rlist->insert (rlist->end(), touched.begin(), touched.end());
+
+	return rlist;
+}
+
+/** Append the regions that touch [@param start, @param end] to @param result,
+ *  in order of ascending position. Caller must hold lock.
+ */
+void
+Playlist::regions_touched_locked (framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >& result)
+{
+	vector<boost::shared_ptr<Region> >::size_type const n = result.size ();
+
+	region_index.find (start, end, result);
+
+	/* the index is updated from region change signals, which may still be
+	   pending; check the region's current extent.
+	*/
+	vector<boost::shared_ptr<Region> >::iterator o = result.begin() + n;
+	for (vector<boost::shared_ptr<Region> >::iterator i = o; i != result.end(); ++i) {
 		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
-			rlist->push_back (*i);
+			*o++ = *i;
 		}
 	}
-
-	return rlist;
+	result.erase (o, result.end());
 }
 
 framepos_t
@@ -33,6 +33,7 @@
 #include <sys/stat.h>
 #include <cerrno>
 #include <utility>
+#include <algorithm>
 
 #ifdef HAVE_LRDF
 #include <lrdf.h>
@@ -74,6 +75,9 @@ using namespace PBD;
 
 namespace ARDOUR { class AudioEngine; }
 
+/** capacity of a plugin's parameter event queue */
+static const size_t max_parameter_events = 1024;
+
 #ifdef NO_PLUGIN_STATE
 static bool seen_get_state_message = false;
 static bool seen_set_state_message = false;
@@ -102,6 +106,7 @@ Plugin::Plugin (AudioEngine& e, Session& s)
 	, _parameter_changed_since_last_preset (false)
 {
 	_pending_stop_events.ensure_buffers (DataType::MIDI, 1, 4096);
+	_parameter_events.reserve (max_parameter_events);
 }
 
 Plugin::Plugin (const Plugin& other)
@@ -116,6 +121,7 @@ Plugin::Plugin (const Plugin& other)
 	, _parameter_changed_since_last_preset (false)
 {
 	_pending_stop_events.ensure_buffers (DataType::MIDI, 1, 4096);
+	_parameter_events.reserve (max_parameter_events);
 }
 
 Plugin::~Plugin ()
@@ -346,7 +352,7 @@ Plugin::preset_by_uri (const string& uri)
 int
 Plugin::connect_and_run (BufferSet& bufs,
 		framepos_t /*start*/, framepos_t /*end*/, double /*speed*/,
-		ChanMapping /*in_map*/, ChanMapping /*out_map*/,
+		ChanMapping const& /*in_map*/, ChanMapping const& /*out_map*/,
 		pframes_t /* nframes */, framecnt_t /*offset*/)
 {
 	if (bufs.count().n_midi() > 0) {
@@ -367,6 +373,18 @@ Plugin::connect_and_run (BufferSet& bufs,
 	return 0;
 }
 
+bool
+Plugin::queue_parameter_event (Evoral::Parameter const& which, float val, pframes_t when)
+{
+	if (_parameter_events.size () == _parameter_events.capacity ()) {
+		/* never re-allocate in the process thread */
+		return false;
+	}
+	const ParameterEvent ev (which, val, when);
+	_parameter_events.insert (upper_bound (_parameter_events.begin (), _parameter_events.end (), ev), ev);
+	return true;
+}
+
 void
 Plugin::realtime_handle_transport_stopped ()
 {
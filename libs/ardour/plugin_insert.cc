@@ -37,6 +37,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rc_configuration.h"
 
 #ifdef LV2_SUPPORT
 #include "ardour/lv2_plugin.h"
@@ -81,6 +82,7 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	, _strict_io (false)
 	, _custom_cfg (false)
 	, _maps_from_state (false)
+	, _routing (new PinRouting)
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 {
@@ -513,6 +515,8 @@ PluginInsert::create_automatable_parameters ()
 		}
 	}
 	plugin->PresetPortSetValue.connect_same_thread (*this, boost::bind (&PluginInsert::preset_load_set_value, this, _1, _2));
+
+	_automation_event_values.resize (controls().size());
 }
 
 /** Called when something outside of this host has modified a plugin
@@ -711,32 +715,12 @@ PluginInsert::preset_load_set_value (uint32_t p, float v)
 }
 
 void
-PluginInsert::inplace_silence_unconnected (BufferSet& bufs, const PinMappings& out_map, framecnt_t nframes, framecnt_t offset) const
+PluginInsert::inplace_silence_unconnected (BufferSet& bufs, PinRouting const & routing, framecnt_t nframes, framecnt_t offset) const
 {
-	// TODO optimize: store "unconnected" in a fixed set.
-	// it only changes on reconfiguration.
 	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		const std::vector<int32_t>& outs (routing.inplace_out[*t]);
 		for (uint32_t out = 0; out < bufs.count().get (*t); ++out) {
-			bool mapped = false;
-			if (*t == DataType::MIDI && out == 0 && has_midi_bypass ()) {
-				mapped = true; // in-place Midi bypass
-			}
-			for (uint32_t pc = 0; pc < get_count() && !mapped; ++pc) {
-				PinMappings::const_iterator i = out_map.find (pc);
-				if (i == out_map.end ()) {
-					continue;
-				}
-				const ChanMapping& outmap (i->second);
-				for (uint32_t o = 0; o < natural_output_streams().get (*t); ++o) {
-					bool valid;
-					uint32_t idx = outmap.get (*t, o, &valid);
-					if (valid && idx == out) {
-						mapped = true;
-						break;
-					}
-				}
-			}
-			if (!mapped) {
+			if (out >= outs.size () || outs[out] == PinRouting::Silence) {
 				bufs.get (*t, out).silence (nframes, offset);
 			}
 		}
@@ -746,14 +730,8 @@ PluginInsert::inplace_silence_unconnected (BufferSet& bufs, const PinMappings& o
 void
 PluginInsert::connect_and_run (BufferSet& bufs, framepos_t start, framepos_t end, double speed, pframes_t nframes, framecnt_t offset, bool with_auto)
 {
-	// TODO: atomically copy maps & _no_inplace
-	PinMappings in_map (_in_map);
-	PinMappings out_map (_out_map);
-	ChanMapping thru_map (_thru_map);
-	if (_mapping_changed) { // ToDo use a counters, increment until match.
-		_no_inplace = check_inplace ();
-		_mapping_changed = false;
-	}
+	/* the maps, as they were when last compiled by update_routing () */
+	boost::shared_ptr<PinRouting> r = _routing.reader ();
 
 	if (_latency_changed) {
 		/* delaylines are configured with the max possible latency (as reported by the plugin)
@@ -772,29 +750,17 @@ PluginInsert::connect_and_run (BufferSet& bufs, framepos_t start, framepos_t end
 		_delaybuffers.set (ChanCount::max(bufs.count(), _configured_out), plugin_latency ());
 	}
 
-	if (_match.method == Split && !_no_inplace) {
-		// TODO: also use this optimization if one source-buffer
-		// feeds _all_ *connected* inputs.
-		// currently this is *first* buffer to all only --
-		// see PluginInsert::check_inplace
-		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			if (_configured_internal.get (*t) == 0) {
-				continue;
-			}
-			bool valid;
-			uint32_t first_idx = in_map[0].get (*t, 0, &valid);
-			assert (valid && first_idx == 0); // check_inplace ensures this
-			/* copy the first stream's buffer contents to the others */
-			for (uint32_t i = 1; i < natural_input_streams ().get (*t); ++i) {
-				uint32_t idx = in_map[0].get (*t, i, &valid);
-				if (valid) {
-					assert (idx == 0);
-					bufs.get (*t, i).read_from (bufs.get (*t, first_idx), nframes, offset, offset);
-				}
-			}
+	/* in-place Split: copy the first stream's buffer contents to the others.
+	 * TODO: also use this optimization if one source-buffer
+	 * feeds _all_ *connected* inputs.
+	 * currently this is *first* buffer to all only --
+	 * see PluginInsert::check_inplace
+	 */
+	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		const std::vector<uint32_t>& copies (r->split_copies[*t]);
+		for (std::vector<uint32_t>::const_iterator i = copies.begin (); i != copies.end (); ++i) {
+			bufs.get (*t, *i).read_from (bufs.get (*t, 0), nframes, offset, offset);
 		}
-		/* the copy operation produces a linear monotonic input map */
-		in_map[0] = ChanMapping (natural_input_streams ());
 	}
 
 	bufs.set_count(ChanCount::max(bufs.count(), _configured_internal));
@@ -857,10 +823,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, framepos_t start, framepos_t end
 #ifdef MIXBUS
 	if (is_channelstrip ()) {
 		if (_configured_in.n_audio() > 0) {
-			ChanMapping mb_in_map (ChanCount::min (_configured_in, ChanCount (DataType::AUDIO, 2)));
-			ChanMapping mb_out_map (ChanCount::min (_configured_out, ChanCount (DataType::AUDIO, 2)));
-
-			_plugins.front()->connect_and_run (bufs, start, end, speed, mb_in_map, mb_out_map, nframes, offset);
+			_plugins.front()->connect_and_run (bufs, start, end, speed, r->mb_in_map, r->mb_out_map, nframes, offset);
 
 			for (uint32_t out = _configured_in.n_audio (); out < bufs.count().get (DataType::AUDIO); ++out) {
 				bufs.get (DataType::AUDIO, out).silence (nframes, offset);
@@ -868,110 +831,74 @@ PluginInsert::connect_and_run (BufferSet& bufs, framepos_t start, framepos_t end
 		}
 	} else
 #endif
-	if (_no_inplace) {
-		// TODO optimize -- build maps once.
+	if (r->no_inplace) {
 		uint32_t pc = 0;
 		BufferSet& inplace_bufs  = _session.get_noinplace_buffers();
-		ARDOUR::ChanMapping used_outputs;
 
-		assert (inplace_bufs.count () >= natural_input_streams () + _configured_out);
+		assert (inplace_bufs.count () >= r->natural_in + _configured_out);
 
-		/* build used-output map */
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-				for (uint32_t out = 0; out < natural_output_streams().get (*t); ++out) {
-					bool valid;
-					uint32_t out_idx = out_map[pc].get (*t, out, &valid);
-					if (valid) {
-						used_outputs.set (*t, out_idx, 1); // mark as used
-					}
-				}
-			}
-		}
-		/* copy thru data to outputs before processing in-place */
+		/* copy thru data to outputs before processing in-place,
+		 * outputs are after the inputs in inplace_bufs.
+		 */
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			for (uint32_t out = 0; out < bufs.count().get (*t); ++out) {
-				bool valid;
-				uint32_t in_idx = thru_map.get (*t, out, &valid);
-				uint32_t m = out + natural_input_streams ().get (*t);
-				if (valid) {
-					_delaybuffers.delay (*t, out, inplace_bufs.get (*t, m), bufs.get (*t, in_idx), nframes, offset, offset);
-					used_outputs.set (*t, out, 1); // mark as used
-				} else {
-					used_outputs.get (*t, out, &valid);
-					if (valid) {
-						/* the plugin is expected to write here, but may not :(
-						 * (e.g. drumgizmo w/o kit loaded)
-						 */
-						inplace_bufs.get (*t, m).silence (nframes);
-					}
+			const std::vector<int32_t>& outs (r->noinplace_out[*t]);
+			const uint32_t nis = r->natural_in.get (*t);
+			for (uint32_t out = 0; out < outs.size (); ++out) {
+				if (outs[out] >= 0) {
+					_delaybuffers.delay (*t, out, inplace_bufs.get (*t, out + nis), bufs.get (*t, outs[out]), nframes, offset, offset);
+				} else if (outs[out] == PinRouting::Plugin) {
+					/* the plugin is expected to write here, but may not :(
+					 * (e.g. drumgizmo w/o kit loaded)
+					 */
+					inplace_bufs.get (*t, out + nis).silence (nframes, offset);
 				}
 			}
 		}
 
-		pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-
-			ARDOUR::ChanMapping i_in_map (natural_input_streams());
-			ARDOUR::ChanMapping i_out_map (out_map[pc]);
-			ARDOUR::ChanCount mapped;
+		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end() && pc < r->instances.size (); ++i, ++pc) {
+			PinRouting::Instance const & ri (r->instances[pc]);
 
 			/* map inputs sequentially */
 			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-				for (uint32_t in = 0; in < natural_input_streams().get (*t); ++in) {
-					bool valid;
-					uint32_t in_idx = in_map[pc].get (*t, in, &valid);
-					uint32_t m = mapped.get (*t);
-					if (valid) {
-						inplace_bufs.get (*t, m).read_from (bufs.get (*t, in_idx), nframes, offset, offset);
+				const std::vector<int32_t>& ins (ri.noinplace_in[*t]);
+				for (uint32_t in = 0; in < ins.size (); ++in) {
+					if (ins[in] >= 0) {
+						inplace_bufs.get (*t, in).read_from (bufs.get (*t, ins[in]), nframes, offset, offset);
 					} else {
-						inplace_bufs.get (*t, m).silence (nframes, offset);
+						inplace_bufs.get (*t, in).silence (nframes, offset);
 					}
-					mapped.set (*t, m + 1);
 				}
 			}
 
-			/* outputs are mapped to inplace_bufs after the inputs */
-			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-				i_out_map.offset_to (*t, natural_input_streams ().get (*t));
-			}
-
-			if ((*i)->connect_and_run (inplace_bufs, start, end, speed, i_in_map, i_out_map, nframes, offset)) {
+			if ((*i)->connect_and_run (inplace_bufs, start, end, speed, r->natural_in_map, ri.noinplace_out_map, nframes, offset)) {
 				deactivate ();
 			}
 		}
 
 		/* all instances have completed, now copy data that was written
 		 * and zero unconnected buffers */
-		ARDOUR::ChanMapping nonzero_out (used_outputs);
-		if (has_midi_bypass ()) {
-			nonzero_out.set (DataType::MIDI, 0, 1); // Midi bypass.
-		}
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+			const std::vector<int32_t>& outs (r->noinplace_out[*t]);
+			const uint32_t nis = r->natural_in.get (*t);
 			for (uint32_t out = 0; out < bufs.count().get (*t); ++out) {
-				bool valid;
-				used_outputs.get (*t, out, &valid);
-				if (!valid) {
-					nonzero_out.get (*t, out, &valid);
-					if (!valid) {
-						bufs.get (*t, out).silence (nframes, offset);
-					}
-				} else {
-					uint32_t m = out + natural_input_streams ().get (*t);
-					bufs.get (*t, out).read_from (inplace_bufs.get (*t, m), nframes, offset, offset);
+				const int32_t src = out < outs.size () ? outs[out] : (int32_t) PinRouting::Silence;
+				if (src == PinRouting::Silence) {
+					bufs.get (*t, out).silence (nframes, offset);
+				} else if (src != PinRouting::Untouched) {
+					bufs.get (*t, out).read_from (inplace_bufs.get (*t, out + nis), nframes, offset, offset);
 				}
 			}
 		}
 	} else {
 		/* in-place processing */
 		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map[pc], out_map[pc], nframes, offset)) {
+		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end() && pc < r->instances.size (); ++i, ++pc) {
+			if ((*i)->connect_and_run(bufs, start, end, speed, r->instances[pc].in_map, r->instances[pc].out_map, nframes, offset)) {
 				deactivate ();
 			}
 		}
 		// now silence unconnected outputs
-		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
+		inplace_silence_unconnected (bufs, *r, nframes, offset);
 	}
 
 	if (collect_signal_nframes > 0) {
@@ -1012,105 +939,51 @@ PluginInsert::bypass (BufferSet& bufs, pframes_t nframes)
 	/* bypass the plugin(s) not the whole processor.
 	 * -> use mappings just like connect_and_run
 	 */
-
-	// TODO: atomically copy maps & _no_inplace
-	const ChanMapping in_map (no_sc_input_map ());
-	const ChanMapping out_map (output_map ());
-	if (_mapping_changed) {
-		_no_inplace = check_inplace ();
-		_mapping_changed = false;
-	}
+	boost::shared_ptr<PinRouting> r = _routing.reader ();
 
 	bufs.set_count(ChanCount::max(bufs.count(), _configured_internal));
 	bufs.set_count(ChanCount::max(bufs.count(), _configured_out));
 
-	if (_no_inplace) {
-		ChanMapping thru_map (_thru_map);
-
+	if (r->no_inplace) {
 		BufferSet& inplace_bufs  = _session.get_noinplace_buffers();
-		// copy all inputs
+		// copy the inputs that feed an output
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			for (uint32_t in = 0; in < _configured_internal.get (*t); ++in) {
-				inplace_bufs.get (*t, in).read_from (bufs.get (*t, in), nframes, 0, 0);
-			}
-		}
-		ARDOUR::ChanMapping used_outputs;
-		// copy thru
-		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			for (uint32_t out = 0; out < _configured_out.get (*t); ++out) {
-				bool valid;
-				uint32_t in_idx = thru_map.get (*t, out, &valid);
-				if (valid) {
-					bufs.get (*t, out).read_from (inplace_bufs.get (*t, in_idx), nframes, 0, 0);
-					used_outputs.set (*t, out, 1); // mark as used
+			const std::vector<int32_t>& outs (r->bypass_out[*t]);
+			for (uint32_t out = 0; out < outs.size (); ++out) {
+				if (outs[out] >= 0) {
+					inplace_bufs.get (*t, outs[out]).read_from (bufs.get (*t, outs[out]), nframes, 0, 0);
 				}
 			}
 		}
-		// plugin no-op: assume every plugin has an internal identity map
+		// copy thru and plugin no-op (every plugin has an internal identity map),
+		// silence all unused outputs
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			for (uint32_t out = 0; out < _configured_out.get (*t); ++out) {
-				bool valid;
-				uint32_t src_idx = out_map.get_src (*t, out, &valid);
-				if (!valid) {
-					continue;
-				}
-				uint32_t in_idx = in_map.get (*t, src_idx, &valid);
-				if (!valid) {
-					continue;
-				}
-				bufs.get (*t, out).read_from (inplace_bufs.get (*t, in_idx), nframes, 0, 0);
-				used_outputs.set (*t, out, 1); // mark as used
-			}
-		}
-		// now silence all unused outputs
-		if (has_midi_bypass ()) {
-			used_outputs.set (DataType::MIDI, 0, 1); // Midi bypass.
-		}
-		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			for (uint32_t out = 0; out < _configured_out.get (*t); ++out) {
-				bool valid;
-				used_outputs.get (*t, out, &valid);
-				if (!valid) {
-						bufs.get (*t, out).silence (nframes, 0);
+			const std::vector<int32_t>& outs (r->bypass_out[*t]);
+			for (uint32_t out = 0; out < outs.size (); ++out) {
+				if (outs[out] >= 0) {
+					bufs.get (*t, out).read_from (inplace_bufs.get (*t, outs[out]), nframes, 0, 0);
+				} else if (outs[out] == PinRouting::Silence) {
+					bufs.get (*t, out).silence (nframes, 0);
 				}
 			}
 		}
 	} else {
-		if (_match.method == Split) {
-			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-				if (_configured_internal.get (*t) == 0) {
-					continue;
-				}
-				// copy/feeds _all_ *connected* inputs, copy the first buffer
-				bool valid;
-				uint32_t first_idx = in_map.get (*t, 0, &valid);
-				assert (valid && first_idx == 0); // check_inplace ensures this
-				for (uint32_t i = 1; i < natural_input_streams ().get (*t); ++i) {
-					uint32_t idx = in_map.get (*t, i, &valid);
-					if (valid) {
-						assert (idx == 0);
-						bufs.get (*t, i).read_from (bufs.get (*t, first_idx), nframes, 0, 0);
-					}
-				}
+		// in-place Split: copy/feeds _all_ *connected* inputs, copy the first buffer
+		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+			const std::vector<uint32_t>& copies (r->bypass_split_copies[*t]);
+			for (std::vector<uint32_t>::const_iterator i = copies.begin (); i != copies.end (); ++i) {
+				bufs.get (*t, *i).read_from (bufs.get (*t, 0), nframes, 0, 0);
 			}
 		}
 
 		// apply output map and/or monotonic but not identity i/o mappings
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			for (uint32_t out = 0; out < _configured_out.get (*t); ++out) {
-				bool valid;
-				uint32_t src_idx = out_map.get_src (*t, out, &valid);
-				if (!valid) {
-					bufs.get (*t, out).silence (nframes, 0);
-					continue;
-				}
-				uint32_t in_idx = in_map.get (*t, src_idx, &valid);
-				if (!valid) {
+			const std::vector<int32_t>& outs (r->bypass_out[*t]);
+			for (uint32_t out = 0; out < outs.size (); ++out) {
+				if (outs[out] >= 0) {
+					bufs.get (*t, out).read_from (bufs.get (*t, outs[out]), nframes, 0, 0);
+				} else if (outs[out] == PinRouting::Silence) {
 					bufs.get (*t, out).silence (nframes, 0);
-					continue;
-				}
-				if (in_idx != src_idx) {
-					bufs.get (*t, out).read_from (bufs.get (*t, in_idx), nframes, 0, 0);
 				}
 			}
 		}
@@ -1126,8 +999,9 @@ PluginInsert::silence (framecnt_t nframes, framepos_t start_frame)
 
 	_delaybuffers.flush ();
 
-	ChanMapping in_map (natural_input_streams ());
-	ChanMapping out_map (natural_output_streams ());
+	boost::shared_ptr<PinRouting> r = _routing.reader ();
+	ChanMapping const & in_map (r->natural_in_map);
+	ChanMapping const & out_map (r->natural_out_map);
 	ChanCount maxbuf = ChanCount::max (natural_input_streams (), natural_output_streams());
 #ifdef MIXBUS
 	if (is_channelstrip ()) {
@@ -1185,7 +1059,7 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, framepos_t end,
 		return;
 	}
 
-	if (!find_next_event (start, end, next_event) || _plugins.front()->requires_fixed_sized_buffers()) {
+	if (!find_next_event (start, end, next_event)) {
 
 		/* no events have a time within the relevant range */
 
@@ -1193,10 +1067,35 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, framepos_t end,
 		return;
 	}
 
+	const bool events = Config->get_plugin_automation_events ();
+
+	if (events && queue_automation_events (start, end, nframes)) {
+		/* the plugins apply all automation themselves, including
+		 * the values at the start of the cycle */
+		connect_and_run (bufs, start, end, speed, nframes, offset, false);
+		set_automation_event_values ();
+		return;
+	}
+
+	if (_plugins.front()->requires_fixed_sized_buffers()) {
+		connect_and_run (bufs, start, end, speed, nframes, offset, true);
+		return;
+	}
+
+	/* sub-blocks are no shorter than min_block, control values are
+	 * evaluated (interpolated) at the start of each sub-block.
+	 */
+	const framecnt_t min_block = events ? max ((uint32_t) 1, Config->get_plugin_automation_min_block ()) : 1;
+
 	while (nframes) {
 
 		framecnt_t cnt = min (((framecnt_t) ceil (next_event.when) - start), (framecnt_t) nframes);
 
+		cnt = max (cnt, min (min_block, (framecnt_t) nframes));
+		if (nframes - cnt < min_block) {
+			cnt = nframes;
+		}
+
 		connect_and_run (bufs, start, start + cnt, speed, cnt, offset, true); // XXX (start + cnt) * speed
 
 		nframes -= cnt;
@@ -1215,6 +1114,126 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, framepos_t end,
 	}
 }
 
+/** Hand the automation of all controls in automation playback mode to the
+ *  plugins as parameter events for the cycle [start, end), the first at the
+ *  start of the cycle. Discrete automation is delivered at the frame of each
+ *  event; other automation is interpolated at most every
+ *  plugin-automation-min-block frames.
+ *
+ *  @return true if the events were queued, false if a plugin cannot take
+ *  them (and nothing was queued).
+ */
+bool
+PluginInsert::queue_automation_events (framepos_t start, framepos_t end, pframes_t nframes)
+{
+	for (Controls::const_iterator li = controls().begin(); li != controls().end(); ++li) {
+		boost::shared_ptr<AutomationControl> c = boost::dynamic_pointer_cast<AutomationControl>(li->second);
+		if (!c || !c->list() || !c->automation_playback()) {
+			continue;
+		}
+		for (Plugins::const_iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+			if (!(*i)->parameter_events_supported (c->parameter ())) {
+				return false;
+			}
+		}
+	}
+
+	if (_automation_event_values.size () != controls().size ()) {
+		return false;
+	}
+
+	const framecnt_t grid = max ((uint32_t) 1, Config->get_plugin_automation_min_block ());
+	bool ok = true;
+	uint32_t n = 0;
+
+	for (Controls::const_iterator li = controls().begin(); li != controls().end() && ok; ++li, ++n) {
+		_automation_event_values[n].first = false;
+
+		boost::shared_ptr<AutomationControl> c = boost::dynamic_pointer_cast<AutomationControl>(li->second);
+		if (!c || !c->list() || !c->automation_playback()) {
+			continue;
+		}
+
+		boost::shared_ptr<Evoral::ControlList> alist (c->list());
+		const Evoral::Parameter param (c->parameter ());
+		bool valid;
+		float last = alist->rt_safe_eval (start, valid);
+
+		if (!valid) {
+			continue;
+		}
+
+		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+			ok = ok && (*i)->queue_parameter_event (param, last, 0);
+		}
+
+		if (alist->interpolation () == Evoral::ControlList::Discrete) {
+			/* the GUI may be editing the list: do not wait for it, but
+			 * let the caller split the cycle at the events instead.
+			 */
+			Glib::Threads::RWLock::ReaderLock lm (alist->lock(), Glib::Threads::TRY_LOCK);
+			if (!lm.locked()) {
+				ok = false;
+				break;
+			}
+			Evoral::ControlEvent cp (start, 0.0f);
+			for (Evoral::ControlList::const_iterator e = lower_bound (alist->begin(), alist->end(), &cp, Evoral::ControlList::time_comparator);
+			     e != alist->end() && (*e)->when < end && ok; ++e) {
+				const framecnt_t when = (framecnt_t) ceil ((*e)->when) - start;
+				if (when <= 0 || when >= (framecnt_t) nframes || (*e)->value == last) {
+					continue;
+				}
+				last = (*e)->value;
+				for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+					ok = ok && (*i)->queue_parameter_event (param, last, when);
+				}
+			}
+		} else {
+			for (framecnt_t when = grid; when < (framecnt_t) nframes && ok; when += grid) {
+				const float val = alist->rt_safe_eval (start + when, valid);
+				if (!valid || val == last) {
+					continue;
+				}
+				last = val;
+				for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+					ok = ok && (*i)->queue_parameter_event (param, last, when);
+				}
+			}
+		}
+
+		_automation_event_values[n] = make_pair (true, last);
+	}
+
+	if (!ok) {
+		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+			(*i)->clear_parameter_events ();
+		}
+	}
+	return ok;
+}
+
+/** Set the controls that queue_automation_events() handed to the plugins
+ *  to the last value that was delivered, as connect_and_run() does with the
+ *  value at the start of the cycle when it applies automation itself, so
+ *  that the GUI, the controls' listeners and the saved state follow along.
+ */
+void
+PluginInsert::set_automation_event_values ()
+{
+	uint32_t n = 0;
+
+	for (Controls::iterator li = controls().begin(); li != controls().end(); ++li, ++n) {
+		if (!_automation_event_values[n].first) {
+			continue;
+		}
+		boost::shared_ptr<AutomationControl> c = boost::dynamic_pointer_cast<AutomationControl>(li->second);
+		if (c) {
+			/* in automation playback mode, see connect_and_run() */
+			c->set_value_unchecked (_automation_event_values[n].second);
+		}
+	}
+}
+
 float
 PluginInsert::default_parameter_value (const Evoral::Parameter& param)
 {
@@ -1355,7 +1374,7 @@ PluginInsert::set_input_map (uint32_t num, ChanMapping m) {
 		changed |= sanitize_maps ();
 		if (changed) {
 			PluginMapChanged (); /* EMIT SIGNAL */
-			_mapping_changed = true;
+			update_routing ();
 			_session.set_dirty();
 		}
 	}
@@ -1369,7 +1388,7 @@ PluginInsert::set_output_map (uint32_t num, ChanMapping m) {
 		changed |= sanitize_maps ();
 		if (changed) {
 			PluginMapChanged (); /* EMIT SIGNAL */
-			_mapping_changed = true;
+			update_routing ();
 			_session.set_dirty();
 		}
 	}
@@ -1382,7 +1401,7 @@ PluginInsert::set_thru_map (ChanMapping m) {
 	changed |= sanitize_maps ();
 	if (changed) {
 		PluginMapChanged (); /* EMIT SIGNAL */
-		_mapping_changed = true;
+		update_routing ();
 		_session.set_dirty();
 	}
 }
@@ -1574,6 +1593,142 @@ PluginInsert::check_inplace ()
 	return !inplace_ok; // no-inplace
 }
 
+/** Compile the current maps into a PinRouting and publish it for the
+ *  process thread. Must be called whenever the maps or the configuration
+ *  change; PluginInsert::connect_and_run() and PluginInsert::bypass()
+ *  only ever look at the published routing.
+ */
+void
+PluginInsert::update_routing ()
+{
+	RCUWriter<PinRouting> writer (_routing);
+	boost::shared_ptr<PinRouting> r = writer.get_copy ();
+	*r = PinRouting ();
+
+	r->no_inplace = check_inplace ();
+	r->natural_in = natural_input_streams ();
+	r->natural_in_map = ChanMapping (natural_input_streams ());
+	r->natural_out_map = ChanMapping (natural_output_streams ());
+#ifdef MIXBUS
+	r->mb_in_map = ChanMapping (ChanCount::min (_configured_in, ChanCount (DataType::AUDIO, 2)));
+	r->mb_out_map = ChanMapping (ChanCount::min (_configured_out, ChanCount (DataType::AUDIO, 2)));
+#endif
+
+	const bool inplace_split = _match.method == Split && !r->no_inplace;
+	const bool midi_bypass = has_midi_bypass ();
+	const ChanCount n_out (ChanCount::max (_configured_internal, _configured_out));
+
+	/* per instance maps, and which outputs the plugins write to */
+	ChanMapping used_outputs;
+	r->instances.resize (get_count ());
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		PinRouting::Instance& ri (r->instances[pc]);
+		ri.in_map = _in_map[pc];
+		ri.out_map = _out_map[pc];
+		ri.noinplace_out_map = _out_map[pc];
+		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+			ri.noinplace_out_map.offset_to (*t, natural_input_streams ().get (*t));
+			ri.noinplace_in[*t].resize (natural_input_streams ().get (*t), PinRouting::Silence);
+			for (uint32_t in = 0; in < natural_input_streams ().get (*t); ++in) {
+				bool valid;
+				uint32_t in_idx = _in_map[pc].get (*t, in, &valid);
+				if (valid) {
+					ri.noinplace_in[*t][in] = in_idx;
+				}
+			}
+			for (uint32_t out = 0; out < natural_output_streams ().get (*t); ++out) {
+				bool valid;
+				uint32_t out_idx = _out_map[pc].get (*t, out, &valid);
+				if (valid) {
+					used_outputs.set (*t, out_idx, 1); // mark as used
+				}
+			}
+		}
+	}
+
+	if (inplace_split) {
+		assert (r->instances.size () == 1);
+		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+			if (_configured_internal.get (*t) == 0) {
+				continue;
+			}
+			/* check_inplace ensures that the first buffer is connected to the first pin */
+			for (uint32_t i = 1; i < natural_input_streams ().get (*t); ++i) {
+				bool valid;
+				_in_map[0].get (*t, i, &valid);
+				if (valid) {
+					r->split_copies[*t].push_back (i);
+				}
+			}
+		}
+		/* the copy operation produces a linear monotonic input map */
+		r->instances.front ().in_map = r->natural_in_map;
+	}
+
+	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		r->noinplace_out[*t].resize (n_out.get (*t), PinRouting::Silence);
+		r->inplace_out[*t].resize (n_out.get (*t), PinRouting::Silence);
+		for (uint32_t out = 0; out < n_out.get (*t); ++out) {
+			bool used;
+			bool thru;
+			used_outputs.get (*t, out, &used);
+			uint32_t in_idx = _thru_map.get (*t, out, &thru);
+			if (used) {
+				r->inplace_out[*t][out] = PinRouting::Plugin;
+			} else if (midi_bypass && *t == DataType::MIDI && out == 0) {
+				r->inplace_out[*t][out] = PinRouting::Untouched;
+			}
+			if (thru) {
+				r->noinplace_out[*t][out] = in_idx;
+			} else {
+				r->noinplace_out[*t][out] = r->inplace_out[*t][out];
+			}
+		}
+	}
+
+	/* bypass: the combined maps, without side-chain inputs */
+	const ChanMapping in_map (no_sc_input_map ());
+	const ChanMapping out_map (output_map ());
+
+	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		if (inplace_split && _configured_internal.get (*t) > 0) {
+			for (uint32_t i = 1; i < natural_input_streams ().get (*t); ++i) {
+				bool valid;
+				in_map.get (*t, i, &valid);
+				if (valid) {
+					r->bypass_split_copies[*t].push_back (i);
+				}
+			}
+		}
+
+		r->bypass_out[*t].resize (_configured_out.get (*t), PinRouting::Silence);
+		for (uint32_t out = 0; out < _configured_out.get (*t); ++out) {
+			int32_t& src (r->bypass_out[*t][out]);
+			bool valid;
+			uint32_t src_idx = out_map.get_src (*t, out, &valid);
+			uint32_t in_idx = valid ? in_map.get (*t, src_idx, &valid) : 0;
+			if (r->no_inplace) {
+				/* plugin no-op: assume every plugin has an internal identity map,
+				 * existing plugin outputs override thru */
+				bool thru;
+				uint32_t thru_idx = _thru_map.get (*t, out, &thru);
+				if (valid) {
+					src = in_idx;
+				} else if (thru) {
+					src = thru_idx;
+				} else if (midi_bypass && *t == DataType::MIDI && out == 0) {
+					src = PinRouting::Untouched;
+				}
+			} else if (valid) {
+				/* monotonic but not identity i/o mappings */
+				src = (in_idx != src_idx && in_idx != out) ? (int32_t) in_idx : (int32_t) PinRouting::Untouched;
+			}
+		}
+	}
+
+	_no_inplace = r->no_inplace;
+}
+
 bool
 PluginInsert::sanitize_maps ()
 {
@@ -1745,7 +1900,7 @@ PluginInsert::reset_map (bool emit)
 	}
 	if (emit) {
 		PluginMapChanged (); /* EMIT SIGNAL */
-		_mapping_changed = true;
+		update_routing ();
 		_session.set_dirty();
 	}
 	return true;
@@ -1937,8 +2092,7 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 #endif
 	}
 
-	_no_inplace = check_inplace ();
-	_mapping_changed = false;
+	update_routing ();
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
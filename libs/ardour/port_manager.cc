@@ -52,6 +52,7 @@ PortManager::PortManager ()
 	: ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _port_table (new PortTable)
 	, midi_info_dirty (true)
 {
 	load_midi_port_info ();
@@ -87,9 +88,12 @@ PortManager::remove_all_ports ()
 		ps->clear ();
 	}
 
+	update_port_table ();
+
 	/* clear dead wood list in RCU */
 
 	ports.flush ();
+	_port_table.flush ();
 
 	/* clear out pending port deletion list. we know this is safe because
 	 * the auto connect thread in Session is already dead when this is
@@ -306,15 +310,20 @@ PortManager::get_port_by_name (const string& portname)
 void
 PortManager::port_renamed (const std::string& old_relative_name, const std::string& new_relative_name)
 {
-	RCUWriter<Ports> writer (ports);
-	boost::shared_ptr<Ports> p = writer.get_copy();
-	Ports::iterator x = p->find (old_relative_name);
+	{
+		RCUWriter<Ports> writer (ports);
+		boost::shared_ptr<Ports> p = writer.get_copy();
+		Ports::iterator x = p->find (old_relative_name);
 
-	if (x != p->end()) {
-		boost::shared_ptr<Port> port = x->second;
-		p->erase (x);
-		p->insert (make_pair (new_relative_name, port));
+		if (x != p->end()) {
+			boost::shared_ptr<Port> port = x->second;
+			p->erase (x);
+			p->insert (make_pair (new_relative_name, port));
+		}
 	}
+
+	/* same ports, but do not keep the old map alive */
+	update_port_table ();
 }
 
 int
@@ -403,12 +412,15 @@ PortManager::register_port (DataType dtype, const string& portname, bool input,
 			throw PortRegistrationFailure("unable to create port (unknown type)");
 		}
 
-		RCUWriter<Ports> writer (ports);
-		boost::shared_ptr<Ports> ps = writer.get_copy ();
-		ps->insert (make_pair (make_port_name_relative (portname), newport));
+		{
+			RCUWriter<Ports> writer (ports);
+			boost::shared_ptr<Ports> ps = writer.get_copy ();
+			ps->insert (make_pair (make_port_name_relative (portname), newport));
 
-		/* writer goes out of scope, forces update */
+			/* writer goes out of scope, forces update */
+		}
 
+		update_port_table ();
 	}
 
 	catch (PortRegistrationFailure& err) {
@@ -460,7 +472,10 @@ PortManager::unregister_port (boost::shared_ptr<Port> port)
 		/* writer goes out of scope, forces update */
 	}
 
+	update_port_table ();
+
 	ports.flush ();
+	_port_table.flush ();
 
 	return 0;
 }
@@ -745,31 +760,72 @@ PortManager::graph_order_callback ()
 	return 0;
 }
 
+/** Rebuild the table of ports used for the per-cycle passes from the
+ *  current port map. Caller must hold the process lock.
+ */
+void
+PortManager::update_port_table ()
+{
+	RCUWriter<PortTable> writer (_port_table);
+	boost::shared_ptr<PortTable> t = writer.get_copy ();
+
+	t->ports = ports.reader ();
+	t->all.clear ();
+	t->audio_outputs.clear ();
+	t->midi_outputs.clear ();
+	t->all.reserve (t->ports->size ());
+
+	for (Ports::const_iterator p = t->ports->begin(); p != t->ports->end(); ++p) {
+		if (p->second->type() != DataType::AUDIO) {
+			continue;
+		}
+		t->all.push_back (p->second.get ());
+		if (p->second->sends_output()) {
+			t->audio_outputs.push_back (static_cast<AudioPort*> (p->second.get ()));
+		}
+	}
+
+	t->n_audio = t->all.size ();
+
+	for (Ports::const_iterator p = t->ports->begin(); p != t->ports->end(); ++p) {
+		if (p->second->type() == DataType::AUDIO) {
+			continue;
+		}
+		t->all.push_back (p->second.get ());
+		if (p->second->sends_output() && !boost::dynamic_pointer_cast<AsyncMIDIPort>(p->second)) {
+			t->midi_outputs.push_back (p->second.get ());
+		}
+	}
+}
+
 void
 PortManager::cycle_start (pframes_t nframes)
 {
 	Port::set_global_port_buffer_offset (0);
         Port::set_cycle_framecnt (nframes);
 
-	_cycle_ports = ports.reader ();
+	_cycle_port_table = _port_table.reader ();
 
-	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-		p->second->cycle_start (nframes);
+	std::vector<Port*> const & all (_cycle_port_table->all);
+	for (std::vector<Port*>::const_iterator p = all.begin(); p != all.end(); ++p) {
+		(*p)->cycle_start (nframes);
 	}
 }
 
 void
 PortManager::cycle_end (pframes_t nframes)
 {
-	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-		p->second->cycle_end (nframes);
+	std::vector<Port*> const & all (_cycle_port_table->all);
+
+	for (std::vector<Port*>::const_iterator p = all.begin(); p != all.end(); ++p) {
+		(*p)->cycle_end (nframes);
 	}
 
-	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-		p->second->flush_buffers (nframes);
+	for (std::vector<Port*>::const_iterator p = all.begin(); p != all.end(); ++p) {
+		(*p)->flush_buffers (nframes);
 	}
 
-	_cycle_ports.reset ();
+	_cycle_port_table.reset ();
 
 	/* we are done */
 }
@@ -777,22 +833,23 @@ PortManager::cycle_end (pframes_t nframes)
 void
 PortManager::silence (pframes_t nframes, Session *s)
 {
-	for (Ports::iterator i = _cycle_ports->begin(); i != _cycle_ports->end(); ++i) {
-		if (s && i->second == s->mtc_output_port ()) {
-			continue;
-		}
-		if (s && i->second == s->midi_clock_output_port ()) {
+	std::vector<AudioPort*> const & audio (_cycle_port_table->audio_outputs);
+	for (std::vector<AudioPort*>::const_iterator i = audio.begin(); i != audio.end(); ++i) {
+		if (s && *i == s->ltc_output_port ().get ()) {
 			continue;
 		}
-		if (s && i->second == s->ltc_output_port ()) {
+		(*i)->get_buffer(nframes).silence(nframes);
+	}
+
+	std::vector<Port*> const & midi (_cycle_port_table->midi_outputs);
+	for (std::vector<Port*>::const_iterator i = midi.begin(); i != midi.end(); ++i) {
+		if (s && *i == s->mtc_output_port ().get ()) {
 			continue;
 		}
-		if (boost::dynamic_pointer_cast<AsyncMIDIPort>(i->second)) {
+		if (s && *i == s->midi_clock_output_port ().get ()) {
 			continue;
 		}
-		if (i->second->sends_output()) {
-			i->second->get_buffer(nframes).silence(nframes);
-		}
+		(*i)->get_buffer(nframes).silence(nframes);
 	}
 }
 
@@ -838,16 +895,17 @@ PortManager::silence_outputs (pframes_t nframes)
 void
 PortManager::check_monitoring ()
 {
-	for (Ports::iterator i = _cycle_ports->begin(); i != _cycle_ports->end(); ++i) {
+	std::vector<Port*> const & all (_cycle_port_table->all);
+	for (std::vector<Port*>::const_iterator i = all.begin(); i != all.end(); ++i) {
 
 		bool x;
 
-		if (i->second->last_monitor() != (x = i->second->monitoring_input ())) {
-			i->second->set_last_monitor (x);
+		if ((*i)->last_monitor() != (x = (*i)->monitoring_input ())) {
+			(*i)->set_last_monitor (x);
 			/* XXX I think this is dangerous, due to
 			   a likely mutex in the signal handlers ...
 			*/
-			i->second->MonitorInputChanged (x); /* EMIT SIGNAL */
+			(*i)->MonitorInputChanged (x); /* EMIT SIGNAL */
 		}
 	}
 }
@@ -855,20 +913,15 @@ PortManager::check_monitoring ()
 void
 PortManager::fade_out (gain_t base_gain, gain_t gain_step, pframes_t nframes)
 {
-	for (Ports::iterator i = _cycle_ports->begin(); i != _cycle_ports->end(); ++i) {
-
-		if (i->second->sends_output()) {
+	std::vector<AudioPort*> const & audio (_cycle_port_table->audio_outputs);
+	for (std::vector<AudioPort*>::const_iterator i = audio.begin(); i != audio.end(); ++i) {
 
-			boost::shared_ptr<AudioPort> ap = boost::dynamic_pointer_cast<AudioPort> (i->second);
-			if (ap) {
-				Sample* s = ap->engine_get_whole_audio_buffer ();
-				gain_t g = base_gain;
+		Sample* s = (*i)->engine_get_whole_audio_buffer ();
+		gain_t g = base_gain;
 
-				for (pframes_t n = 0; n < nframes; ++n) {
-					*s++ *= g;
-					g -= gain_step;
-				}
-			}
+		for (pframes_t n = 0; n < nframes; ++n) {
+			*s++ *= g;
+			g -= gain_step;
 		}
 	}
 }
@@ -1434,6 +1434,10 @@ Region::send_change (const PropertyChange& what_changed)
 		return;
 	}
 
+	if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+		ExtentChanged (); /* EMIT SIGNAL */
+	}
+
 	Stateful::send_change (what_changed);
 
 	if (!Stateful::property_changes_suspended()) {
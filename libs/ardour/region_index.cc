@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/region.h"
+#include "ardour/region_index.h"
+
+using namespace ARDOUR;
+using namespace std;
+
+RegionIndex::Node::Node (boost::shared_ptr<Region> r, uint32_t p)
+	: region (r)
+	, first (r->first_frame ())
+	, last (r->last_frame ())
+	, max_last (last)
+	, priority (p)
+	, left (0)
+	, right (0)
+{
+}
+
+/** Recompute max_last from our own extent and our children */
+void
+RegionIndex::Node::fix ()
+{
+	max_last = last;
+	if (left) {
+		max_last = max (max_last, left->max_last);
+	}
+	if (right) {
+		max_last = max (max_last, right->max_last);
+	}
+}
+
+RegionIndex::RegionIndex ()
+	: _root (0)
+	, _seed (0x9e3779b9)
+{
+}
+
+RegionIndex::~RegionIndex ()
+{
+	destroy (_root);
+}
+
+void
+RegionIndex::destroy (Node* t)
+{
+	if (t) {
+		destroy (t->left);
+		destroy (t->right);
+		delete t;
+	}
+}
+
+uint32_t
+RegionIndex::next_priority ()
+{
+	/* xorshift32 */
+	_seed ^= _seed << 13;
+	_seed ^= _seed >> 17;
+	_seed ^= _seed << 5;
+	return _seed;
+}
+
+/** Split @param t into nodes before @param key (@param l) and the rest (@param r) */
+void
+RegionIndex::split (Node* t, Node const * key, Node*& l, Node*& r)
+{
+	if (!t) {
+		l = r = 0;
+		return;
+	}
+
+	if (t->before (key)) {
+		split (t->right, key, t->right, r);
+		l = t;
+	} else {
+		split (t->left, key, l, t->left);
+		r = t;
+	}
+
+	t->fix ();
+}
+
+/** Join @param l and @param r, all of whose nodes come after those in @param l */
+RegionIndex::Node*
+RegionIndex::merge (Node* l, Node* r)
+{
+	if (!l) {
+		return r;
+	}
+	if (!r) {
+		return l;
+	}
+
+	if (l->priority > r->priority) {
+		l->right = merge (l->right, r);
+		l->fix ();
+		return l;
+	}
+
+	r->left = merge (l, r->left);
+	r->fix ();
+	return r;
+}
+
+/** Unlink @param key from the subtree @param t.
+ *  @return the new root of the subtree.
+ */
+RegionIndex::Node*
+RegionIndex::erase (Node* t, Node const * key)
+{
+	if (!t) {
+		return 0;
+	}
+
+	if (t == key) {
+		return merge (t->left, t->right);
+	}
+
+	if (key->before (t)) {
+		t->left = erase (t->left, key);
+	} else {
+		t->right = erase (t->right, key);
+	}
+
+	t->fix ();
+	return t;
+}
+
+void
+RegionIndex::add_locked (boost::shared_ptr<Region> region)
+{
+	Node* n = new Node (region, next_priority ());
+	Node* l;
+	Node* r;
+
+	split (_root, n, l, r);
+	_root = merge (merge (l, n), r);
+	_nodes[region.get()] = n;
+}
+
+void
+RegionIndex::remove_locked (Region const * region)
+{
+	NodeMap::iterator i = _nodes.find (region);
+
+	if (i == _nodes.end()) {
+		return;
+	}
+
+	_root = erase (_root, i->second);
+	delete i->second;
+	_nodes.erase (i);
+}
+
+void
+RegionIndex::add (boost::shared_ptr<Region> region)
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	remove_locked (region.get());
+	add_locked (region);
+}
+
+void
+RegionIndex::remove (boost::shared_ptr<Region> region)
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	remove_locked (region.get());
+}
+
+/** Re-index @param region after its position or length changed,
+ *  if it is indexed at all.
+ */
+void
+RegionIndex::update (boost::shared_ptr<Region> region)
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	NodeMap::iterator i = _nodes.find (region.get());
+
+	if (i == _nodes.end()) {
+		return;
+	}
+
+	if (i->second->first == region->first_frame() && i->second->last == region->last_frame()) {
+		return;
+	}
+
+	remove_locked (region.get());
+	add_locked (region);
+}
+
+void
+RegionIndex::clear ()
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	destroy (_root);
+	_root = 0;
+	_nodes.clear ();
+}
+
+size_t
+RegionIndex::size () const
+{
+	Glib::Threads::RWLock::ReaderLock lm (_lock);
+	return _nodes.size ();
+}
+
+void
+RegionIndex::find (Node const * t, framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >& result)
+{
+	while (t && t->max_last >= start) {
+
+		find (t->left, start, end, result);
+
+		if (t->first > end) {
+			/* everything to the right starts later still */
+			return;
+		}
+
+		if (t->last >= start) {
+			result.push_back (t->region);
+		}
+
+		t = t->right;
+	}
+}
+
+void
+RegionIndex::find (framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >& result) const
+{
+	Glib::Threads::RWLock::ReaderLock lm (_lock);
+	find (_root, start, end, result);
+}
@@ -18,6 +18,15 @@
 
 */
 
+#include <boost/bind.hpp>
+
+#include "pbd/compose.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/debug.h"
+#include "ardour/internal_send.h"
+#include "ardour/io.h"
+#include "ardour/plugin_insert.h"
 #include "ardour/route.h"
 #include "ardour/route_graph.h"
 #include "ardour/track.h"
@@ -288,3 +297,288 @@ ARDOUR::topological_sort (
 
 	return sorted_routes;
 }
+
+RouteFeeds::RouteFeeds ()
+	: _all_dirty (true)
+{
+}
+
+/** Note that the feeds of @param r must be recomputed, e.g. because its processors changed */
+void
+RouteFeeds::invalidate (GraphVertex r)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_dirty_routes.insert (r);
+}
+
+/** Note that the port called @param name (relative or not) has been
+ *  connected or disconnected, so the feeds of the route that owns it, if any,
+ *  must be recomputed.
+ */
+void
+RouteFeeds::invalidate_port (string const & name)
+{
+	string const relative = AudioEngine::instance()->make_port_name_relative (name);
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_dirty_ports.insert (relative);
+}
+
+void
+RouteFeeds::invalidate_all ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_all_dirty = true;
+}
+
+/** Drop all feeds, and with them our references to the routes */
+void
+RouteFeeds::clear ()
+{
+	_feeds.clear ();
+	_port_owners.clear ();
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_dirty_routes.clear ();
+	_dirty_ports.clear ();
+	_all_dirty = true;
+}
+
+/** @return the routes that @param r fed when update() was last called */
+RouteFeeds::Feeds const &
+RouteFeeds::feeds (GraphVertex r) const
+{
+	static Feeds const none;
+	FeedMap::const_iterator i = _feeds.find (r);
+	if (i == _feeds.end ()) {
+		return none;
+	}
+	return i->second;
+}
+
+void
+RouteFeeds::add_ports (boost::shared_ptr<const IO> io, GraphVertex r)
+{
+	if (!io) {
+		return;
+	}
+	for (PortSet::const_iterator p = io->ports().begin(); p != io->ports().end(); ++p) {
+		_port_owners[p->name ()] = r;
+	}
+}
+
+/** Add the routes which own ports that @param io is connected to to @param routes;
+ *  this works for inputs as well as outputs.
+ */
+void
+RouteFeeds::connected_routes (boost::shared_ptr<const IO> io, set<GraphVertex>& routes) const
+{
+	if (!io) {
+		return;
+	}
+
+	vector<string> connections;
+
+	for (PortSet::const_iterator p = io->ports().begin(); p != io->ports().end(); ++p) {
+		connections.clear ();
+		p->get_connections (connections);
+		for (vector<string>::const_iterator c = connections.begin(); c != connections.end(); ++c) {
+			PortOwners::const_iterator o = _port_owners.find (AudioEngine::instance()->make_port_name_relative (*c));
+			if (o != _port_owners.end ()) {
+				routes.insert (o->second);
+			}
+		}
+	}
+}
+
+/** Add the routes that processor @param wp of route @param r feeds to @param feeds,
+ *  in the same way as Route::direct_feeds_according_to_reality().
+ */
+void
+RouteFeeds::add_processor_feeds (boost::weak_ptr<Processor> wp, GraphVertex r, boost::shared_ptr<RouteList> routes, set<GraphVertex>* feeds) const
+{
+	boost::shared_ptr<Processor> p (wp.lock ());
+	boost::shared_ptr<IOProcessor> iop = boost::dynamic_pointer_cast<IOProcessor> (p);
+	boost::shared_ptr<PluginInsert> pi = boost::dynamic_pointer_cast<PluginInsert> (p);
+	if (pi) {
+		assert (!iop);
+		iop = pi->sidechain ();
+	}
+
+	if (!iop) {
+		return;
+	}
+
+	boost::shared_ptr<const IO> iop_out = iop->output ();
+	set<GraphVertex> fed;
+
+	/* IOProcessor::feeds() is a test of the output's connections, which
+	 * we have covered, so only internal sends need to be asked.
+	 */
+	connected_routes (iop_out, fed);
+
+	if (boost::dynamic_pointer_cast<InternalSend> (iop)) {
+		for (RouteList::const_iterator i = routes->begin(); i != routes->end(); ++i) {
+			if (iop->feeds (*i)) {
+				fed.insert (*i);
+			}
+		}
+	}
+
+	if (fed.find (r) != fed.end () && iop_out && iop->input() && iop_out->connected_to (iop->input())) {
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("\tIOP %1 does feed its own return (%2)\n", iop->name(), r->name()));
+		fed.erase (r);
+	}
+
+	feeds->insert (fed.begin (), fed.end ());
+}
+
+/** Find the routes that @param r directly feeds, in order of route */
+void
+RouteFeeds::find_feeds (GraphVertex r, boost::shared_ptr<RouteList> routes, Feeds& feeds) const
+{
+	feeds.clear ();
+
+	if (!AudioEngine::instance()->port_engine().available ()) {
+		/* Port::connected_to() would say that nothing is connected */
+		return;
+	}
+
+	set<GraphVertex> direct;
+	set<GraphVertex> via_sends;
+
+	connected_routes (r->output (), direct);
+	r->foreach_processor (boost::bind (&RouteFeeds::add_processor_feeds, this, _1, r, routes, &via_sends));
+
+	set<GraphVertex>::const_iterator d = direct.begin ();
+	set<GraphVertex>::const_iterator s = via_sends.begin ();
+
+	while (d != direct.end () || s != via_sends.end ()) {
+		if (s == via_sends.end () || (d != direct.end () && *d < *s)) {
+			feeds.push_back (make_pair (*d++, false));
+		} else if (d == direct.end () || *s < *d) {
+			feeds.push_back (make_pair (*s++, true));
+		} else {
+			/* fed directly as well as via a send */
+			feeds.push_back (make_pair (*d++, false));
+			++s;
+		}
+	}
+}
+
+/** Recompute the feeds of the routes in @param routes that have been
+ *  invalidated, and forget about any routes that are no longer there.
+ *  @return true if the graph may have changed since the last update,
+ *  false if it is known to be the same.
+ */
+bool
+RouteFeeds::update (boost::shared_ptr<RouteList> routes)
+{
+	set<GraphVertex> dirty_routes;
+	set<string> dirty_ports;
+	bool all_dirty;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		dirty_routes.swap (_dirty_routes);
+		dirty_ports.swap (_dirty_ports);
+		all_dirty = _all_dirty;
+		_all_dirty = false;
+	}
+
+	bool changed = all_dirty;
+
+	if (all_dirty) {
+		_feeds.clear ();
+	}
+
+	/* Port names change when routes are renamed, and ports come and go
+	 * with their IOs and processors, so look at them afresh each time;
+	 * this only involves our own port objects, not the backend.
+	 */
+	_port_owners.clear ();
+
+	for (RouteList::const_iterator i = routes->begin(); i != routes->end(); ++i) {
+		IOVector const inputs ((*i)->all_inputs ());
+		for (IOVector::const_iterator io = inputs.begin(); io != inputs.end(); ++io) {
+			add_ports (io->lock (), *i);
+		}
+		IOVector const outputs ((*i)->all_outputs ());
+		for (IOVector::const_iterator io = outputs.begin(); io != outputs.end(); ++io) {
+			add_ports (io->lock (), *i);
+		}
+	}
+
+	for (set<string>::const_iterator p = dirty_ports.begin(); p != dirty_ports.end(); ++p) {
+		PortOwners::const_iterator o = _port_owners.find (*p);
+		if (o != _port_owners.end ()) {
+			dirty_routes.insert (o->second);
+		}
+	}
+
+	set<GraphVertex> const present (routes->begin (), routes->end ());
+
+	/* forget routes that have gone, and any feeds to them */
+
+	for (FeedMap::iterator i = _feeds.begin(); i != _feeds.end(); ) {
+		if (present.find (i->first) == present.end ()) {
+			_feeds.erase (i++);
+			changed = true;
+			continue;
+		}
+		for (Feeds::iterator f = i->second.begin(); f != i->second.end(); ) {
+			if (present.find (f->first) == present.end ()) {
+				f = i->second.erase (f);
+				changed = true;
+			} else {
+				++f;
+			}
+		}
+		++i;
+	}
+
+	/* new routes must be looked at, as must any routes that feed them
+	 * (whose connections may have been made before the new routes were
+	 * there for us to find).
+	 */
+
+	for (RouteList::const_iterator i = routes->begin(); i != routes->end(); ++i) {
+		if (_feeds.find (*i) != _feeds.end ()) {
+			continue;
+		}
+		dirty_routes.insert (*i);
+		if (all_dirty) {
+			continue;
+		}
+		IOVector const inputs ((*i)->all_inputs ());
+		for (IOVector::const_iterator io = inputs.begin(); io != inputs.end(); ++io) {
+			connected_routes (io->lock (), dirty_routes);
+		}
+	}
+
+	uint32_t n = 0;
+	Feeds feeds;
+
+	for (RouteList::const_iterator i = routes->begin(); i != routes->end(); ++i) {
+
+		if (dirty_routes.find (*i) == dirty_routes.end ()) {
+			continue;
+		}
+
+		FeedMap::iterator f = _feeds.find (*i);
+
+		find_feeds (*i, routes, feeds);
+		++n;
+
+		if (f == _feeds.end ()) {
+			_feeds.insert (make_pair (*i, feeds));
+			changed = true;
+		} else if (f->second != feeds) {
+			f->second.swap (feeds);
+			changed = true;
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::Graph, string_compose ("Recomputed feeds of %1 of %2 routes, graph %3\n", n, routes->size(), changed ? "changed" : "unchanged"));
+
+	return changed;
+}
@@ -571,6 +571,10 @@ Session::immediately_post_engine ()
 
 	_engine.Running.connect_same_thread (*this, boost::bind (&Session::initialize_latencies, this));
 
+	/* ... and look at all the connections afresh when we next resort */
+
+	_engine.Running.connect_same_thread (*this, boost::bind (&RouteFeeds::invalidate_all, &_route_feeds));
+
 	if (synced_to_engine()) {
 		_engine.transport_stop ();
 	}
@@ -648,6 +652,8 @@ Session::destroy ()
 	/* clear history so that no references to objects are held any more */
 
 	_history.clear ();
+	_history.set_spill ("", UndoHistory::TransactionRestorer (), UndoHistory::TransactionChecker ());
+	remove_directory (_history_spill_dir);
 
 	/* clear state tree so that no references to objects are held any more */
 
@@ -738,6 +744,7 @@ Session::destroy ()
 		/* writer goes out of scope and updates master */
 	}
 	routes.flush ();
+	_route_feeds.clear ();
 
 	{
 		DEBUG_TRACE (DEBUG::Destruction, "delete sources\n");
@@ -2324,6 +2331,18 @@ Session::resort_routes ()
 void
 Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 {
+	/* Find out which routes now feed which others.  Only the feeds of
+	   routes whose connections or sends have changed since we last did
+	   this are recomputed; if none of them changed, neither has the
+	   graph, so the current order (or the feedback we found in it)
+	   stands.
+	*/
+
+	if (!_route_feeds.update (r)) {
+		DEBUG_TRACE (DEBUG::Graph, "Route graph unchanged, not resorting\n");
+		return;
+	}
+
 	/* We are going to build a directed graph of our routes;
 	   this is where the edges of that graph are put.
 	*/
@@ -2342,23 +2361,19 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 	 */
 
 	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
-
 		/* Clear out the route's list of direct or indirect feeds */
 		(*i)->clear_fed_by ();
+	}
 
-		for (RouteList::iterator j = r->begin(); j != r->end(); ++j) {
+	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
 
-			bool via_sends_only;
+		RouteFeeds::Feeds const & feeds (_route_feeds.feeds (*i));
 
-			/* See if this *j feeds *i according to the current state of the JACK
-			   connections and internal sends.
-			*/
-			if ((*j)->direct_feeds_according_to_reality (*i, &via_sends_only)) {
-				/* add the edge to the graph (part #1) */
-				edges.add (*j, *i, via_sends_only);
-				/* tell the route (for part #2) */
-				(*i)->add_fed_by (*j, via_sends_only);
-			}
+		for (RouteFeeds::Feeds::const_iterator f = feeds.begin(); f != feeds.end(); ++f) {
+			/* add the edge to the graph (part #1) */
+			edges.add (*i, f->first, f->second);
+			/* tell the route (for part #2) */
+			f->first->add_fed_by (*i, f->second);
 		}
 	}
 
@@ -3532,7 +3547,7 @@ Session::add_routes_inner (RouteList& new_routes, bool input_auto_connect, bool
 			r->mute_control()->Changed.connect_same_thread (*this, boost::bind (&Session::route_mute_changed, this));
 
 			r->output()->changed.connect_same_thread (*this, boost::bind (&Session::set_worst_io_latencies_x, this, _1, _2));
-			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1));
+			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1, wpr));
 			r->processor_latency_changed.connect_same_thread (*this, boost::bind (&Session::queue_latency_recompute, this));
 
 			if (r->is_master()) {
@@ -5556,6 +5571,14 @@ Session::is_auditioning () const
 	}
 }
 
+void
+Session::port_connected_or_disconnected (string const & a, string const & b)
+{
+	/* the routes that own these ports (if any) may now feed something else */
+	_route_feeds.invalidate_port (a);
+	_route_feeds.invalidate_port (b);
+}
+
 void
 Session::graph_reordered ()
 {
@@ -7177,7 +7200,7 @@ Session::auto_connect_thread_run ()
 		if (!_auto_connect_queue.empty ()) {
 			// Why would we need the process lock ??
 			// A: if ports are added while we're connecting, the backend's iterator may be invalidated:
-			//   graph_order_callback() -> resort_routes() -> direct_feeds_according_to_reality () -> backend::connected_to()
+			//   graph_order_callback() -> resort_routes() -> RouteFeeds::update () -> backend::get_connections()
 			//   All ardour-internal backends use a std::vector   xxxAudioBackend::find_port()
 			//   We have control over those, but what does jack do?
 			Glib::Threads::Mutex::Lock lm (AudioEngine::instance()->process_lock ());
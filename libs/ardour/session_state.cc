@@ -191,6 +191,15 @@ Session::pre_engine_init (string fullpath)
 	last_rr_session_dir = session_dirs.begin();
 
 	set_history_depth (Config->get_history_depth());
+	set_history_memory_limit (Config->get_history_memory_limit());
+
+	/* transactions beyond the memory limit wait in a temporary directory
+	   until undo reaches them.
+	*/
+	_history_spill_dir = tmp_writable_directory (PROGRAM_NAME, "undo-");
+	_history.set_spill (_history_spill_dir,
+	                    boost::bind (&Session::undo_transaction_from_state, this, _1),
+	                    boost::bind (&Session::can_restore_undo_transaction, this, _1));
 
         /* default: assume simple stereo speaker configuration */
 
@@ -272,6 +281,7 @@ Session::post_engine_init ()
 
 		SndFileSource::setup_standard_crossfades (*this, frame_rate());
 		_engine.GraphReordered.connect_same_thread (*this, boost::bind (&Session::graph_reordered, this));
+		_engine.PortConnectedOrDisconnected.connect_same_thread (*this, boost::bind (&Session::port_connected_or_disconnected, this, _2, _4));
 		_engine.MidiSelectionPortsChanged.connect_same_thread (*this, boost::bind (&Session::rewire_midi_selection_ports, this));
 
 		AudioDiskstream::allocate_working_buffers();
@@ -3858,77 +3868,137 @@ Session::restore_history (string snapshot_name)
 	_history.clear();
 
 	for (XMLNodeConstIterator it  = tree.root()->children().begin(); it != tree.root()->children().end(); ++it) {
+		_history.add (undo_transaction_from_state (**it));
+	}
 
-		XMLNode *t = *it;
-		UndoTransaction* ut = new UndoTransaction ();
-		struct timeval tv;
-
-		ut->set_name(t->property("name")->value());
-		stringstream ss(t->property("tv-sec")->value());
-		ss >> tv.tv_sec;
-		ss.str(t->property("tv-usec")->value());
-		ss >> tv.tv_usec;
-		ut->set_timestamp(tv);
-
-		for (XMLNodeConstIterator child_it  = t->children().begin();
-				child_it != t->children().end(); child_it++)
-		{
-			XMLNode *n = *child_it;
-			Command *c;
+	return 0;
+}
 
-			if (n->name() == "MementoCommand" ||
-					n->name() == "MementoUndoCommand" ||
-					n->name() == "MementoRedoCommand") {
+UndoTransaction*
+Session::undo_transaction_from_state (XMLNode const & t)
+{
+	UndoTransaction* ut = new UndoTransaction ();
+	struct timeval tv;
+
+	ut->set_name(t.property("name")->value());
+	stringstream ss(t.property("tv-sec")->value());
+	ss >> tv.tv_sec;
+	ss.str(t.property("tv-usec")->value());
+	ss >> tv.tv_usec;
+	ut->set_timestamp(tv);
+
+	for (XMLNodeConstIterator child_it  = t.children().begin();
+			child_it != t.children().end(); child_it++)
+	{
+		XMLNode *n = *child_it;
+		Command *c;
 
-				if ((c = memento_command_factory(n))) {
-					ut->add_command(c);
-				}
+		if (n->name() == "MementoCommand" ||
+				n->name() == "MementoUndoCommand" ||
+				n->name() == "MementoRedoCommand") {
 
-			} else if (n->name() == "NoteDiffCommand") {
-				PBD::ID id (n->property("midi-source")->value());
-				boost::shared_ptr<MidiSource> midi_source =
-					boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
-				if (midi_source) {
-					ut->add_command (new MidiModel::NoteDiffCommand(midi_source->model(), *n));
-				} else {
-					error << _("Failed to downcast MidiSource for NoteDiffCommand") << endmsg;
-				}
+			if ((c = memento_command_factory(n))) {
+				ut->add_command(c);
+			}
 
-			} else if (n->name() == "SysExDiffCommand") {
+		} else if (n->name() == "NoteDiffCommand") {
+			PBD::ID id (n->property("midi-source")->value());
+			boost::shared_ptr<MidiSource> midi_source =
+				boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
+			if (midi_source) {
+				ut->add_command (new MidiModel::NoteDiffCommand(midi_source->model(), *n));
+			} else {
+				error << _("Failed to downcast MidiSource for NoteDiffCommand") << endmsg;
+			}
 
-				PBD::ID id (n->property("midi-source")->value());
-				boost::shared_ptr<MidiSource> midi_source =
-					boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
-				if (midi_source) {
-					ut->add_command (new MidiModel::SysExDiffCommand (midi_source->model(), *n));
-				} else {
-					error << _("Failed to downcast MidiSource for SysExDiffCommand") << endmsg;
-				}
+		} else if (n->name() == "SysExDiffCommand") {
 
-			} else if (n->name() == "PatchChangeDiffCommand") {
+			PBD::ID id (n->property("midi-source")->value());
+			boost::shared_ptr<MidiSource> midi_source =
+				boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
+			if (midi_source) {
+				ut->add_command (new MidiModel::SysExDiffCommand (midi_source->model(), *n));
+			} else {
+				error << _("Failed to downcast MidiSource for SysExDiffCommand") << endmsg;
+			}
 
-				PBD::ID id (n->property("midi-source")->value());
-				boost::shared_ptr<MidiSource> midi_source =
-					boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
-				if (midi_source) {
-					ut->add_command (new MidiModel::PatchChangeDiffCommand (midi_source->model(), *n));
-				} else {
-					error << _("Failed to downcast MidiSource for PatchChangeDiffCommand") << endmsg;
-				}
+		} else if (n->name() == "PatchChangeDiffCommand") {
 
-			} else if (n->name() == "StatefulDiffCommand") {
-				if ((c = stateful_diff_command_factory (n))) {
-					ut->add_command (c);
-				}
+			PBD::ID id (n->property("midi-source")->value());
+			boost::shared_ptr<MidiSource> midi_source =
+				boost::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
+			if (midi_source) {
+				ut->add_command (new MidiModel::PatchChangeDiffCommand (midi_source->model(), *n));
 			} else {
-				error << string_compose(_("Couldn't figure out how to make a Command out of a %1 XMLNode."), n->name()) << endmsg;
+				error << _("Failed to downcast MidiSource for PatchChangeDiffCommand") << endmsg;
+			}
+
+		} else if (n->name() == "StatefulDiffCommand") {
+			if ((c = stateful_diff_command_factory (n))) {
+				ut->add_command (c);
 			}
+		} else {
+			error << string_compose(_("Couldn't figure out how to make a Command out of a %1 XMLNode."), n->name()) << endmsg;
 		}
+	}
+
+	return ut;
+}
+
+/** @return true if undo_transaction_from_state() can rebuild every command
+ *  of the transaction in @a t while the session is running.
+ */
+bool
+Session::can_restore_undo_transaction (XMLNode const & t) const
+{
+	for (XMLNodeConstIterator i = t.children().begin(); i != t.children().end(); ++i) {
+
+		XMLNode const * n = *i;
+		XMLProperty const * type = n->property ("type-name");
+
+		if (n->name() == "MementoCommand" ||
+		    n->name() == "MementoUndoCommand" ||
+		    n->name() == "MementoRedoCommand") {
+
+			/* playlists are found by a name which may have changed
+			   since, and objects from the registry (editor, video
+			   timeline etc.) may not be there any more.
+			*/
+			if (!type ||
+			    (type->value() != "ARDOUR::AudioRegion" &&
+			     type->value() != "ARDOUR::MidiRegion" &&
+			     type->value() != "ARDOUR::Region" &&
+			     type->value() != "ARDOUR::AudioSource" &&
+			     type->value() != "ARDOUR::MidiSource" &&
+			     type->value() != "ARDOUR::Location" &&
+			     type->value() != "ARDOUR::Locations" &&
+			     type->value() != "ARDOUR::TempoMap" &&
+			     type->value() != "ARDOUR::Route" &&
+			     type->value() != "ARDOUR::AudioTrack" &&
+			     type->value() != "ARDOUR::MidiTrack" &&
+			     type->value() != "Evoral::Curve" &&
+			     type->value() != "ARDOUR::AutomationList")) {
+				return false;
+			}
+
+		} else if (n->name() == "StatefulDiffCommand") {
+
+			if (!type ||
+			    (type->value() != "ARDOUR::AudioRegion" &&
+			     type->value() != "ARDOUR::MidiRegion" &&
+			     type->value() != "ARDOUR::AudioPlaylist" &&
+			     type->value() != "ARDOUR::MidiPlaylist")) {
+				return false;
+			}
 
-		_history.add (ut);
+		} else if (n->name() != "NoteDiffCommand" &&
+		           n->name() != "SysExDiffCommand" &&
+		           n->name() != "PatchChangeDiffCommand") {
+			return false;
+		}
 	}
 
-	return 0;
+	return true;
 }
 
 void
@@ -4100,6 +4170,8 @@ Session::config_changed (std::string p, bool ours)
 		setup_fpu ();
 	} else if (p == "history-depth") {
 		set_history_depth (Config->get_history_depth());
+	} else if (p == "history-memory-limit") {
+		set_history_memory_limit (Config->get_history_memory_limit());
 	} else if (p == "remote-model") {
 		/* XXX DO SOMETHING HERE TO TELL THE GUI THAT WE NEED
 		   TO SET REMOTE ID'S
@@ -4134,6 +4206,12 @@ Session::config_changed (std::string p, bool ours)
 		ltc_tx_parse_offset();
 	} else if (p == "auto-return-target-list") {
 		follow_playhead_priority ();
+	} else if (p == "use-work-stealing-scheduler" || p == "graph-critical-path-scheduling" || p == "graph-split-sends") {
+		/* the process graph picks up the scheduler when it is rechained,
+		   which only happens if the graph looks different.
+		*/
+		_route_feeds.invalidate_all ();
+		resort_routes ();
 	}
 
 	set_dirty ();
@@ -4145,6 +4223,12 @@ Session::set_history_depth (uint32_t d)
 	_history.set_depth (d);
 }
 
+void
+Session::set_history_memory_limit (uint32_t megabytes)
+{
+	_history.set_memory_limit ((size_t) megabytes * 1048576);
+}
+
 int
 Session::load_diskstreams_2X (XMLNode const & node, int)
 {
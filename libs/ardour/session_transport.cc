@@ -2105,7 +2105,7 @@ Session::xrun_recovery ()
 }
 
 void
-Session::route_processors_changed (RouteProcessorChange c)
+Session::route_processors_changed (RouteProcessorChange c, boost::weak_ptr<Route> wr)
 {
 	if (g_atomic_int_get (&_ignore_route_processor_changes) > 0) {
 		return;
@@ -2121,6 +2121,16 @@ Session::route_processors_changed (RouteProcessorChange c)
 		return;
 	}
 
+	/* only the route whose processors changed can feed anything
+	   different now; without a route (ProcessorChangeBlocker) any might.
+	*/
+	boost::shared_ptr<Route> r = wr.lock ();
+	if (r) {
+		_route_feeds.invalidate (r);
+	} else {
+		_route_feeds.invalidate_all ();
+	}
+
 	update_latency_compensation ();
 	resort_routes ();
 
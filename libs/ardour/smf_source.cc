@@ -243,17 +243,8 @@ SMFSource::read_unlocked (const Lock&                    lock,
 
 	if (_smf_last_read_end == 0 || start != _smf_last_read_end) {
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: seek to %1\n", start));
-		Evoral::SMF::seek_to_start();
-		while (time < start_ticks) {
-			gint ignored;
-
-			ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
-			if (ret == -1) { // EOF
-				_smf_last_read_end = start + duration;
-				return duration;
-			}
-			time += ev_delta_t; // accumulate delta time
-		}
+		/* time of the event before the first one at or after start */
+		time = Evoral::SMF::seek_to_tick (start_ticks);
 	} else {
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: set time to %1\n", _smf_last_read_time));
 		time = _smf_last_read_time;
@@ -298,6 +289,8 @@ SMFSource::read_unlocked (const Lock&                    lock,
 				}
 			}
 		} else {
+			/* leave the event for the next (contiguous) read */
+			_smf_last_read_time = Evoral::SMF::seek_to_tick (time);
 			break;
 		}
 
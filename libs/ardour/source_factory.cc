@@ -24,6 +24,7 @@
 
 #include "pbd/error.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/stacktrace.h"
 
@@ -102,11 +103,37 @@ SourceFactory::peak_work_queue_length ()
 void
 SourceFactory::init ()
 {
-	for (int n = 0; n < 2; ++n) {
+	/* Building peaks is mostly disk-bound; beyond a handful of threads
+	   they would only compete for the disk(s).
+	 */
+	uint32_t const n_threads = std::max (2U, std::min (hardware_concurrency (), 8U));
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
 		Glib::Threads::Thread::create (sigc::ptr_fun (::peak_thread_work));
 	}
 }
 
+void
+SourceFactory::prioritize_peak_building (boost::shared_ptr<Source> s)
+{
+	boost::shared_ptr<AudioSource> as (boost::dynamic_pointer_cast<AudioSource> (s));
+
+	if (!as) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+
+	for (std::list<boost::weak_ptr<AudioSource> >::iterator i = files_with_peaks.begin(); i != files_with_peaks.end(); ++i) {
+		if (i->lock() == as) {
+			if (i != files_with_peaks.begin()) {
+				files_with_peaks.splice (files_with_peaks.begin(), files_with_peaks, i);
+			}
+			break;
+		}
+	}
+}
+
 int
 SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 {
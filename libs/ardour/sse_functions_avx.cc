@@ -117,3 +117,155 @@ x86_sse_avx_find_peaks(const float* buf, uint32_t nframes, float *min, float *ma
 }
 
 
+
+void
+x86_sse_avx_apply_gain_curve_to_buffer (float* buf, uint32_t nframes, const float* gain)
+{
+	while (nframes >= 8) {
+		_mm256_storeu_ps (buf, _mm256_mul_ps (_mm256_loadu_ps (buf), _mm256_loadu_ps (gain)));
+		buf += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_sse_avx_mix_buffers_with_gain_curve (float* dst, const float* src, uint32_t nframes, const float* gain)
+{
+	while (nframes >= 8) {
+		__m256 const s = _mm256_mul_ps (_mm256_loadu_ps (src), _mm256_loadu_ps (gain));
+		_mm256_storeu_ps (dst, _mm256_add_ps (_mm256_loadu_ps (dst), s));
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+
+	_mm256_zeroupper ();
+}
+
+/* Meter ballistics for 8 channels, one channel per lane (see
+ * default_kmeter_process() and friends). Each step loads 4 samples of each
+ * channel and transposes them, so that s[j] holds sample j of all channels.
+ */
+
+static inline void
+load_transposed (const float* const* bufs, uint32_t i, __m256* s)
+{
+	__m128 lo[4];
+	__m128 hi[4];
+
+	for (int c = 0; c < 4; ++c) {
+		lo[c] = _mm_loadu_ps (bufs[c] + i);
+		hi[c] = _mm_loadu_ps (bufs[c + 4] + i);
+	}
+
+	_MM_TRANSPOSE4_PS (lo[0], lo[1], lo[2], lo[3]);
+	_MM_TRANSPOSE4_PS (hi[0], hi[1], hi[2], hi[3]);
+
+	for (int j = 0; j < 4; ++j) {
+		s[j] = _mm256_insertf128_ps (_mm256_castps128_ps256 (lo[j]), hi[j], 1);
+	}
+}
+
+static inline __m256
+abs_ps (__m256 v)
+{
+	return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), v);
+}
+
+void
+x86_sse_avx_kmeter_process (const float* const* bufs, uint32_t nframes, float* z1p, float* z2p, float omega)
+{
+	__m256 const w  = _mm256_set1_ps (omega);
+	__m256 const w4 = _mm256_set1_ps (4 * omega);
+	__m256 z1 = _mm256_loadu_ps (z1p);
+	__m256 z2 = _mm256_loadu_ps (z2p);
+	__m256 s[4];
+
+	for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+		load_transposed (bufs, i, s);
+		for (int j = 0; j < 4; ++j) {
+			__m256 const sq = _mm256_mul_ps (s[j], s[j]);
+			z1 = _mm256_add_ps (z1, _mm256_mul_ps (w, _mm256_sub_ps (sq, z1)));
+		}
+		z2 = _mm256_add_ps (z2, _mm256_mul_ps (w4, _mm256_sub_ps (z1, z2)));
+	}
+
+	_mm256_storeu_ps (z1p, z1);
+	_mm256_storeu_ps (z2p, z2);
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_sse_avx_ppm_process (const float* const* bufs, uint32_t nframes, float* z1p, float* z2p, float* mp, float w1, float w2, float w3)
+{
+	__m256 const vw1 = _mm256_set1_ps (w1);
+	__m256 const vw2 = _mm256_set1_ps (w2);
+	__m256 const vw3 = _mm256_set1_ps (w3);
+	__m256 z1 = _mm256_loadu_ps (z1p);
+	__m256 z2 = _mm256_loadu_ps (z2p);
+	__m256 m  = _mm256_loadu_ps (mp);
+	__m256 s[4];
+
+	for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+		load_transposed (bufs, i, s);
+		z1 = _mm256_mul_ps (z1, vw3);
+		z2 = _mm256_mul_ps (z2, vw3);
+		for (int j = 0; j < 4; ++j) {
+			__m256 const t = abs_ps (s[j]);
+			/* attack only in the lanes where the signal is above the filter state */
+			z1 = _mm256_add_ps (z1, _mm256_and_ps (_mm256_cmp_ps (t, z1, _CMP_GT_OQ), _mm256_mul_ps (vw1, _mm256_sub_ps (t, z1))));
+			z2 = _mm256_add_ps (z2, _mm256_and_ps (_mm256_cmp_ps (t, z2, _CMP_GT_OQ), _mm256_mul_ps (vw2, _mm256_sub_ps (t, z2))));
+		}
+		m = _mm256_max_ps (_mm256_add_ps (z1, z2), m);
+	}
+
+	_mm256_storeu_ps (z1p, z1);
+	_mm256_storeu_ps (z2p, z2);
+	_mm256_storeu_ps (mp, m);
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_sse_avx_vumeter_process (const float* const* bufs, uint32_t nframes, float* z1p, float* z2p, float* mp, float w)
+{
+	__m256 const vw   = _mm256_set1_ps (w);
+	__m256 const vw4  = _mm256_set1_ps (4 * w);
+	__m256 const half = _mm256_set1_ps (0.5f);
+	__m256 z1 = _mm256_loadu_ps (z1p);
+	__m256 z2 = _mm256_loadu_ps (z2p);
+	__m256 m  = _mm256_loadu_ps (mp);
+	__m256 s[4];
+
+	for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+		load_transposed (bufs, i, s);
+		__m256 const t2 = _mm256_mul_ps (z2, half);
+		for (int j = 0; j < 4; ++j) {
+			__m256 const t1 = _mm256_sub_ps (abs_ps (s[j]), t2);
+			z1 = _mm256_add_ps (z1, _mm256_mul_ps (vw, _mm256_sub_ps (t1, z1)));
+		}
+		z2 = _mm256_add_ps (z2, _mm256_mul_ps (vw4, _mm256_sub_ps (z1, z2)));
+		m = _mm256_max_ps (z2, m);
+	}
+
+	_mm256_storeu_ps (z1p, z1);
+	_mm256_storeu_ps (z2p, z2);
+	_mm256_storeu_ps (mp, m);
+
+	_mm256_zeroupper ();
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <immintrin.h>
+
+#include "ardour/mix.h"
+
+/* AVX-512F versions of the mix routines. Buffers need not be aligned;
+ * the last (nframes % 16) samples are handled with masked loads and
+ * stores rather than a scalar loop.
+ *
+ * This file must be compiled without FP contraction: a fused multiply-add
+ * rounds differently from a multiply followed by an add, and the results
+ * must match those of the default routines to the bit.
+ */
+
+static inline __mmask16
+tail_mask (uint32_t n)
+{
+	return (__mmask16) ((1U << n) - 1);
+}
+
+static inline __m512
+abs_ps (__m512 v)
+{
+	return _mm512_castsi512_ps (_mm512_and_si512 (_mm512_castps_si512 (v), _mm512_set1_epi32 (0x7fffffff)));
+}
+
+float
+x86_avx512f_compute_peak (const float * buf, uint32_t nsamples, float current)
+{
+	__m512 vmax = _mm512_set1_ps (current);
+
+	while (nsamples >= 16) {
+		vmax = _mm512_max_ps (vmax, abs_ps (_mm512_loadu_ps (buf)));
+		buf += 16;
+		nsamples -= 16;
+	}
+
+	if (nsamples > 0) {
+		/* lanes past the end keep the current maximum */
+		vmax = _mm512_max_ps (vmax, abs_ps (_mm512_mask_loadu_ps (vmax, tail_mask (nsamples), buf)));
+	}
+
+	float tmp[16];
+	_mm512_storeu_ps (tmp, vmax);
+	_mm256_zeroupper ();
+
+	for (int i = 0; i < 16; ++i) {
+		current = std::max (current, tmp[i]);
+	}
+
+	return current;
+}
+
+void
+x86_avx512f_find_peaks (const float * buf, uint32_t nframes, float *min, float *max)
+{
+	__m512 vmin = _mm512_set1_ps (*min);
+	__m512 vmax = _mm512_set1_ps (*max);
+
+	while (nframes >= 16) {
+		__m512 const work = _mm512_loadu_ps (buf);
+		vmin = _mm512_min_ps (vmin, work);
+		vmax = _mm512_max_ps (vmax, work);
+		buf += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		__mmask16 const m = tail_mask (nframes);
+		vmin = _mm512_min_ps (vmin, _mm512_mask_loadu_ps (vmin, m, buf));
+		vmax = _mm512_max_ps (vmax, _mm512_mask_loadu_ps (vmax, m, buf));
+	}
+
+	float tmin[16];
+	float tmax[16];
+	_mm512_storeu_ps (tmin, vmin);
+	_mm512_storeu_ps (tmax, vmax);
+	_mm256_zeroupper ();
+
+	for (int i = 0; i < 16; ++i) {
+		*min = std::min (*min, tmin[i]);
+		*max = std::max (*max, tmax[i]);
+	}
+}
+
+void
+x86_avx512f_apply_gain_to_buffer (float * buf, uint32_t nframes, float gain)
+{
+	__m512 const g = _mm512_set1_ps (gain);
+
+	while (nframes >= 16) {
+		_mm512_storeu_ps (buf, _mm512_mul_ps (_mm512_loadu_ps (buf), g));
+		buf += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		__mmask16 const m = tail_mask (nframes);
+		_mm512_mask_storeu_ps (buf, m, _mm512_mul_ps (_mm512_maskz_loadu_ps (m, buf), g));
+	}
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_avx512f_mix_buffers_with_gain (float * dst, const float * src, uint32_t nframes, float gain)
+{
+	__m512 const g = _mm512_set1_ps (gain);
+
+	while (nframes >= 16) {
+		__m512 const s = _mm512_mul_ps (_mm512_loadu_ps (src), g);
+		_mm512_storeu_ps (dst, _mm512_add_ps (_mm512_loadu_ps (dst), s));
+		dst += 16;
+		src += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		__mmask16 const m = tail_mask (nframes);
+		__m512 const s = _mm512_mul_ps (_mm512_maskz_loadu_ps (m, src), g);
+		_mm512_mask_storeu_ps (dst, m, _mm512_add_ps (_mm512_maskz_loadu_ps (m, dst), s));
+	}
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_avx512f_mix_buffers_no_gain (float * dst, const float * src, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		_mm512_storeu_ps (dst, _mm512_add_ps (_mm512_loadu_ps (dst), _mm512_loadu_ps (src)));
+		dst += 16;
+		src += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		__mmask16 const m = tail_mask (nframes);
+		_mm512_mask_storeu_ps (dst, m, _mm512_add_ps (_mm512_maskz_loadu_ps (m, dst), _mm512_maskz_loadu_ps (m, src)));
+	}
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_avx512f_apply_gain_curve_to_buffer (float * buf, uint32_t nframes, const float * gain)
+{
+	while (nframes >= 16) {
+		_mm512_storeu_ps (buf, _mm512_mul_ps (_mm512_loadu_ps (buf), _mm512_loadu_ps (gain)));
+		buf += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		__mmask16 const m = tail_mask (nframes);
+		_mm512_mask_storeu_ps (buf, m, _mm512_mul_ps (_mm512_maskz_loadu_ps (m, buf), _mm512_maskz_loadu_ps (m, gain)));
+	}
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_avx512f_mix_buffers_with_gain_curve (float * dst, const float * src, uint32_t nframes, const float * gain)
+{
+	while (nframes >= 16) {
+		__m512 const s = _mm512_mul_ps (_mm512_loadu_ps (src), _mm512_loadu_ps (gain));
+		_mm512_storeu_ps (dst, _mm512_add_ps (_mm512_loadu_ps (dst), s));
+		dst += 16;
+		src += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		__mmask16 const m = tail_mask (nframes);
+		__m512 const s = _mm512_mul_ps (_mm512_maskz_loadu_ps (m, src), _mm512_maskz_loadu_ps (m, gain));
+		_mm512_mask_storeu_ps (dst, m, _mm512_add_ps (_mm512_maskz_loadu_ps (m, dst), s));
+	}
+
+	_mm256_zeroupper ();
+}
@@ -17,29 +17,88 @@
 
 */
 
+#include <algorithm>
+#include <cmath>
+
+#include <immintrin.h>
+
 #include "ardour/mix.h"
 
+/* AVX versions of the routines that are written in assembler for Windows
+ * (see sse_avx_functions_64bit_win.s).  Buffers need not be aligned.
+ */
+
 float
 x86_sse_avx_compute_peak (const float * buf, uint32_t nsamples, float current)
 {
-	return default_compute_peak (buf, nsamples, current);
+	__m256 const abs_mask = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7fffffff));
+	__m256 vmax = _mm256_set1_ps (current);
+
+	while (nsamples >= 8) {
+		vmax = _mm256_max_ps (vmax, _mm256_and_ps (_mm256_loadu_ps (buf), abs_mask));
+		buf += 8;
+		nsamples -= 8;
+	}
+
+	float tmp[8];
+	_mm256_storeu_ps (tmp, vmax);
+	_mm256_zeroupper ();
+
+	for (int i = 0; i < 8; ++i) {
+		current = std::max (current, tmp[i]);
+	}
+
+	while (nsamples > 0) {
+		current = std::max (current, fabsf (*buf++));
+		--nsamples;
+	}
+
+	return current;
 }
 
 void
 x86_sse_avx_apply_gain_to_buffer (float * buf, uint32_t nframes, float gain)
 {
+	__m256 const g = _mm256_set1_ps (gain);
+
+	while (nframes >= 8) {
+		_mm256_storeu_ps (buf, _mm256_mul_ps (_mm256_loadu_ps (buf), g));
+		buf += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
 	default_apply_gain_to_buffer (buf, nframes, gain);
 }
 
 void
 x86_sse_avx_mix_buffers_with_gain (float * dst, const float * src, uint32_t nframes, float gain)
 {
+	__m256 const g = _mm256_set1_ps (gain);
+
+	while (nframes >= 8) {
+		__m256 const s = _mm256_mul_ps (_mm256_loadu_ps (src), g);
+		_mm256_storeu_ps (dst, _mm256_add_ps (_mm256_loadu_ps (dst), s));
+		dst += 8;
+		src += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
 	default_mix_buffers_with_gain (dst, src, nframes, gain);
 }
 
 void
 x86_sse_avx_mix_buffers_no_gain (float * dst, const float * src, uint32_t nframes)
 {
+	while (nframes >= 8) {
+		_mm256_storeu_ps (dst, _mm256_add_ps (_mm256_loadu_ps (dst), _mm256_loadu_ps (src)));
+		dst += 8;
+		src += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
 	default_mix_buffers_no_gain (dst, src, nframes);
 }
 
@@ -48,9 +107,3 @@ x86_sse_avx_copy_vector (float * dst, const float * src, uint32_t nframes)
 {
 	default_copy_vector (dst, src, nframes);
 }
-
-void
-x86_sse_avx_find_peaks (const float * buf, uint32_t nsamples, float *min, float *max)
-{
-	default_find_peaks (buf, nsamples, min, max);
-}
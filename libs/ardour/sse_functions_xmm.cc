@@ -115,5 +115,135 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 	_mm_store_ss(max, work);
 }
 
+void
+x86_sse_apply_gain_curve_to_buffer (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, const ARDOUR::gain_t* gain)
+{
+	while (nframes >= 4) {
+		_mm_storeu_ps (buf, _mm_mul_ps (_mm_loadu_ps (buf), _mm_loadu_ps (gain)));
+		buf += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
+
+void
+x86_sse_mix_buffers_with_gain_curve (ARDOUR::Sample* dst, const ARDOUR::Sample* src, ARDOUR::pframes_t nframes, const ARDOUR::gain_t* gain)
+{
+	while (nframes >= 4) {
+		__m128 const s = _mm_mul_ps (_mm_loadu_ps (src), _mm_loadu_ps (gain));
+		_mm_storeu_ps (dst, _mm_add_ps (_mm_loadu_ps (dst), s));
+		dst += 4;
+		src += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+}
+
+/* Meter ballistics for 4 channels, one channel per lane (see
+ * default_kmeter_process() and friends). Each step loads 4 samples of each
+ * channel and transposes them, so that s[j] holds sample j of all channels.
+ */
+
+static inline void
+load_transposed (const ARDOUR::Sample* const* bufs, ARDOUR::pframes_t i, __m128* s)
+{
+	s[0] = _mm_loadu_ps (bufs[0] + i);
+	s[1] = _mm_loadu_ps (bufs[1] + i);
+	s[2] = _mm_loadu_ps (bufs[2] + i);
+	s[3] = _mm_loadu_ps (bufs[3] + i);
+	_MM_TRANSPOSE4_PS (s[0], s[1], s[2], s[3]);
+}
 
+static inline __m128
+abs_ps (__m128 v)
+{
+	return _mm_andnot_ps (_mm_set1_ps (-0.0f), v);
+}
+
+void
+x86_sse_kmeter_process (const ARDOUR::Sample* const* bufs, ARDOUR::pframes_t nframes, float* z1p, float* z2p, float omega)
+{
+	__m128 const w  = _mm_set1_ps (omega);
+	__m128 const w4 = _mm_set1_ps (4 * omega);
+	__m128 z1 = _mm_loadu_ps (z1p);
+	__m128 z2 = _mm_loadu_ps (z2p);
+	__m128 s[4];
+
+	for (ARDOUR::pframes_t i = 0; i + 4 <= nframes; i += 4) {
+		load_transposed (bufs, i, s);
+		for (int j = 0; j < 4; ++j) {
+			__m128 const sq = _mm_mul_ps (s[j], s[j]);
+			z1 = _mm_add_ps (z1, _mm_mul_ps (w, _mm_sub_ps (sq, z1)));
+		}
+		z2 = _mm_add_ps (z2, _mm_mul_ps (w4, _mm_sub_ps (z1, z2)));
+	}
+
+	_mm_storeu_ps (z1p, z1);
+	_mm_storeu_ps (z2p, z2);
+}
 
+void
+x86_sse_ppm_process (const ARDOUR::Sample* const* bufs, ARDOUR::pframes_t nframes, float* z1p, float* z2p, float* mp, float w1, float w2, float w3)
+{
+	__m128 const vw1 = _mm_set1_ps (w1);
+	__m128 const vw2 = _mm_set1_ps (w2);
+	__m128 const vw3 = _mm_set1_ps (w3);
+	__m128 z1 = _mm_loadu_ps (z1p);
+	__m128 z2 = _mm_loadu_ps (z2p);
+	__m128 m  = _mm_loadu_ps (mp);
+	__m128 s[4];
+
+	for (ARDOUR::pframes_t i = 0; i + 4 <= nframes; i += 4) {
+		load_transposed (bufs, i, s);
+		z1 = _mm_mul_ps (z1, vw3);
+		z2 = _mm_mul_ps (z2, vw3);
+		for (int j = 0; j < 4; ++j) {
+			__m128 const t = abs_ps (s[j]);
+			/* attack only in the lanes where the signal is above the filter state */
+			z1 = _mm_add_ps (z1, _mm_and_ps (_mm_cmpgt_ps (t, z1), _mm_mul_ps (vw1, _mm_sub_ps (t, z1))));
+			z2 = _mm_add_ps (z2, _mm_and_ps (_mm_cmpgt_ps (t, z2), _mm_mul_ps (vw2, _mm_sub_ps (t, z2))));
+		}
+		m = _mm_max_ps (_mm_add_ps (z1, z2), m);
+	}
+
+	_mm_storeu_ps (z1p, z1);
+	_mm_storeu_ps (z2p, z2);
+	_mm_storeu_ps (mp, m);
+}
+
+void
+x86_sse_vumeter_process (const ARDOUR::Sample* const* bufs, ARDOUR::pframes_t nframes, float* z1p, float* z2p, float* mp, float w)
+{
+	__m128 const vw   = _mm_set1_ps (w);
+	__m128 const vw4  = _mm_set1_ps (4 * w);
+	__m128 const half = _mm_set1_ps (0.5f);
+	__m128 z1 = _mm_loadu_ps (z1p);
+	__m128 z2 = _mm_loadu_ps (z2p);
+	__m128 m  = _mm_loadu_ps (mp);
+	__m128 s[4];
+
+	for (ARDOUR::pframes_t i = 0; i + 4 <= nframes; i += 4) {
+		load_transposed (bufs, i, s);
+		__m128 const t2 = _mm_mul_ps (z2, half);
+		for (int j = 0; j < 4; ++j) {
+			__m128 const t1 = _mm_sub_ps (abs_ps (s[j]), t2);
+			z1 = _mm_add_ps (z1, _mm_mul_ps (vw, _mm_sub_ps (t1, z1)));
+		}
+		z2 = _mm_add_ps (z2, _mm_mul_ps (vw4, _mm_sub_ps (z1, z2)));
+		m = _mm_max_ps (z2, m);
+	}
+
+	_mm_storeu_ps (z1p, z1);
+	_mm_storeu_ps (z2p, z2);
+	_mm_storeu_ps (mp, m);
+}
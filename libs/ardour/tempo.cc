@@ -765,6 +765,7 @@ struct MetricSectionFrameSorter {
 };
 
 TempoMap::TempoMap (framecnt_t fr)
+	: _index (new SectionIndex)
 {
 	_frame_rate = fr;
 	BBT_Time start (1, 1, 0);
@@ -782,6 +783,7 @@ TempoMap::TempoMap (framecnt_t fr)
 	_metrics.push_back (t);
 	_metrics.push_back (m);
 
+	publish_index ();
 }
 
 TempoMap&
@@ -811,6 +813,8 @@ TempoMap::operator= (TempoMap const & other)
 				_metrics.push_back (new_section);
 			}
 		}
+
+		publish_index ();
 	}
 
 	PropertyChanged (PropertyChange());
@@ -1277,6 +1281,9 @@ TempoMap::add_meter_locked (const Meter& meter, double beat, const BBT_Time& whe
 			if (!solved) {
 				solved = solve_map_minute (_metrics, new_meter, minute_at_frame (prev_m.frame() + 1));
 			}
+			if (solved) {
+				publish_index ();
+			}
 		} else {
 			solved = solve_map_bbt (_metrics, new_meter, where);
 			/* required due to resetting the pulse of meter-locked tempi above.
@@ -1571,6 +1578,171 @@ TempoMap::recompute_meters (Metrics& metrics)
 	}
 }
 
+/** Copy the active tempo sections and the meter sections of _metrics
+ *  into a new SectionIndex and make it the one used by lookups. This is
+ *  done once by every top-level change to _metrics, at the end of
+ *  recompute_map() or where they recompute only part of the map.
+ *  Caller must hold the write lock (or be the constructor).
+ */
+void
+TempoMap::publish_index ()
+{
+	boost::shared_ptr<SectionIndex> idx (_index.write_new ());
+
+	for (Metrics::const_iterator i = _metrics.begin(); i != _metrics.end(); ++i) {
+		if ((*i)->is_tempo()) {
+			TempoSection const * t = static_cast<TempoSection const *> (*i);
+			if (!t->active()) {
+				continue;
+			}
+			idx->tempos.push_back (boost::shared_ptr<const TempoSection> (new TempoSection (*t)));
+			idx->tempo_minutes.push_back (t->minute());
+			idx->tempo_pulses.push_back (t->pulse());
+			idx->tempo_frames.push_back (t->frame());
+		} else {
+			MeterSection const * m = static_cast<MeterSection const *> (*i);
+			idx->meters.push_back (boost::shared_ptr<const MeterSection> (new MeterSection (*m)));
+			idx->meter_minutes.push_back (m->minute());
+			idx->meter_pulses.push_back (m->pulse());
+			idx->meter_beats.push_back (m->beat());
+		}
+	}
+
+	_index.update (idx);
+}
+
+/** @return the index of the last of @param keys that is not greater than @param key,
+ *  or 0 if there is none. This is the section the list-walking *_locked() methods
+ *  settle on: the first one, or the last one that does not start after @param key.
+ */
+template<typename T>
+static size_t
+index_at_or_before (std::vector<T> const & keys, T const & key)
+{
+	if (keys.size() < 2) {
+		return 0;
+	}
+	return (upper_bound (keys.begin() + 1, keys.end(), key) - keys.begin()) - 1;
+}
+
+/* tempo section based, see pulse_at_minute_locked() */
+double
+TempoMap::pulse_at_minute_indexed (const SectionIndex& idx, const double& minute) const
+{
+	size_t const n = index_at_or_before (idx.tempo_minutes, minute);
+	const TempoSection& prev_t (*idx.tempos[n]);
+
+	if (n + 1 < idx.tempos.size()) {
+		const double ret = prev_t.pulse_at_minute (minute);
+		/* audio locked section in new meter*/
+		if (idx.tempo_pulses[n + 1] < ret) {
+			return idx.tempo_pulses[n + 1];
+		}
+		return ret;
+	}
+
+	/* treated as constant for this ts */
+	const double pulses_in_section = ((minute - prev_t.minute()) * prev_t.note_types_per_minute()) / prev_t.note_type();
+
+	return pulses_in_section + prev_t.pulse();
+}
+
+/* tempo section based, see minute_at_pulse_locked() */
+double
+TempoMap::minute_at_pulse_indexed (const SectionIndex& idx, const double& pulse) const
+{
+	size_t const n = index_at_or_before (idx.tempo_pulses, pulse);
+	const TempoSection& prev_t (*idx.tempos[n]);
+
+	if (n + 1 < idx.tempos.size()) {
+		return prev_t.minute_at_pulse (pulse);
+	}
+
+	/* must be treated as constant, irrespective of _type */
+	double const dtime = ((pulse - prev_t.pulse()) * prev_t.note_type()) / prev_t.note_types_per_minute();
+
+	return dtime + prev_t.minute();
+}
+
+/* meter & tempo section based, see beat_at_minute_locked() */
+double
+TempoMap::beat_at_minute_indexed (const SectionIndex& idx, const double& minute) const
+{
+	const TempoSection& ts (*idx.tempos[index_at_or_before (idx.tempo_minutes, minute)]);
+	size_t const m = index_at_or_before (idx.meter_minutes, minute);
+	const MeterSection& prev_m (*idx.meters[m]);
+
+	const double beat = prev_m.beat() + (ts.pulse_at_minute (minute) - prev_m.pulse()) * prev_m.note_divisor();
+
+	/* audio locked meters fake their beat */
+	if (m + 1 < idx.meters.size() && idx.meter_beats[m + 1] < beat) {
+		return idx.meter_beats[m + 1];
+	}
+
+	return beat;
+}
+
+/** Compares a beat with the beat of a tempo section's pulse in a given meter */
+struct BeatBeforeTempoPulse {
+	BeatBeforeTempoPulse (const MeterSection& m) : meter (m) {}
+
+	bool operator() (const double& beat, const double& tempo_pulse) const {
+		return ((tempo_pulse - meter.pulse()) * meter.note_divisor()) + meter.beat() > beat;
+	}
+
+	const MeterSection& meter;
+};
+
+/* meter & tempo section based, see minute_at_beat_locked() */
+double
+TempoMap::minute_at_beat_indexed (const SectionIndex& idx, const double& beat) const
+{
+	const MeterSection& prev_m (*idx.meters[index_at_or_before (idx.meter_beats, beat)]);
+	size_t n = 0;
+
+	if (idx.tempo_pulses.size() > 1) {
+		n = (upper_bound (idx.tempo_pulses.begin() + 1, idx.tempo_pulses.end(), beat, BeatBeforeTempoPulse (prev_m)) - idx.tempo_pulses.begin()) - 1;
+	}
+
+	return idx.tempos[n]->minute_at_pulse (((beat - prev_m.beat()) / prev_m.note_divisor()) + prev_m.pulse());
+}
+
+/* meter section based, see pulse_at_beat_locked() */
+double
+TempoMap::pulse_at_beat_indexed (const SectionIndex& idx, const double& beat) const
+{
+	const MeterSection& prev_m (*idx.meters[index_at_or_before (idx.meter_beats, beat)]);
+
+	return prev_m.pulse() + ((beat - prev_m.beat()) / prev_m.note_divisor());
+}
+
+/* meter section based, see beat_at_pulse_locked() */
+double
+TempoMap::beat_at_pulse_indexed (const SectionIndex& idx, const double& pulse) const
+{
+	const MeterSection& prev_m (*idx.meters[index_at_or_before (idx.meter_pulses, pulse)]);
+
+	return ((pulse - prev_m.pulse()) * prev_m.note_divisor()) + prev_m.beat();
+}
+
+/* tempo section based, see quarter_notes_between_frames_locked() */
+double
+TempoMap::quarter_notes_between_frames_indexed (const SectionIndex& idx, const framecnt_t start, const framecnt_t end) const
+{
+	size_t const s = index_at_or_before (idx.tempo_frames, (framepos_t) start);
+	size_t e = index_at_or_before (idx.tempo_frames, (framepos_t) end);
+
+	if (e == 0 && idx.tempo_frames[0] > end) {
+		/* the list walk keeps the start section in this case */
+		e = s;
+	}
+
+	const double start_qn = idx.tempos[s]->pulse_at_frame (start);
+	const double end_qn = idx.tempos[e]->pulse_at_frame (end);
+
+	return (end_qn - start_qn) * 4.0;
+}
+
 void
 TempoMap::recompute_map (Metrics& metrics, framepos_t end)
 {
@@ -1586,6 +1758,10 @@ TempoMap::recompute_map (Metrics& metrics, framepos_t end)
 
 	recompute_tempi (metrics);
 	recompute_meters (metrics);
+
+	if (&metrics == &_metrics) {
+		publish_index ();
+	}
 }
 
 TempoMetric
@@ -1664,9 +1840,9 @@ TempoMap::metric_at (BBT_Time bbt) const
 double
 TempoMap::beat_at_frame (const framecnt_t& frame) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return beat_at_minute_locked (_metrics, minute_at_frame (frame));
+	return beat_at_minute_indexed (*idx, minute_at_frame (frame));
 }
 
 /* This function uses both tempo and meter.*/
@@ -1706,9 +1882,9 @@ TempoMap::beat_at_minute_locked (const Metrics& metrics, const double& minute) c
 framepos_t
 TempoMap::frame_at_beat (const double& beat) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return frame_at_minute (minute_at_beat_locked (_metrics, beat));
+	return frame_at_minute (minute_at_beat_indexed (*idx, beat));
 }
 
 /* meter & tempo section based */
@@ -2445,23 +2621,16 @@ TempoMap::quarter_note_at_frame (const framepos_t frame) const
 {
 	const double minute =  minute_at_frame (frame);
 
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return pulse_at_minute_locked (_metrics, minute) * 4.0;
+	return pulse_at_minute_indexed (*idx, minute) * 4.0;
 }
 
 double
 TempoMap::quarter_note_at_frame_rt (const framepos_t frame) const
 {
-	const double minute =  minute_at_frame (frame);
-
-	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
-
-	if (!lm.locked()) {
-		throw std::logic_error ("TempoMap::quarter_note_at_frame_rt() could not lock tempo map");
-	}
-
-	return pulse_at_minute_locked (_metrics, minute) * 4.0;
+	/* the index is never locked, so this can no longer fail */
+	return quarter_note_at_frame (frame);
 }
 
 /**
@@ -2475,14 +2644,9 @@ TempoMap::quarter_note_at_frame_rt (const framepos_t frame) const
 framepos_t
 TempoMap::frame_at_quarter_note (const double quarter_note) const
 {
-	double minute;
-	{
-		Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-		minute = minute_at_pulse_locked (_metrics, quarter_note / 4.0);
-	}
-
-	return frame_at_minute (minute);
+	return frame_at_minute (minute_at_pulse_indexed (*idx, quarter_note / 4.0));
 }
 
 /** Returns the quarter-note beats corresponding to the supplied BBT (meter-based) beat.
@@ -2495,9 +2659,9 @@ TempoMap::frame_at_quarter_note (const double quarter_note) const
 double
 TempoMap::quarter_note_at_beat (const double beat) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return pulse_at_beat_locked (_metrics, beat) * 4.0;
+	return pulse_at_beat_indexed (*idx, beat) * 4.0;
 }
 
 /** Returns the BBT (meter-based) beat position corresponding to the supplied quarter-note beats.
@@ -2510,9 +2674,9 @@ TempoMap::quarter_note_at_beat (const double beat) const
 double
 TempoMap::beat_at_quarter_note (const double quarter_note) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return beat_at_pulse_locked (_metrics, quarter_note / 4.0);
+	return beat_at_pulse_indexed (*idx, quarter_note / 4.0);
 }
 
 /** Returns the duration in frames between two supplied quarter-note beat positions.
@@ -2528,14 +2692,9 @@ TempoMap::beat_at_quarter_note (const double quarter_note) const
 framecnt_t
 TempoMap::frames_between_quarter_notes (const double start, const double end) const
 {
-	double minutes;
-
-	{
-		Glib::Threads::RWLock::ReaderLock lm (lock);
-		minutes = minutes_between_quarter_notes_locked (_metrics, start, end);
-	}
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return frame_at_minute (minutes);
+	return frame_at_minute (minute_at_pulse_indexed (*idx, end / 4.0) - minute_at_pulse_indexed (*idx, start / 4.0));
 }
 
 double
@@ -2548,9 +2707,9 @@ TempoMap::minutes_between_quarter_notes_locked (const Metrics& metrics, const do
 double
 TempoMap::quarter_notes_between_frames (const framecnt_t start, const framecnt_t end) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return quarter_notes_between_frames_locked (_metrics, start, end);
+	return quarter_notes_between_frames_indexed (*idx, start, end);
 }
 
 double
@@ -3282,6 +3441,7 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const framepos_t& frame, con
 				if (solve_map_pulse (future_map, tempo_copy, pulse)) {
 					solve_map_pulse (_metrics, ts, pulse);
 					recompute_meters (_metrics);
+					publish_index ();
 				}
 			}
 		}
@@ -3309,10 +3469,12 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const framepos_t& frame, con
 						solve_map_minute (_metrics, ts, minute_at_frame (snapped_frame));
 						ts->set_pulse (qn / 4.0);
 						recompute_meters (_metrics);
+						publish_index ();
 					}
 				} else {
 					solve_map_minute (_metrics, ts, minute_at_frame (frame));
 					recompute_meters (_metrics);
+					publish_index ();
 				}
 			}
 		}
@@ -3349,6 +3511,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const framepos_t& frame)
 			if (solve_map_minute (future_map, copy, minute_at_frame (frame))) {
 				solve_map_minute (_metrics, ms, minute_at_frame (frame));
 				recompute_tempi (_metrics);
+				publish_index ();
 			}
 		}
 	} else {
@@ -3362,6 +3525,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const framepos_t& frame)
 			if (solve_map_bbt (future_map, copy, bbt)) {
 				solve_map_bbt (_metrics, ms, bbt);
 				recompute_tempi (_metrics);
+				publish_index ();
 			}
 		}
 	}
@@ -3533,8 +3697,7 @@ TempoMap::gui_stretch_tempo (TempoSection* ts, const framepos_t frame, const fra
 					prev->set_end_note_types_per_minute (ts->note_types_per_minute());
 				}
 			}
-			recompute_tempi (_metrics);
-			recompute_meters (_metrics);
+			recompute_map (_metrics);
 		}
 	}
 
@@ -3614,8 +3777,7 @@ TempoMap::gui_stretch_tempo_end (TempoSection* ts, const framepos_t frame, const
 				}
 			}
 
-			recompute_tempi (_metrics);
-			recompute_meters (_metrics);
+			recompute_map (_metrics);
 		}
 	}
 
@@ -4904,10 +5066,10 @@ TempoMap::remove_time (framepos_t where, framecnt_t amount)
 framepos_t
 TempoMap::framepos_plus_qn (framepos_t frame, Evoral::Beats beats) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-	const double frame_qn = pulse_at_minute_locked (_metrics, minute_at_frame (frame)) * 4.0;
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
+	const double frame_qn = pulse_at_minute_indexed (*idx, minute_at_frame (frame)) * 4.0;
 
-	return frame_at_minute (minute_at_pulse_locked (_metrics, (frame_qn + beats.to_double()) / 4.0));
+	return frame_at_minute (minute_at_pulse_indexed (*idx, (frame_qn + beats.to_double()) / 4.0));
 }
 
 framepos_t
@@ -4940,9 +5102,9 @@ TempoMap::framepos_plus_bbt (framepos_t pos, BBT_Time op) const
 Evoral::Beats
 TempoMap::framewalk_to_qn (framepos_t pos, framecnt_t distance) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<SectionIndex> idx (_index.reader ());
 
-	return Evoral::Beats (quarter_notes_between_frames_locked (_metrics, pos, pos + distance));
+	return Evoral::Beats (quarter_notes_between_frames_indexed (*idx, pos, pos + distance));
 }
 
 struct bbtcmp {
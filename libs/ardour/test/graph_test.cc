@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <glibmm/threads.h>
+#include <glibmm/timer.h>
+
+#include "ardour/audioengine.h"
+#include "ardour/io.h"
+#include "ardour/processor.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+
+#include "graph_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (GraphTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** Logs each run, with the engine cycle that it was in, while recording */
+class RunRecorder : public Processor
+{
+public:
+	RunRecorder (Session& s, int id) : Processor (s, "RunRecorder"), _id (id) {}
+
+	bool can_support_io_configuration (const ChanCount& in, ChanCount& out) {
+		out = in;
+		return true;
+	}
+
+	void run (BufferSet&, framepos_t, framepos_t, double, pframes_t, bool) {
+		Glib::Threads::Mutex::Lock lm (lock);
+		if (recording) {
+			runs.push_back (make_pair (AudioEngine::instance()->processed_frames (), _id));
+		}
+	}
+
+	static Glib::Threads::Mutex lock;
+	static bool recording;
+	/** (cycle, id) of each run, in the order they happened */
+	static vector<pair<framecnt_t, int> > runs;
+
+private:
+	int _id;
+};
+
+Glib::Threads::Mutex RunRecorder::lock;
+bool RunRecorder::recording = false;
+vector<pair<framecnt_t, int> > RunRecorder::runs;
+
+/** Wait until the engine has run at least @param n more cycles */
+static void
+wait_cycles (int n)
+{
+	framecnt_t last = AudioEngine::instance()->processed_frames ();
+	gint64 const give_up = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+
+	while (n > 0) {
+		CPPUNIT_ASSERT (g_get_monotonic_time () < give_up);
+		Glib::usleep (1000);
+		framecnt_t const now = AudioEngine::instance()->processed_frames ();
+		if (now != last) {
+			last = now;
+			--n;
+		}
+	}
+}
+
+static const int n_sources = 6;
+static const int n_sinks = 2;
+
+/** Source i feeds sink (i % n_sinks); recorder ids are the source indices,
+ *  then n_sources + the sink indices.
+ */
+static int
+sink_of (int source)
+{
+	return n_sources + source % n_sinks;
+}
+
+/** Select a scheduler (which rechains the graph), let the engine run with
+ *  it and check each complete cycle that was logged: every route ran
+ *  exactly once, and no sink ran before the sources that feed it.
+ */
+static void
+check_cycles (bool work_stealing)
+{
+	Config->set_use_work_stealing_scheduler (work_stealing);
+
+	/* let the process thread swap to the new chain */
+	wait_cycles (4);
+
+	{
+		Glib::Threads::Mutex::Lock lm (RunRecorder::lock);
+		RunRecorder::runs.clear ();
+		RunRecorder::recording = true;
+	}
+
+	wait_cycles (8);
+
+	vector<pair<framecnt_t, int> > runs;
+	{
+		Glib::Threads::Mutex::Lock lm (RunRecorder::lock);
+		RunRecorder::recording = false;
+		runs.swap (RunRecorder::runs);
+	}
+
+	map<framecnt_t, vector<int> > cycles;
+	for (vector<pair<framecnt_t, int> >::const_iterator i = runs.begin(); i != runs.end(); ++i) {
+		cycles[i->first].push_back (i->second);
+	}
+
+	/* recording started and stopped part way through a cycle */
+	CPPUNIT_ASSERT (cycles.size () > 2);
+	cycles.erase (cycles.begin ());
+	cycles.erase (--cycles.end ());
+
+	for (map<framecnt_t, vector<int> >::const_iterator c = cycles.begin(); c != cycles.end(); ++c) {
+		vector<int> const & order = c->second;
+		CPPUNIT_ASSERT_EQUAL ((size_t) (n_sources + n_sinks), order.size ());
+
+		vector<int> sorted (order);
+		sort (sorted.begin (), sorted.end ());
+		for (int n = 0; n < n_sources + n_sinks; ++n) {
+			CPPUNIT_ASSERT_EQUAL (n, sorted[n]);
+		}
+
+		for (int s = 0; s < n_sources; ++s) {
+			vector<int>::const_iterator const source = find (order.begin (), order.end (), s);
+			vector<int>::const_iterator const sink = find (order.begin (), order.end (), sink_of (s));
+			CPPUNIT_ASSERT (source < sink);
+		}
+	}
+}
+
+/** With either scheduler, and after switching between them, every route is
+ *  processed once per cycle and after all of the routes that feed it.
+ */
+void
+GraphTest::schedulerSwitchTest ()
+{
+	RouteList sources = _session->new_audio_route (1, 1, 0, n_sources, "Source", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	RouteList sinks = _session->new_audio_route (1, 1, 0, n_sinks, "Sink", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_sources, sources.size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) n_sinks, sinks.size ());
+
+	vector<boost::shared_ptr<Route> > routes (sources.begin (), sources.end ());
+	routes.insert (routes.end (), sinks.begin (), sinks.end ());
+
+	for (int s = 0; s < n_sources; ++s) {
+		boost::shared_ptr<IO> out = routes[s]->output ();
+		boost::shared_ptr<IO> in = routes[sink_of (s)]->input ();
+		CPPUNIT_ASSERT (out->connect (out->nth (0), in->nth (0)->name (), this) == 0);
+	}
+
+	for (size_t r = 0; r < routes.size (); ++r) {
+		boost::shared_ptr<Processor> p (new RunRecorder (*_session, r));
+		CPPUNIT_ASSERT (routes[r]->add_processor (p, PreFader) == 0);
+		p->activate ();
+	}
+
+	check_cycles (false);
+	check_cycles (true);
+	check_cycles (false);
+	check_cycles (true);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <cmath>
+#include <unistd.h>
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/gstdio_compat.h"
+
+#include "ardour/audiosource.h"
+#include "ardour/source_factory.h"
+
+#include "peakfile_levels_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PeakfileLevelsTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* enough for two levels above the 256 frames-per-peak one */
+static framecnt_t const source_length = 65536 * 4;
+
+void
+PeakfileLevelsTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	_build_peakfiles = AudioSource::get_build_peakfiles ();
+	AudioSource::set_build_peakfiles (true);
+
+	std::string const path = Glib::build_filename (new_test_output_dir (), "levels.wav");
+	_source = boost::dynamic_pointer_cast<AudioSource> (
+		SourceFactory::createWritable (DataType::AUDIO, *_session, path, false, get_test_sample_rate ()));
+	CPPUNIT_ASSERT (_source);
+
+	/* something with a different envelope in every peak */
+
+	Sample buf[4096];
+	for (framecnt_t done = 0; done < source_length; done += 4096) {
+		for (int i = 0; i < 4096; ++i) {
+			framecnt_t const n = done + i;
+			buf[i] = sin (n * 0.001) * ((n % 1009) / 1009.0);
+		}
+		_source->write (buf, 4096);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (source_length, _source->length (0));
+	CPPUNIT_ASSERT_EQUAL (0, _source->build_peaks_from_scratch ());
+}
+
+void
+PeakfileLevelsTest::tearDown ()
+{
+	_source.reset ();
+	AudioSource::set_build_peakfiles (_build_peakfiles);
+
+	TestNeedingSession::tearDown ();
+}
+
+off_t
+PeakfileLevelsTest::peakfile_size () const
+{
+	GStatBuf statbuf;
+	CPPUNIT_ASSERT_EQUAL (0, g_stat (_source->_peakpath.c_str(), &statbuf));
+	return statbuf.st_size;
+}
+
+/** Check that the level table describes the finest level followed by
+ *  two levels, each 16 times coarser than the last.
+ */
+void
+PeakfileLevelsTest::check_levels ()
+{
+	CPPUNIT_ASSERT_EQUAL (size_t (3), _source->_peak_levels.size ());
+
+	framecnt_t fpp = 256;
+	off_t offset = 0;
+
+	for (size_t n = 0; n < _source->_peak_levels.size(); ++n) {
+		AudioSource::PeakLevel const & l = _source->_peak_levels[n];
+		CPPUNIT_ASSERT_EQUAL (fpp, l.fpp);
+		CPPUNIT_ASSERT_EQUAL (offset, l.offset);
+		CPPUNIT_ASSERT_EQUAL (source_length / fpp, l.npeaks);
+		offset += l.npeaks * sizeof (PeakData);
+		fpp *= 16;
+	}
+
+	/* the levels are followed by the table, and nothing else */
+	CPPUNIT_ASSERT (peakfile_size () > offset);
+	CPPUNIT_ASSERT (peakfile_size () < offset + 256);
+}
+
+/** Read the whole source at @param fpp from its level, and check the
+ *  peaks against those reduced from the finest level.
+ */
+void
+PeakfileLevelsTest::check_level_read (framecnt_t fpp)
+{
+	framecnt_t const fine = source_length / 256;
+	framecnt_t const coarse = source_length / fpp;
+
+	vector<PeakData> fine_peaks (fine);
+	CPPUNIT_ASSERT_EQUAL (0, _source->read_peaks_with_fpp (&fine_peaks[0], fine, 0, source_length, 256, 256));
+
+	vector<PeakData> coarse_peaks (coarse);
+	CPPUNIT_ASSERT_EQUAL (0, _source->read_peaks_with_fpp (&coarse_peaks[0], coarse, 0, source_length, fpp, fpp));
+
+	framecnt_t const ratio = fpp / 256;
+
+	for (framecnt_t i = 0; i < coarse; ++i) {
+		PeakData p = fine_peaks[i * ratio];
+		for (framecnt_t j = 1; j < ratio; ++j) {
+			p.max = max (p.max, fine_peaks[i * ratio + j].max);
+			p.min = min (p.min, fine_peaks[i * ratio + j].min);
+		}
+		CPPUNIT_ASSERT_EQUAL (p.max, coarse_peaks[i].max);
+		CPPUNIT_ASSERT_EQUAL (p.min, coarse_peaks[i].min);
+	}
+}
+
+void
+PeakfileLevelsTest::levelsTest ()
+{
+	check_levels ();
+
+	/* read_peaks() picks the coarsest level with a peak per visual peak */
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (256), _source->peak_level_fpp (1000));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (4096), _source->peak_level_fpp (4096));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (4096), _source->peak_level_fpp (65535));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (65536), _source->peak_level_fpp (1e6));
+
+	/* and the table survives reopening the peakfile */
+	CPPUNIT_ASSERT_EQUAL (off_t ((source_length / 256) * sizeof (PeakData)), _source->load_peak_levels (peakfile_size ()));
+	check_levels ();
+}
+
+void
+PeakfileLevelsTest::readTest ()
+{
+	check_level_read (4096);
+	check_level_read (65536);
+}
+
+void
+PeakfileLevelsTest::upgradeTest ()
+{
+	off_t const fine_bytes = (source_length / 256) * sizeof (PeakData);
+
+	/* make a peakfile as older versions wrote it, with just the finest level */
+	CPPUNIT_ASSERT_EQUAL (0, truncate (_source->_peakpath.c_str(), fine_bytes));
+
+	CPPUNIT_ASSERT_EQUAL (fine_bytes, _source->load_peak_levels (fine_bytes));
+	check_levels ();
+	readTest ();
+}
+
+void
+PeakfileLevelsTest::interruptedTest ()
+{
+	off_t const fine_bytes = (source_length / 256) * sizeof (PeakData);
+
+	/* start rewriting the peaks, and give up */
+	CPPUNIT_ASSERT_EQUAL (0, _source->prepare_for_peakfile_writes ());
+	CPPUNIT_ASSERT (_source->_peak_levels.empty ());
+	_source->done_with_peakfile_writes (false);
+
+	/* the stale levels and their table are gone */
+	CPPUNIT_ASSERT_EQUAL (fine_bytes, peakfile_size ());
+
+	AudioSource::set_build_peakfiles (false);
+	CPPUNIT_ASSERT_EQUAL (fine_bytes, _source->load_peak_levels (fine_bytes));
+	CPPUNIT_ASSERT (_source->_peak_levels.empty ());
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <boost/shared_ptr.hpp>
+
+#include "ardour/types.h"
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class AudioSource;
+}
+
+class PeakfileLevelsTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (PeakfileLevelsTest);
+	CPPUNIT_TEST (levelsTest);
+	CPPUNIT_TEST (readTest);
+	CPPUNIT_TEST (upgradeTest);
+	CPPUNIT_TEST (interruptedTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void levelsTest ();
+	void readTest ();
+	void upgradeTest ();
+	void interruptedTest ();
+
+private:
+	off_t peakfile_size () const;
+	void check_levels ();
+	void check_level_read (ARDOUR::framecnt_t fpp);
+
+	boost::shared_ptr<ARDOUR::AudioSource> _source;
+	bool _build_peakfiles;
+};
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "playlist_regions_touched_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistRegionsTouchedTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static bool
+touches (boost::shared_ptr<Playlist> p, framepos_t start, framepos_t end, boost::shared_ptr<Region> r)
+{
+	boost::shared_ptr<RegionList> rl = p->regions_touched (start, end);
+	return find (rl->begin(), rl->end(), r) != rl->end();
+}
+
+void
+PlaylistRegionsTouchedTest::basicsTest ()
+{
+	_playlist->add_region (_r[0], 0);
+	_playlist->add_region (_r[1], 1000);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, _playlist->regions_touched (0, 99)->size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, _playlist->regions_touched (100, 999)->size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, _playlist->regions_touched (99, 1000)->size ());
+
+	_r[0]->trim_end (399);
+	CPPUNIT_ASSERT (touches (_playlist, 200, 300, _r[0]));
+
+	_r[1]->set_position (2000);
+	CPPUNIT_ASSERT (!touches (_playlist, 1000, 1099, _r[1]));
+	CPPUNIT_ASSERT (touches (_playlist, 2000, 2000, _r[1]));
+}
+
+/** Regions are found where they are now while their property changes are
+ *  suspended, as they are during a trim or move drag.
+ */
+void
+PlaylistRegionsTouchedTest::suspendedTest ()
+{
+	_playlist->add_region (_r[0], 0);
+	_playlist->add_region (_r[1], 1000);
+
+	_r[0]->suspend_property_changes ();
+	_r[1]->suspend_property_changes ();
+
+	_r[0]->trim_end (399);
+	_r[1]->set_position (2000);
+
+	CPPUNIT_ASSERT (touches (_playlist, 200, 300, _r[0]));
+	CPPUNIT_ASSERT (!touches (_playlist, 1000, 1099, _r[1]));
+	CPPUNIT_ASSERT (touches (_playlist, 2050, 2060, _r[1]));
+
+	_r[0]->resume_property_changes ();
+	_r[1]->resume_property_changes ();
+
+	CPPUNIT_ASSERT (touches (_playlist, 200, 300, _r[0]));
+	CPPUNIT_ASSERT (!touches (_playlist, 1000, 1099, _r[1]));
+	CPPUNIT_ASSERT (touches (_playlist, 2050, 2060, _r[1]));
+}
@@ -0,0 +1,141 @@
+#include <pthread.h>
+
+#include "pbd/debug_rt_alloc.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
+#include "ardour/buffer_manager.h"
+#include "ardour/buffer_set.h"
+#include "ardour/chan_mapping.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/process_thread.h"
+#include "ardour/session.h"
+
+#include "plugin_insert_test.h"
+
+using namespace ARDOUR;
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PluginInsertTest);
+
+static const pframes_t n_frames = 64;
+
+#ifdef DEBUG_RT_ALLOC
+/* abort () on malloc in the test thread while it processes */
+static pthread_t rt_thread;
+static bool      rt_check = false;
+
+extern "C" {
+
+static int
+test_alloc_allowed ()
+{
+	return !(rt_check && pthread_equal (pthread_self (), rt_thread));
+}
+
+}
+#endif
+
+void
+PluginInsertTest::run (boost::shared_ptr<PluginInsert> pi, BufferSet& bufs)
+{
+	bufs.set_count (ChanCount (DataType::AUDIO, 2));
+	for (uint32_t i = 0; i < n_frames; ++i) {
+		bufs.get_audio (0).data ()[i] = 1.f;
+		bufs.get_audio (1).data ()[i] = .5f;
+	}
+
+#ifdef DEBUG_RT_ALLOC
+	rt_check = true;
+#endif
+	/* not rolling: PluginInsert::connect_and_run () or bypass () */
+	pi->run (bufs, 0, n_frames, 1.0, n_frames, true);
+#ifdef DEBUG_RT_ALLOC
+	rt_check = false;
+#endif
+}
+
+void
+PluginInsertTest::pin_routing_test ()
+{
+	PluginInfoPtr amp;
+	const PluginInfoList& plugs = PluginManager::instance ().lua_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == "a-Amplifier") {
+			amp = *i;
+		}
+	}
+	CPPUNIT_ASSERT (amp);
+
+	PluginPtr p = amp->load (*_session);
+	CPPUNIT_ASSERT (p);
+
+	boost::shared_ptr<PluginInsert> pi (new PluginInsert (*_session, p));
+	const ChanCount stereo (DataType::AUDIO, 2);
+	CPPUNIT_ASSERT (pi->configure_io (stereo, stereo));
+	pi->activate ();
+
+	{
+		Glib::Threads::Mutex::Lock lm (AudioEngine::instance ()->process_lock ());
+		BufferManager::ensure_buffers (pi->required_buffers ());
+	}
+
+	ProcessThread pt;
+	pt.get_buffers ();
+	BufferSet& bufs (_session->get_route_buffers (stereo, true));
+
+#ifdef DEBUG_RT_ALLOC
+	int (*old_alloc_allowed) () = pbd_alloc_allowed;
+	rt_thread = pthread_self ();
+	pbd_alloc_allowed = &test_alloc_allowed;
+#endif
+
+	/* the first cycle may allocate, e.g. to configure the delaylines */
+	suspend_rt_malloc_checks ();
+	run (pi, bufs);
+	resume_rt_malloc_checks ();
+
+	/* identity map, in-place */
+	CPPUNIT_ASSERT (pi->inplace ());
+	run (pi, bufs);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, bufs.get_audio (0).data ()[n_frames - 1], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, bufs.get_audio (1).data ()[n_frames - 1], 1e-6);
+
+	/* swap the inputs, this needs a copy of them */
+	ChanMapping in_map;
+	in_map.set (DataType::AUDIO, 0, 1);
+	in_map.set (DataType::AUDIO, 1, 0);
+	pi->set_input_map (0, in_map);
+	CPPUNIT_ASSERT (!pi->inplace ());
+	run (pi, bufs);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, bufs.get_audio (0).data ()[n_frames - 1], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, bufs.get_audio (1).data ()[n_frames - 1], 1e-6);
+
+	/* disconnect the 2nd output, it is silenced */
+	ChanMapping out_map;
+	out_map.set (DataType::AUDIO, 0, 0);
+	pi->set_output_map (0, out_map);
+	run (pi, bufs);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, bufs.get_audio (0).data ()[n_frames - 1], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0, bufs.get_audio (1).data ()[n_frames - 1], 1e-6);
+
+	/* back to in-place, the 2nd output is still silenced */
+	pi->set_input_map (0, ChanMapping (stereo));
+	CPPUNIT_ASSERT (pi->inplace ());
+	run (pi, bufs);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, bufs.get_audio (0).data ()[n_frames - 1], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0, bufs.get_audio (1).data ()[n_frames - 1], 1e-6);
+
+	/* bypass uses the same routing */
+	pi->deactivate ();
+	pi->set_input_map (0, in_map);
+	pi->set_output_map (0, ChanMapping (stereo));
+	run (pi, bufs);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, bufs.get_audio (0).data ()[n_frames - 1], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, bufs.get_audio (1).data ()[n_frames - 1], 1e-6);
+
+#ifdef DEBUG_RT_ALLOC
+	pbd_alloc_allowed = old_alloc_allowed;
+#endif
+	pt.drop_buffers ();
+}
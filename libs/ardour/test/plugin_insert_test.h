@@ -0,0 +1,20 @@
+#include <boost/shared_ptr.hpp>
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class BufferSet;
+	class PluginInsert;
+}
+
+class PluginInsertTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (PluginInsertTest);
+	CPPUNIT_TEST (pin_routing_test);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void pin_routing_test ();
+
+private:
+	void run (boost::shared_ptr<ARDOUR::PluginInsert>, ARDOUR::BufferSet&);
+};
@@ -0,0 +1,163 @@
+#include <sys/time.h>
+#include <iostream>
+#include <cstdlib>
+
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+
+#include "pbd/compose.h"
+#include "pbd/cpus.h"
+#include "pbd/xml++.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/export_channel_configuration.h"
+#include "ardour/export_filename.h"
+#include "ardour/export_format_specification.h"
+#include "ardour/export_handler.h"
+#include "ardour/export_status.h"
+#include "ardour/export_timespan.h"
+#include "ardour/io.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+#include "ardour/session_event.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time the export of many contiguous timespans of the master bus (as
+ *  when exporting the tracks of an album from range markers), one pass
+ *  over the session per timespan against all timespans in one pass (see
+ *  the export-timespans-in-one-pass preference). The export graphs run
+ *  on as many threads as there are cores; run under taskset to compare
+ *  different numbers of cores.
+ */
+
+static double
+seconds_since (timeval const & start)
+{
+	timeval now;
+	gettimeofday (&now, 0);
+	return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1e6;
+}
+
+static double
+export_timespans (Session* session, string const & folder, int n_timespans, framecnt_t length)
+{
+	boost::shared_ptr<ExportHandler> handler = session->get_export_handler ();
+
+	boost::shared_ptr<ExportChannelConfiguration> ccp = handler->add_channel_config ();
+	IO* master_out = session->master_out()->output().get();
+	for (uint32_t n = 0; n < master_out->n_ports().n_audio(); ++n) {
+		PortExportChannel* channel = new PortExportChannel ();
+		channel->add_port (master_out->audio (n));
+		ccp->register_channel (ExportChannelPtr (channel));
+	}
+
+	XMLTree tree;
+	tree.read_buffer (string_compose (
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+"<ExportFormatSpecification name=\"PROFILE-WAV-16\" id=\"5cd7c2a4-6a0e-4b8a-9b55-0e1a1d8fc3e2\">"
+"  <Encoding id=\"F_WAV\" type=\"T_Sndfile\" extension=\"wav\" name=\"WAV\" has-sample-format=\"true\" channel-limit=\"256\"/>"
+"  <SampleRate rate=\"%1\"/>"
+"  <SRCQuality quality=\"SRC_SincBest\"/>"
+"  <EncodingOptions>"
+"    <Option name=\"sample-format\" value=\"SF_16\"/>"
+"    <Option name=\"dithering\" value=\"D_None\"/>"
+"    <Option name=\"tag-metadata\" value=\"false\"/>"
+"    <Option name=\"tag-support\" value=\"false\"/>"
+"    <Option name=\"broadcast-info\" value=\"false\"/>"
+"  </EncodingOptions>"
+"  <Processing>"
+"    <Normalize enabled=\"false\" target=\"0\"/>"
+"  </Processing>"
+"</ExportFormatSpecification>", session->nominal_frame_rate ()));
+	boost::shared_ptr<ExportFormatSpecification> fmp = handler->add_format (*tree.root ());
+	fmp->set_soundcloud_upload (false);
+
+	boost::shared_ptr<ExportFilename> fnp = handler->add_filename ();
+	fnp->set_folder (folder);
+	fnp->include_label = false;
+
+	framepos_t const start = session->current_start_frame ();
+
+	for (int i = 0; i < n_timespans; ++i) {
+		ExportTimespanPtr tsp = handler->add_timespan ();
+		tsp->set_range (start + i * length, start + (i + 1) * length);
+		tsp->set_name (string_compose ("span %1", i + 1));
+		tsp->set_range_id (string_compose ("span-%1", i + 1));
+		handler->add_export_config (tsp, ccp, fmp, fnp, boost::shared_ptr<AudioGrapher::BroadcastInfo> ());
+	}
+
+	timeval begin;
+	gettimeofday (&begin, 0);
+
+	handler->do_export ();
+
+	boost::shared_ptr<ExportStatus> status = session->get_export_status ();
+	while (status->running ()) {
+		Glib::usleep (1000);
+	}
+
+	double const elapsed = seconds_since (begin);
+
+	/* let the session drop the handler, the next run gets a new one */
+	status->finish ();
+
+	return elapsed;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const n_timespans = argc > 1 ? atoi (argv[1]) : 16;
+	double const seconds = argc > 2 ? atof (argv[2]) : 10;
+
+	ARDOUR::init (false, true, localedir);
+	SessionEvent::create_per_thread_pool ("profiling", 512);
+
+	/* export needs a running engine to freewheel */
+	AudioEngine* engine = AudioEngine::create ();
+	if (!engine->set_backend ("None (Dummy)", "Profiling", "")) {
+		cerr << argv[0] << ": could not set up the dummy backend\n";
+		exit (EXIT_FAILURE);
+	}
+	init_post_engine ();
+	if (engine->start () != 0) {
+		cerr << argv[0] << ": could not start the dummy backend\n";
+		exit (EXIT_FAILURE);
+	}
+
+	Session* session = new Session (*engine, "../libs/ardour/test/profiling/sessions/1region", "1region");
+	engine->set_session (session);
+
+	if (!session->master_out ()) {
+		cerr << argv[0] << ": session has no master bus\n";
+		exit (EXIT_FAILURE);
+	}
+
+	framecnt_t const length = seconds * session->nominal_frame_rate ();
+	string const folder = Glib::build_filename (new_test_output_dir ("export_timespans"), "");
+
+	cout << "INFO: " << n_timespans << " timespans of " << seconds << "s, "
+	     << hardware_concurrency () << " cores.\n";
+
+	Config->set_export_timespans_in_one_pass (false);
+	double const separate = export_timespans (session, folder, n_timespans, length);
+	cout << "one pass per timespan: " << separate << "s, " << n_timespans * seconds / separate << "x realtime\n";
+
+	Config->set_export_timespans_in_one_pass (true);
+	double const shared = export_timespans (session, folder, n_timespans, length);
+	cout << "all timespans in one pass: " << shared << "s, " << n_timespans * seconds / shared << "x realtime\n";
+
+	engine->remove_session ();
+	delete session;
+	engine->stop ();
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** Run @param cycles process cycles of @param session and print
+ *  the time each one took.
+ */
+static void
+run_cycles (Session* session, int cycles, string const & name)
+{
+	pframes_t const nframes = session->engine().samples_per_cycle ();
+	TimingData timing;
+	timing.reserve (cycles);
+
+	/* let the graph swap to the new chain and settle */
+	for (int i = 0; i < 256; ++i) {
+		session->process (nframes);
+	}
+
+	for (int i = 0; i < cycles; ++i) {
+		timing.start_timing ();
+		session->process (nframes);
+		timing.add_elapsed ();
+	}
+
+	uint64_t min, max, avg, total;
+	timing.get_min_max_avg_total (min, max, avg, total);
+
+	cout << name << ": " << cycles << " cycles of " << nframes << " samples, per cycle (usecs)"
+	     << " min: " << min << " max: " << max << " avg: " << avg << "\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	if (argc < 2) {
+		cerr << argv[0] << ": <session> [cycles]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	int const cycles = argc > 2 ? atoi (argv[2]) : 16384;
+
+	ARDOUR::init (false, true, localedir);
+
+	Session* session = load_session (
+		string_compose ("../libs/ardour/test/profiling/sessions/%1", argv[1]),
+		string_compose ("%1.ardour", argv[1])
+		);
+
+	cout << "INFO: " << session->get_routes()->size() << " routes, "
+	     << AudioEngine::instance()->process_thread_count () << " process threads.\n";
+
+	/* The routes in the test sessions do no DSP to speak of, so the
+	   time per cycle is dominated by the graph's scheduling overhead.
+	*/
+	Config->set_use_work_stealing_scheduler (false);
+	run_cycles (session, cycles, "locked trigger queue");
+
+	Config->set_use_work_stealing_scheduler (true);
+	run_cycles (session, cycles, "work-stealing");
+
+	AudioEngine::instance()->remove_session ();
+	delete session;
+	AudioEngine::instance()->stop ();
+
+	return 0;
+}
@@ -1,4 +1,7 @@
+#include <iostream>
+
 #include "test_util.h"
+#include "pbd/timing.h"
 #include "ardour/ardour.h"
 #include "ardour/midi_track.h"
 #include "ardour/midi_region.h"
@@ -48,4 +51,29 @@ main (int argc, char* argv[])
 	playlist->duplicate (region, region->last_frame() + 1, 1000);
 	session->add_command (new StatefulDiffCommand (playlist));
 	session->commit_reversible_command ();
+
+	/* Time range lookups across the whole playlist, as done by reads */
+	cout << "INFO: " << playlist->n_regions () << " regions.\n";
+
+	framepos_t const extent = playlist->get_extent().second;
+	framecnt_t const chunk = 65536;
+	framecnt_t const step = max (extent / 1024, (framepos_t) 1);
+	TimingData touched_timing;
+	TimingData at_timing;
+	size_t found = 0;
+
+	for (int pass = 0; pass < 16; ++pass) {
+		for (framepos_t pos = 0; pos < extent; pos += step) {
+			touched_timing.start_timing ();
+			found += playlist->regions_touched (pos, pos + chunk - 1)->size ();
+			touched_timing.add_elapsed ();
+
+			at_timing.start_timing ();
+			found += playlist->top_region_at (pos) ? 1 : 0;
+			at_timing.add_elapsed ();
+		}
+	}
+
+	cout << "regions_touched (" << found << " hits): " << touched_timing.summary ();
+	cout << "top_region_at: " << at_timing.summary ();
 }
@@ -0,0 +1,248 @@
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/fpu.h"
+#include "pbd/malign.h"
+#include "pbd/timing.h"
+
+#include "ardour/iec1ppmdsp.h"
+#include "ardour/iec2ppmdsp.h"
+#include "ardour/kmeterdsp.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+#include "ardour/vumeterdsp.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+/** Check the meter ballistics routines that this CPU can run against the
+ *  per-channel process() of the meter DSP classes, then time both for
+ *  increasing numbers of channels, as on a bus with K, IEC or VU meters.
+ */
+
+struct KernelSet {
+	const char*       name;
+	uint32_t          lanes;
+	kmeter_process_t  kmeter_process;
+	ppm_process_t     ppm_process;
+	vumeter_process_t vumeter_process;
+};
+
+static void
+use (KernelSet const & k)
+{
+	meter_lanes     = k.lanes;
+	kmeter_process  = k.kmeter_process;
+	ppm_process     = k.ppm_process;
+	vumeter_process = k.vumeter_process;
+}
+
+/** One meter of each type per channel */
+template<typename DSP>
+struct Meters {
+	Meters (int n) {
+		for (int i = 0; i < n; ++i) {
+			dsp.push_back (new DSP);
+		}
+	}
+	~Meters () {
+		for (typename vector<DSP*>::iterator i = dsp.begin(); i != dsp.end(); ++i) {
+			delete *i;
+		}
+	}
+	void process (float const * const * bufs, int nframes) {
+		for (size_t i = 0; i < dsp.size(); ++i) {
+			dsp[i]->process (bufs[i], nframes);
+		}
+	}
+	void process_batch (float const * const * bufs, int nframes) {
+		DSP::process (&dsp[0], bufs, dsp.size(), nframes);
+	}
+
+	vector<DSP*> dsp;
+};
+
+static float
+random_sample ()
+{
+	return (rand () / (float) RAND_MAX) * 2.0f - 1.0f;
+}
+
+/* The routines do the same operations in the same order as process(), so
+ * the results match exactly unless the compiler reorders either of them
+ * (e.g. with -ffast-math).
+ */
+static bool
+close_enough (float a, float b)
+{
+	return fabsf (a - b) <= 1e-6f * max (fabsf (a), fabsf (b));
+}
+
+template<typename DSP>
+static bool
+verify_type (const char* set, const char* type, float const * const * bufs, int n_channels, int nframes)
+{
+	Meters<DSP> single (n_channels);
+	Meters<DSP> batch (n_channels);
+	bool ok = true;
+
+	for (int cycle = 0; cycle < 64; ++cycle) {
+		single.process (bufs, nframes);
+		batch.process_batch (bufs, nframes);
+
+		/* read every few cycles, as the GUI does */
+		if (cycle % 5 == 4) {
+			for (int c = 0; c < n_channels; ++c) {
+				float const a = single.dsp[c]->read ();
+				float const b = batch.dsp[c]->read ();
+				if (!close_enough (a, b)) {
+					cerr << "FAIL: " << set << " " << type << " channel " << c << " of " << n_channels
+					     << " cycle " << cycle << ": " << a << " != " << b << "\n";
+					ok = false;
+				}
+			}
+		}
+	}
+
+	return ok;
+}
+
+static bool
+verify (KernelSet const & k, float const * const * bufs, int nframes)
+{
+	static const int channels[] = { 1, 2, 3, 4, 5, 7, 8, 9, 13, 16, 17, 32 };
+	bool ok = true;
+
+	use (k);
+
+	for (size_t i = 0; i < sizeof (channels) / sizeof (channels[0]); ++i) {
+		ok &= verify_type<Kmeterdsp> (k.name, "K-meter", bufs, channels[i], nframes);
+		ok &= verify_type<Iec1ppmdsp> (k.name, "IEC1 PPM", bufs, channels[i], nframes);
+		ok &= verify_type<Iec2ppmdsp> (k.name, "IEC2 PPM", bufs, channels[i], nframes);
+		ok &= verify_type<Vumeterdsp> (k.name, "VU", bufs, channels[i], nframes);
+	}
+
+	return ok;
+}
+
+static uint64_t
+total (TimingData& t)
+{
+	uint64_t min, max, avg, total;
+	t.get_min_max_avg_total (min, max, avg, total);
+	t.reset ();
+	return total;
+}
+
+template<typename DSP>
+static void
+bench_type (const char* type, float const * const * bufs, int n_channels, int nframes, int cycles)
+{
+	Meters<DSP> meters (n_channels);
+	TimingData t;
+
+	t.start_timing ();
+	for (int i = 0; i < cycles; ++i) {
+		meters.process (bufs, nframes);
+	}
+	t.add_elapsed ();
+	uint64_t const single = total (t);
+
+	t.start_timing ();
+	for (int i = 0; i < cycles; ++i) {
+		meters.process_batch (bufs, nframes);
+	}
+	t.add_elapsed ();
+	uint64_t const batch = total (t);
+
+	cout << "\t" << type << ": usecs for " << cycles << " cycles, per channel: " << single << " batched: " << batch;
+	if (batch > 0) {
+		cout << " (" << (double) single / batch << "x)";
+	}
+	cout << "\n";
+}
+
+static void
+bench (KernelSet const & k, float const * const * bufs, int nframes, int cycles)
+{
+	use (k);
+
+	for (int n_channels = 2; n_channels <= 64; n_channels *= 2) {
+		cout << k.name << " (" << k.lanes << " channels at once), " << n_channels << " channels, " << nframes << " frames:\n";
+		bench_type<Kmeterdsp> ("K-meter", bufs, n_channels, nframes, cycles);
+		bench_type<Iec1ppmdsp> ("IEC1 PPM", bufs, n_channels, nframes, cycles);
+		bench_type<Iec2ppmdsp> ("IEC2 PPM", bufs, n_channels, nframes, cycles);
+		bench_type<Vumeterdsp> ("VU", bufs, n_channels, nframes, cycles);
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const nframes = argc > 1 ? atoi (argv[1]) : 1024;
+	int const cycles = argc > 2 ? atoi (argv[2]) : 10000;
+	int const max_channels = 64;
+
+	if (nframes <= 0) {
+		cerr << argv[0] << ": need a positive number of frames\n";
+		exit (EXIT_FAILURE);
+	}
+
+	Kmeterdsp::init (48000);
+	Iec1ppmdsp::init (48000);
+	Iec2ppmdsp::init (48000);
+	Vumeterdsp::init (48000);
+
+	srand (1);
+
+	vector<float*> bufs;
+	for (int c = 0; c < max_channels; ++c) {
+		float* buf;
+		cache_aligned_malloc ((void**) &buf, nframes * sizeof (float));
+		/* channels at different levels, so the meters differ */
+		float const level = 1.0f / (1 + c % 7);
+		for (int i = 0; i < nframes; ++i) {
+			buf[i] = random_sample () * level;
+		}
+		bufs.push_back (buf);
+	}
+
+	vector<KernelSet> sets;
+	KernelSet const def = { "default", 4, default_kmeter_process, default_ppm_process, default_vumeter_process };
+	sets.push_back (def);
+
+#if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
+	FPU* fpu = FPU::instance ();
+
+	if (fpu->has_sse ()) {
+		KernelSet const sse = { "SSE", 4, x86_sse_kmeter_process, x86_sse_ppm_process, x86_sse_vumeter_process };
+		sets.push_back (sse);
+	}
+
+	if (fpu->has_avx ()) {
+		KernelSet const avx = { "AVX", 8, x86_sse_avx_kmeter_process, x86_sse_avx_ppm_process, x86_sse_avx_vumeter_process };
+		sets.push_back (avx);
+	}
+#endif
+
+	bool ok = true;
+
+	for (vector<KernelSet>::const_iterator k = sets.begin(); k != sets.end(); ++k) {
+		ok &= verify (*k, &bufs[0], nframes);
+	}
+
+	for (vector<KernelSet>::const_iterator k = sets.begin(); k != sets.end(); ++k) {
+		bench (*k, &bufs[0], nframes, cycles);
+	}
+
+	for (vector<float*>::iterator b = bufs.begin(); b != bufs.end(); ++b) {
+		cache_aligned_free (*b);
+	}
+
+	cout << (ok ? "batched meters match the per-channel meters\n" : "MISMATCH\n");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "test_util.h"
+#include "pbd/timing.h"
+#include "pbd/xml++.h"
+#include "ardour/ardour.h"
+#include "ardour/midi_model.h"
+#include "ardour/midi_region.h"
+#include "ardour/midi_track.h"
+#include "ardour/playlist.h"
+#include "ardour/session.h"
+#include "evoral/midi_events.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time loading a large MIDI model, iterating over it, and making bulk
+ *  edits to it with NoteDiffCommands (as done by e.g. quantize or
+ *  transpose), including reloading such an edit from its saved state.
+ */
+
+int
+main (int argc, char* argv[])
+{
+	int const n_notes = argc > 1 ? atoi (argv[1]) : 200000;
+
+	ARDOUR::init (false, true, localedir);
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	boost::shared_ptr<MidiTrack> track = boost::dynamic_pointer_cast<MidiTrack> (session->get_routes()->back());
+	assert (track);
+
+	boost::shared_ptr<MidiRegion> region = boost::dynamic_pointer_cast<MidiRegion> (track->playlist()->region_list_property().rlist().front());
+	assert (region);
+
+	boost::shared_ptr<MidiModel> model = region->model ();
+	typedef MidiModel::TimeType Time;
+
+	/* Load */
+
+	TimingData load_timing;
+	load_timing.start_timing ();
+
+	model->start_write ();
+
+	for (int i = 0; i < n_notes; ++i) {
+		uint8_t on[3] = { MIDI_CMD_NOTE_ON, (uint8_t) (36 + (i % 48)), 100 };
+		uint8_t off[3] = { MIDI_CMD_NOTE_OFF, (uint8_t) (36 + (i % 48)), 64 };
+		Time const t (i * 0.25);
+
+		model->append (Evoral::Event<Time> (Evoral::MIDI_EVENT, t, 3, on, false), Evoral::next_event_id ());
+		model->append (Evoral::Event<Time> (Evoral::MIDI_EVENT, t + Time (0.2), 3, off, false), Evoral::next_event_id ());
+	}
+
+	model->end_write (MidiModel::ResolveStuckNotes, Time (n_notes * 0.25));
+
+	load_timing.add_elapsed ();
+	cout << "INFO: " << model->n_notes () << " notes.\n";
+	cout << "load: " << load_timing.summary ();
+
+	/* Iterate */
+
+	TimingData iterate_timing;
+	size_t events = 0;
+
+	for (int pass = 0; pass < 8; ++pass) {
+		iterate_timing.start_timing ();
+		for (MidiModel::const_iterator i = model->begin (); i != model->end (); ++i) {
+			++events;
+		}
+		iterate_timing.add_elapsed ();
+	}
+
+	cout << "iterate (" << events << " events): " << iterate_timing.summary ();
+
+	/* Bulk edits: move every note, then change every velocity */
+
+	MidiModel::NoteDiffCommand* move = model->new_note_diff_command ("move");
+	MidiModel::NoteDiffCommand* velocity = model->new_note_diff_command ("velocity");
+
+	for (MidiModel::Notes::iterator n = model->notes().begin(); n != model->notes().end(); ++n) {
+		move->change (*n, MidiModel::NoteDiffCommand::StartTime, (*n)->time() + Time (0.125));
+		velocity->change (*n, MidiModel::NoteDiffCommand::Velocity, (uint8_t) 90);
+	}
+
+	TimingData edit_timing;
+	TimingData undo_timing;
+
+	for (int pass = 0; pass < 4; ++pass) {
+		edit_timing.start_timing ();
+		(*move) ();
+		(*velocity) ();
+		edit_timing.add_elapsed ();
+
+		undo_timing.start_timing ();
+		velocity->undo ();
+		move->undo ();
+		undo_timing.add_elapsed ();
+	}
+
+	cout << "edit: " << edit_timing.summary ();
+	cout << "undo: " << undo_timing.summary ();
+
+	/* Reload an edit from its saved state, as when loading history */
+
+	XMLNode& state (velocity->get_state ());
+
+	TimingData reload_timing;
+	reload_timing.start_timing ();
+	MidiModel::NoteDiffCommand* reloaded = new MidiModel::NoteDiffCommand (model, state);
+	reload_timing.add_elapsed ();
+
+	cout << "reload: " << reload_timing.summary ();
+
+	delete reloaded;
+	delete &state;
+	delete velocity;
+	delete move;
+
+	return 0;
+}
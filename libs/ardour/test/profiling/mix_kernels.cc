@@ -0,0 +1,260 @@
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "pbd/fpu.h"
+#include "pbd/malign.h"
+#include "pbd/timing.h"
+
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+/** Check each set of mix routines that this CPU can run against the
+ *  default routines, then time them.
+ *
+ *  Everything except compute_peak() must give bit-identical results to
+ *  the default routines. default_compute_peak() uses an arithmetic
+ *  approximation of max(), so peaks are compared with the exact maximum
+ *  instead.
+ */
+
+struct KernelSet {
+	const char*                   name;
+	compute_peak_t                compute_peak;
+	find_peaks_t                  find_peaks;
+	apply_gain_to_buffer_t        apply_gain_to_buffer;
+	mix_buffers_with_gain_t       mix_buffers_with_gain;
+	mix_buffers_no_gain_t         mix_buffers_no_gain;
+	copy_vector_t                 copy_vector;
+	apply_gain_curve_to_buffer_t  apply_gain_curve_to_buffer;
+	mix_buffers_with_gain_curve_t mix_buffers_with_gain_curve;
+};
+
+static const KernelSet default_set = {
+	"default",
+	default_compute_peak, default_find_peaks, default_apply_gain_to_buffer,
+	default_mix_buffers_with_gain, default_mix_buffers_no_gain, default_copy_vector,
+	default_apply_gain_curve_to_buffer, default_mix_buffers_with_gain_curve
+};
+
+static const uint32_t max_frames = 8192;
+
+static float* src;
+static float* gain;
+static float* dst_ref;
+static float* dst;
+
+static float
+random_sample ()
+{
+	return (rand () / (float) RAND_MAX) * 2.0f - 1.0f;
+}
+
+static bool
+check (const char* set, const char* kernel, uint32_t offset, uint32_t nframes, bool ok)
+{
+	if (!ok) {
+		cerr << "FAIL: " << set << " " << kernel << " offset " << offset << " nframes " << nframes << "\n";
+	}
+	return ok;
+}
+
+static bool
+same_bits (const float* a, const float* b, uint32_t n)
+{
+	return memcmp (a, b, n * sizeof (float)) == 0;
+}
+
+/* Buffers in the process cycle are aligned, but the routines are also
+ * used on offsets into them (e.g. by the panners), so test all the
+ * offsets (with src and dst equally aligned) and a range of lengths.
+ */
+static bool
+verify (KernelSet const & k)
+{
+	static const uint32_t lengths[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 64, 127, 256, 1023, 1024, 4099 };
+	bool ok = true;
+
+	for (uint32_t offset = 0; offset < 16; ++offset) {
+		for (size_t l = 0; l < sizeof (lengths) / sizeof (lengths[0]); ++l) {
+
+			uint32_t const n = lengths[l];
+			float const* s = src + offset;
+			float const* g = gain + offset;
+
+			float exact = 0.1f;
+			for (uint32_t i = 0; i < n; ++i) {
+				exact = max (exact, fabsf (s[i]));
+			}
+			ok &= check (k.name, "compute_peak", offset, n, k.compute_peak (s, n, 0.1f) == exact);
+
+			float rmin = 0.5f, rmax = -0.5f, kmin = 0.5f, kmax = -0.5f;
+			default_find_peaks (s, n, &rmin, &rmax);
+			k.find_peaks (s, n, &kmin, &kmax);
+			ok &= check (k.name, "find_peaks", offset, n, rmin == kmin && rmax == kmax);
+
+			memcpy (dst_ref, src, max_frames * sizeof (float));
+			memcpy (dst, src, max_frames * sizeof (float));
+			default_apply_gain_to_buffer (dst_ref + offset, n, 0.7f);
+			k.apply_gain_to_buffer (dst + offset, n, 0.7f);
+			ok &= check (k.name, "apply_gain_to_buffer", offset, n, same_bits (dst_ref, dst, max_frames));
+
+			memcpy (dst_ref, gain, max_frames * sizeof (float));
+			memcpy (dst, gain, max_frames * sizeof (float));
+			default_mix_buffers_with_gain (dst_ref + offset, s, n, 0.3f);
+			k.mix_buffers_with_gain (dst + offset, s, n, 0.3f);
+			ok &= check (k.name, "mix_buffers_with_gain", offset, n, same_bits (dst_ref, dst, max_frames));
+
+			memcpy (dst_ref, gain, max_frames * sizeof (float));
+			memcpy (dst, gain, max_frames * sizeof (float));
+			default_mix_buffers_no_gain (dst_ref + offset, s, n);
+			k.mix_buffers_no_gain (dst + offset, s, n);
+			ok &= check (k.name, "mix_buffers_no_gain", offset, n, same_bits (dst_ref, dst, max_frames));
+
+			memset (dst, 0, max_frames * sizeof (float));
+			k.copy_vector (dst + offset, s, n);
+			ok &= check (k.name, "copy_vector", offset, n, same_bits (dst + offset, s, n));
+
+			memcpy (dst_ref, src, max_frames * sizeof (float));
+			memcpy (dst, src, max_frames * sizeof (float));
+			default_apply_gain_curve_to_buffer (dst_ref + offset, n, g);
+			k.apply_gain_curve_to_buffer (dst + offset, n, g);
+			ok &= check (k.name, "apply_gain_curve_to_buffer", offset, n, same_bits (dst_ref, dst, max_frames));
+
+			memcpy (dst_ref, gain, max_frames * sizeof (float));
+			memcpy (dst, gain, max_frames * sizeof (float));
+			default_mix_buffers_with_gain_curve (dst_ref + offset, s, n, g);
+			k.mix_buffers_with_gain_curve (dst + offset, s, n, g);
+			ok &= check (k.name, "mix_buffers_with_gain_curve", offset, n, same_bits (dst_ref, dst, max_frames));
+		}
+	}
+
+	return ok;
+}
+
+static void
+report (const char* set, const char* kernel, TimingData& t, int iterations)
+{
+	uint64_t min, max, avg, total;
+	t.get_min_max_avg_total (min, max, avg, total);
+	cout << set << " " << kernel << ": " << total << " usecs for " << iterations << " calls\n";
+	t.reset ();
+}
+
+static void
+bench (KernelSet const & k, uint32_t nframes, int iterations)
+{
+	TimingData t;
+	float peak = 0;
+	float pmin = 0, pmax = 0;
+
+#define BENCH(kernel, call)                       \
+	t.start_timing ();                            \
+	for (int i = 0; i < iterations; ++i) {        \
+		call;                                     \
+	}                                             \
+	t.add_elapsed ();                             \
+	report (k.name, kernel, t, iterations);
+
+	BENCH ("compute_peak", peak = k.compute_peak (src, nframes, peak));
+	BENCH ("find_peaks", k.find_peaks (src, nframes, &pmin, &pmax));
+	BENCH ("apply_gain_to_buffer", k.apply_gain_to_buffer (dst, nframes, 1.0f));
+	BENCH ("mix_buffers_with_gain", k.mix_buffers_with_gain (dst, src, nframes, 0.0f));
+	BENCH ("mix_buffers_no_gain", k.mix_buffers_no_gain (dst, src, nframes));
+	BENCH ("copy_vector", k.copy_vector (dst, src, nframes));
+	BENCH ("apply_gain_curve_to_buffer", k.apply_gain_curve_to_buffer (dst, nframes, gain));
+	BENCH ("mix_buffers_with_gain_curve", k.mix_buffers_with_gain_curve (dst, src, nframes, gain));
+
+#undef BENCH
+
+	if (peak < 0 || pmin > pmax) {
+		cout << "(unused)\n";
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t const nframes = argc > 1 ? atoi (argv[1]) : 1024;
+	int const iterations = argc > 2 ? atoi (argv[2]) : 100000;
+
+	if (nframes > max_frames) {
+		cerr << argv[0] << ": at most " << max_frames << " frames\n";
+		exit (EXIT_FAILURE);
+	}
+
+	cache_aligned_malloc ((void**) &src, max_frames * sizeof (float));
+	cache_aligned_malloc ((void**) &gain, max_frames * sizeof (float));
+	cache_aligned_malloc ((void**) &dst_ref, max_frames * sizeof (float));
+	cache_aligned_malloc ((void**) &dst, max_frames * sizeof (float));
+
+	srand (1);
+	for (uint32_t i = 0; i < max_frames; ++i) {
+		src[i] = random_sample ();
+		gain[i] = random_sample ();
+	}
+
+	vector<KernelSet> sets;
+	sets.push_back (default_set);
+
+#if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
+	FPU* fpu = FPU::instance ();
+
+	if (fpu->has_sse ()) {
+		KernelSet const sse = {
+			"SSE",
+			x86_sse_compute_peak, x86_sse_find_peaks, x86_sse_apply_gain_to_buffer,
+			x86_sse_mix_buffers_with_gain, x86_sse_mix_buffers_no_gain, default_copy_vector,
+			x86_sse_apply_gain_curve_to_buffer, x86_sse_mix_buffers_with_gain_curve
+		};
+		sets.push_back (sse);
+	}
+
+	if (fpu->has_avx ()) {
+		KernelSet const avx = {
+			"AVX",
+			x86_sse_avx_compute_peak, x86_sse_avx_find_peaks, x86_sse_avx_apply_gain_to_buffer,
+			x86_sse_avx_mix_buffers_with_gain, x86_sse_avx_mix_buffers_no_gain, x86_sse_avx_copy_vector,
+			x86_sse_avx_apply_gain_curve_to_buffer, x86_sse_avx_mix_buffers_with_gain_curve
+		};
+		sets.push_back (avx);
+	}
+
+#ifndef PLATFORM_WINDOWS
+	if (fpu->has_avx512f ()) {
+		KernelSet const avx512f = {
+			"AVX-512F",
+			x86_avx512f_compute_peak, x86_avx512f_find_peaks, x86_avx512f_apply_gain_to_buffer,
+			x86_avx512f_mix_buffers_with_gain, x86_avx512f_mix_buffers_no_gain, default_copy_vector,
+			x86_avx512f_apply_gain_curve_to_buffer, x86_avx512f_mix_buffers_with_gain_curve
+		};
+		sets.push_back (avx512f);
+	}
+#endif
+#endif
+
+	bool ok = true;
+
+	for (vector<KernelSet>::const_iterator k = sets.begin(); k != sets.end(); ++k) {
+		ok &= verify (*k);
+	}
+
+	for (vector<KernelSet>::const_iterator k = sets.begin(); k != sets.end(); ++k) {
+		bench (*k, nframes, iterations);
+	}
+
+	cache_aligned_free (src);
+	cache_aligned_free (gain);
+	cache_aligned_free (dst_ref);
+	cache_aligned_free (dst);
+
+	cout << (ok ? "all routines match the default routines\n" : "MISMATCH\n");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/automation_control.h"
+#include "ardour/automation_list.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time process cycles of busses with an automated gain plugin,
+ *  comparing sub-block splitting of plugins at every automation event
+ *  with handing the events to plugins that take timestamped parameter
+ *  changes (see the plugin-automation-events preference).
+ */
+
+static PluginInfoPtr
+find_lua_plugin (string const & name)
+{
+	const PluginInfoList& plugs = PluginManager::instance ().lua_plugin_info ();
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->name == name) {
+			return *i;
+		}
+	}
+	return PluginInfoPtr ();
+}
+
+/** Add an instance of @param info to each route, with its first control
+ *  automated by a ramp every @param spacing samples for @param length
+ *  samples from the current transport position.
+ */
+static void
+add_automated_plugin (Session* session, RouteList& routes, PluginInfoPtr info, framecnt_t spacing, framecnt_t length)
+{
+	framepos_t const start = session->transport_frame ();
+
+	for (RouteList::iterator r = routes.begin (); r != routes.end (); ++r) {
+		boost::shared_ptr<PluginInsert> pi (new PluginInsert (*session, info->load (*session)));
+		(*r)->add_processor (pi, PreFader);
+
+		boost::shared_ptr<AutomationControl> ac = pi->automation_control (Evoral::Parameter (PluginAutomation, 0, 0));
+		boost::shared_ptr<AutomationList> al = ac->alist ();
+		al->freeze ();
+		for (framecnt_t t = start, n = 0; t < start + length; t += spacing, ++n) {
+			al->fast_simple_add (t, (n % 2) ? -20.f : 20.f);
+		}
+		al->thaw ();
+		ac->set_automation_state (Play);
+	}
+}
+
+static void
+remove_plugins (RouteList& routes)
+{
+	for (RouteList::iterator r = routes.begin (); r != routes.end (); ++r) {
+		boost::shared_ptr<Processor> p = (*r)->nth_plugin (0);
+		if (p) {
+			(*r)->remove_processor (p);
+		}
+	}
+}
+
+static void
+run_cycles (Session* session, int cycles, string const & name)
+{
+	pframes_t const nframes = session->engine().samples_per_cycle ();
+	TimingData timing;
+	timing.reserve (cycles);
+
+	for (int i = 0; i < cycles; ++i) {
+		timing.start_timing ();
+		session->process (nframes);
+		timing.add_elapsed ();
+	}
+
+	uint64_t min, max, avg, total;
+	timing.get_min_max_avg_total (min, max, avg, total);
+
+	cout << name << ": per cycle (usecs) min: " << min << " max: " << max << " avg: " << avg << "\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const n_busses = argc > 1 ? atoi (argv[1]) : 32;
+	int const cycles = argc > 2 ? atoi (argv[2]) : 1024;
+
+	ARDOUR::init (false, true, localedir);
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	PluginInfoPtr split_amp = find_lua_plugin ("a-Amplifier");
+	PluginInfoPtr event_amp = find_lua_plugin ("Simple Amp Events");
+	if (!split_amp || !event_amp) {
+		cerr << argv[0] << ": could not find the Lua amplifier plugins\n";
+		exit (EXIT_FAILURE);
+	}
+
+	RouteList busses = session->new_audio_route (2, 2, 0, n_busses, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	if ((int) busses.size () != n_busses) {
+		cerr << argv[0] << ": could not create " << n_busses << " busses\n";
+		exit (EXIT_FAILURE);
+	}
+
+	pframes_t const nframes = session->engine().samples_per_cycle ();
+	/* enough automation for the two runs with each plugin */
+	framecnt_t const length = (framecnt_t) nframes * 2 * (cycles + 32);
+
+	session->request_transport_speed (1.0);
+	for (int i = 0; i < 32 && !session->transport_rolling (); ++i) {
+		session->process (nframes);
+	}
+	if (!session->transport_rolling ()) {
+		cerr << argv[0] << ": transport did not start\n";
+		exit (EXIT_FAILURE);
+	}
+
+	cout << "INFO: " << n_busses << " busses, " << cycles << " cycles of " << nframes << " samples.\n";
+
+	/* automation events per cycle */
+	for (pframes_t density = 1; density <= nframes / 4; density *= 4) {
+		framecnt_t const spacing = nframes / density;
+
+		add_automated_plugin (session, busses, split_amp, spacing, length);
+
+		Config->set_plugin_automation_events (false);
+		run_cycles (session, cycles, string_compose ("%1 events/cycle, split at every event", density));
+
+		Config->set_plugin_automation_events (true);
+		run_cycles (session, cycles, string_compose ("%1 events/cycle, split at most every %2 samples", density, Config->get_plugin_automation_min_block ()));
+
+		remove_plugins (busses);
+		add_automated_plugin (session, busses, event_amp, spacing, length);
+
+		Config->set_plugin_automation_events (true);
+		run_cycles (session, cycles, string_compose ("%1 events/cycle, parameter events", density));
+
+		remove_plugins (busses);
+	}
+
+	AudioEngine::instance()->remove_session ();
+	delete session;
+	AudioEngine::instance()->stop ();
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/port.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time the per-cycle passes of the port manager over all registered
+ *  ports (cycle start, cycle end and buffer flush) against the number of
+ *  ports. The engine is not started, and without a session a process
+ *  callback does nothing but these passes.
+ */
+
+static void
+register_ports (AudioEngine* engine, vector<boost::shared_ptr<Port> >& ports, int n_audio, int n_midi)
+{
+	Glib::Threads::Mutex::Lock lm (engine->process_lock ());
+
+	for (int i = 0; i < n_audio; ++i) {
+		if (i % 2) {
+			ports.push_back (engine->register_output_port (DataType::AUDIO, string_compose ("audio out %1", i)));
+		} else {
+			ports.push_back (engine->register_input_port (DataType::AUDIO, string_compose ("audio in %1", i)));
+		}
+	}
+	for (int i = 0; i < n_midi; ++i) {
+		if (i % 2) {
+			ports.push_back (engine->register_output_port (DataType::MIDI, string_compose ("midi out %1", i)));
+		} else {
+			ports.push_back (engine->register_input_port (DataType::MIDI, string_compose ("midi in %1", i)));
+		}
+	}
+}
+
+static void
+unregister_ports (AudioEngine* engine, vector<boost::shared_ptr<Port> >& ports)
+{
+	Glib::Threads::Mutex::Lock lm (engine->process_lock ());
+
+	for (vector<boost::shared_ptr<Port> >::iterator p = ports.begin (); p != ports.end (); ++p) {
+		engine->unregister_port (*p);
+	}
+	ports.clear ();
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const cycles = argc > 1 ? atoi (argv[1]) : 4096;
+	pframes_t const nframes = 256;
+
+	ARDOUR::init (false, true, localedir);
+
+	AudioEngine* engine = AudioEngine::create ();
+	if (!engine->set_backend ("None (Dummy)", "Profiling", "")) {
+		cerr << argv[0] << ": could not set up the dummy backend\n";
+		exit (EXIT_FAILURE);
+	}
+
+	for (int n_ports = 64; n_ports <= 2048; n_ports *= 2) {
+
+		vector<boost::shared_ptr<Port> > ports;
+		register_ports (engine, ports, n_ports - n_ports / 8, n_ports / 8);
+
+		TimingData timing;
+		timing.reserve (cycles);
+
+		/* warm up caches */
+		for (int i = 0; i < 64; ++i) {
+			engine->process_callback (nframes);
+		}
+
+		for (int i = 0; i < cycles; ++i) {
+			timing.start_timing ();
+			engine->process_callback (nframes);
+			timing.add_elapsed ();
+		}
+
+		uint64_t min, max, avg, total;
+		timing.get_min_max_avg_total (min, max, avg, total);
+		cout << ports.size () << " ports: per cycle (usecs) min: " << min << " max: " << max << " avg: " << avg << "\n";
+
+		unregister_ports (engine, ports);
+		engine->clear_pending_port_deletions ();
+	}
+
+	AudioEngine::destroy ();
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "pbd/timing.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/io.h"
+#include "ardour/port.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/send.h"
+#include "ardour/session.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time how long the session takes to bring its route graph up to date
+ *  after a single port connection or aux send changes, in a session with
+ *  many busses.
+ */
+
+static void
+report (string const & name, TimingData& timing)
+{
+	uint64_t min, max, avg, total;
+	timing.get_min_max_avg_total (min, max, avg, total);
+	cout << name << " (usecs) min: " << min << " max: " << max << " avg: " << avg << "\n";
+}
+
+/** Do what a backend does after making or breaking a connection */
+static void
+notify (boost::shared_ptr<Port> a, boost::shared_ptr<Port> b, bool yn)
+{
+	AudioEngine* engine = AudioEngine::instance ();
+	engine->connect_callback (engine->make_port_name_non_relative (a->name ()), engine->make_port_name_non_relative (b->name ()), yn);
+	engine->graph_order_callback ();
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const n_busses = argc > 1 ? atoi (argv[1]) : 400;
+	int const passes = argc > 2 ? atoi (argv[2]) : 64;
+
+	ARDOUR::init (false, true, localedir);
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	RouteList busses = session->new_audio_route (1, 1, 0, n_busses, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	vector<boost::shared_ptr<Route> > bus (busses.begin (), busses.end ());
+
+	if ((int) bus.size () != n_busses) {
+		cerr << argv[0] << ": could not create " << n_busses << " busses\n";
+		exit (EXIT_FAILURE);
+	}
+
+	cout << "INFO: " << session->get_routes()->size() << " routes.\n";
+
+	TimingData connect_timing;
+	TimingData disconnect_timing;
+	TimingData add_send_timing;
+	TimingData remove_send_timing;
+	TimingData full_timing;
+
+	for (int i = 0; i < passes; ++i) {
+
+		boost::shared_ptr<Route> from = bus[(i * 7) % n_busses];
+		boost::shared_ptr<Route> to = bus[(i * 7 + 1) % n_busses];
+		boost::shared_ptr<Port> out = from->output()->nth (0);
+		boost::shared_ptr<Port> in = to->input()->nth (0);
+
+		connect_timing.start_timing ();
+		out->connect (in->name ());
+		notify (out, in, true);
+		connect_timing.add_elapsed ();
+
+		disconnect_timing.start_timing ();
+		out->disconnect (in->name ());
+		notify (out, in, false);
+		disconnect_timing.add_elapsed ();
+
+		add_send_timing.start_timing ();
+		session->add_internal_send (to, from->before_processor_for_placement (PostFader), from);
+		add_send_timing.add_elapsed ();
+
+		boost::shared_ptr<Send> send = from->internal_send_for (to);
+		assert (send);
+
+		remove_send_timing.start_timing ();
+		from->remove_processor (send);
+		remove_send_timing.add_elapsed ();
+
+		/* for comparison, look at every route's connections afresh */
+		full_timing.start_timing ();
+		Config->ParameterChanged ("use-work-stealing-scheduler"); /* EMIT SIGNAL */
+		full_timing.add_elapsed ();
+	}
+
+	report ("connect", connect_timing);
+	report ("disconnect", disconnect_timing);
+	report ("add aux send", add_send_timing);
+	report ("remove aux send", remove_send_timing);
+	report ("full resort", full_timing);
+
+	AudioEngine::instance()->remove_session ();
+	delete session;
+	AudioEngine::instance()->stop ();
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <cstdlib>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "evoral/SMF.hpp"
+#include "evoral/midi_events.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+
+/** Time locates in MIDI files of increasing length (as in long controller
+ *  recordings), scanning from the start of the file as SMFSource used to
+ *  against the binary search of Evoral::SMF::seek_to_tick.
+ */
+
+static uint64_t
+scan_to_tick (Evoral::SMF& smf, uint64_t tick)
+{
+	uint64_t time    = 0;
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = 0;
+	Evoral::event_id_t id;
+
+	smf.seek_to_start ();
+	while (time < tick && smf.read_event (&delta_t, &size, &buf, &id) >= 0) {
+		time += delta_t;
+	}
+	free (buf);
+	return time;
+}
+
+static void
+report (string const & name, TimingData& timing)
+{
+	uint64_t min, max, avg, total;
+	timing.get_min_max_avg_total (min, max, avg, total);
+	cout << "\t" << name << ": per locate (usecs) min: " << min << " max: " << max << " avg: " << avg << "\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const locates = argc > 1 ? atoi (argv[1]) : 256;
+	uint32_t const spacing = 10; // ticks between events
+
+	string const dir = new_test_output_dir ("smf_locate");
+
+	for (uint32_t n_events = 1000; n_events <= 1000000; n_events *= 10) {
+
+		string const path = Glib::build_filename (dir, string_compose ("%1.mid", n_events));
+
+		{
+			Evoral::SMF smf;
+			if (smf.create (path) != 0) {
+				cerr << argv[0] << ": could not create " << path << "\n";
+				exit (EXIT_FAILURE);
+			}
+			smf.begin_write ();
+			for (uint32_t i = 0; i < n_events; ++i) {
+				uint8_t const cc[3] = { MIDI_CMD_CONTROL, 1, (uint8_t) (i % 128) };
+				smf.append_event_delta (spacing, 3, cc, -1);
+			}
+			smf.end_write (path);
+			smf.close ();
+		}
+
+		Evoral::SMF smf;
+		if (smf.open (path) != 0) {
+			cerr << argv[0] << ": could not open " << path << "\n";
+			exit (EXIT_FAILURE);
+		}
+
+		uint64_t const length = (uint64_t) n_events * spacing;
+
+		TimingData scan;
+		TimingData seek;
+		scan.reserve (locates);
+		seek.reserve (locates);
+
+		srandom (n_events);
+
+		for (int i = 0; i < locates; ++i) {
+			uint64_t const tick = (uint64_t) random () % length;
+
+			scan.start_timing ();
+			scan_to_tick (smf, tick);
+			scan.add_elapsed ();
+
+			seek.start_timing ();
+			smf.seek_to_tick (tick);
+			seek.add_elapsed ();
+		}
+
+		cout << n_events << " events:\n";
+		report ("scan from start", scan);
+		report ("seek to tick", seek);
+	}
+
+	return 0;
+}
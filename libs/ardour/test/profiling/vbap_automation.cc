@@ -0,0 +1,153 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "pbd/cartesian.h"
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
+#include "ardour/automation_control.h"
+#include "ardour/automation_list.h"
+#include "ardour/buffer_set.h"
+#include "ardour/pannable.h"
+#include "ardour/panner.h"
+#include "ardour/panner_manager.h"
+#include "ardour/session.h"
+#include "ardour/speakers.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time the VBAP panner distributing a number of mono objects to rings of
+ *  speakers of increasing size, with a fixed direction and with azimuth
+ *  automation, whose speaker gains are interpolated within each cycle.
+ */
+
+struct Object {
+	boost::shared_ptr<Pannable> pannable;
+	boost::shared_ptr<Panner> panner;
+};
+
+static void
+report (string const & name, TimingData& timing, int n_objects)
+{
+	uint64_t min, max, avg, total;
+	timing.get_min_max_avg_total (min, max, avg, total);
+	cout << "\t" << name << ": per cycle (usecs) min: " << min << " max: " << max << " avg: " << avg
+	     << ", per object " << (double) avg / n_objects << "\n";
+}
+
+static void
+run_cycles (vector<Object>& objects, BufferSet& inbufs, BufferSet& outbufs, pan_t** pan_buffers,
+            pframes_t nframes, int cycles, bool automated, TimingData& timing)
+{
+	for (int i = 0; i < cycles; ++i) {
+		framepos_t const start = (framepos_t) i * nframes;
+
+		outbufs.silence (nframes, 0);
+
+		timing.start_timing ();
+		for (vector<Object>::iterator o = objects.begin (); o != objects.end (); ++o) {
+			if (automated) {
+				o->panner->distribute_automated (inbufs, outbufs, start, start + nframes, nframes, pan_buffers);
+			} else {
+				o->panner->distribute (inbufs, outbufs, 1.0, nframes);
+			}
+		}
+		timing.add_elapsed ();
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	int const n_objects = argc > 1 ? atoi (argv[1]) : 64;
+	int const cycles = argc > 2 ? atoi (argv[2]) : 256;
+
+	ARDOUR::init (false, true, localedir);
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	PannerInfo* vbap = PannerManager::instance ().get_by_uri ("http://ardour.org/plugin/panner_vbap");
+	if (!vbap) {
+		cerr << argv[0] << ": could not find the VBAP panner\n";
+		exit (EXIT_FAILURE);
+	}
+
+	pframes_t const nframes = session->engine().samples_per_cycle ();
+	/* time for each object to go round the speakers once */
+	framecnt_t const period = (framecnt_t) nframes * 16;
+
+	cout << "INFO: " << n_objects << " objects, " << cycles << " cycles of " << nframes << " samples.\n";
+
+	for (uint32_t n_speakers = 4; n_speakers <= 64; n_speakers *= 2) {
+
+		boost::shared_ptr<Speakers> speakers (new Speakers);
+		for (uint32_t s = 0; s < n_speakers; ++s) {
+			speakers->add_speaker (AngularVector (s * 360.0 / n_speakers, 0.0));
+		}
+
+		vector<Object> objects (n_objects);
+
+		for (int i = 0; i < n_objects; ++i) {
+			Object& o (objects[i]);
+			o.pannable.reset (new Pannable (*session));
+			o.panner.reset (vbap->descriptor.factory (o.pannable, speakers));
+			o.panner->configure_io (ChanCount (DataType::AUDIO, 1), ChanCount (DataType::AUDIO, n_speakers));
+			o.panner->set_position ((double) i / n_objects);
+
+			boost::shared_ptr<AutomationList> al = o.pannable->pan_azimuth_control->alist ();
+			al->freeze ();
+			for (framepos_t t = 0; t <= (framepos_t) nframes * cycles; t += period) {
+				al->fast_simple_add (t, 0.0);
+				al->fast_simple_add (t + period - 1, 1.0);
+			}
+			al->thaw ();
+			o.pannable->set_automation_state (Play);
+		}
+
+		BufferSet inbufs;
+		inbufs.ensure_buffers (DataType::AUDIO, 1, nframes);
+		inbufs.set_count (ChanCount (DataType::AUDIO, 1));
+		Sample* const data = inbufs.get_audio (0).data ();
+		for (pframes_t n = 0; n < nframes; ++n) {
+			data[n] = (float) random () / RAND_MAX - 0.5f;
+		}
+
+		BufferSet outbufs;
+		outbufs.ensure_buffers (DataType::AUDIO, n_speakers, nframes);
+		outbufs.set_count (ChanCount (DataType::AUDIO, n_speakers));
+
+		vector<pan_t*> pan_buffers (n_speakers);
+		for (uint32_t s = 0; s < n_speakers; ++s) {
+			pan_buffers[s] = new pan_t[nframes];
+		}
+
+		TimingData fixed;
+		TimingData automated;
+		fixed.reserve (cycles);
+		automated.reserve (cycles);
+
+		run_cycles (objects, inbufs, outbufs, &pan_buffers[0], nframes, cycles, false, fixed);
+		run_cycles (objects, inbufs, outbufs, &pan_buffers[0], nframes, cycles, true, automated);
+
+		cout << n_speakers << " speakers:\n";
+		report ("fixed direction", fixed, n_objects);
+		report ("automated azimuth", automated, n_objects);
+
+		for (uint32_t s = 0; s < n_speakers; ++s) {
+			delete [] pan_buffers[s];
+		}
+	}
+
+	AudioEngine::instance()->remove_session ();
+	delete session;
+	AudioEngine::instance()->stop ();
+
+	return 0;
+}
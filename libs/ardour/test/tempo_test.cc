@@ -636,3 +636,83 @@ TempoTest::tempoFundamentalsTest ()
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (164.0, tE->quarter_notes_per_minute (), 1e-17);
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (41.0, tE->pulses_per_minute (), 1e-17);
 }
+
+/* Compare the lock-free, binary-searched lookups used by the public
+   conversion methods with the list-walking *_locked() ones they replace,
+   on a map with a few hundred ramped tempi, and time both.
+*/
+void
+TempoTest::indexedLookupTest ()
+{
+	int const sampling_rate = 48000;
+	int const n_tempi = 400;
+	int const n_lookups = 20000;
+
+	TempoMap map (sampling_rate);
+	map.replace_meter (map.first_meter(), Meter (4, 4), BBT_Time (1, 1, 0), 0, AudioTime);
+	map.replace_tempo (map.first_tempo(), Tempo (120.0, 4.0, 121.0), 0.0, 0, AudioTime);
+
+	/* a new ramp every whole note */
+	for (int n = 1; n < n_tempi; ++n) {
+		Tempo t (100.0 + (n % 37) * 2.0, 4.0, 100.0 + ((n + 1) % 37) * 2.0);
+		map.add_tempo (t, n, 0, MusicTime);
+	}
+
+	/* alternate between 3/4 and 4/4 every 16 bars */
+	double beat = 0.0;
+	uint32_t bar = 1;
+	for (int m = 1; m < n_tempi / 16; ++m) {
+		beat += 16 * ((m % 2) ? 4.0 : 3.0);
+		bar += 16;
+		map.add_meter (Meter ((m % 2) ? 3 : 4, 4), beat, BBT_Time (bar, 1, 0), 0, MusicTime);
+	}
+
+	framepos_t const end = map.frame_at_quarter_note (n_tempi * 4.0);
+	framecnt_t const step = end / n_lookups;
+
+	/* results must match those of the list walk exactly */
+
+	for (framepos_t f = 0; f < end; f += step) {
+		double const minute = map.minute_at_frame (f);
+		double const qn = map.quarter_note_at_frame (f);
+		double const beat = map.beat_at_frame (f);
+
+		{
+			Glib::Threads::RWLock::ReaderLock lm (map.lock);
+			CPPUNIT_ASSERT_EQUAL (map.pulse_at_minute_locked (map._metrics, minute) * 4.0, qn);
+			CPPUNIT_ASSERT_EQUAL (map.beat_at_minute_locked (map._metrics, minute), beat);
+			CPPUNIT_ASSERT_EQUAL (map.frame_at_minute (map.minute_at_pulse_locked (map._metrics, qn / 4.0)), map.frame_at_quarter_note (qn));
+			CPPUNIT_ASSERT_EQUAL (map.frame_at_minute (map.minute_at_beat_locked (map._metrics, beat)), map.frame_at_beat (beat));
+			CPPUNIT_ASSERT_EQUAL (map.pulse_at_beat_locked (map._metrics, beat) * 4.0, map.quarter_note_at_beat (beat));
+			CPPUNIT_ASSERT_EQUAL (map.beat_at_pulse_locked (map._metrics, qn / 4.0), map.beat_at_quarter_note (qn));
+			CPPUNIT_ASSERT_EQUAL (map.quarter_notes_between_frames_locked (map._metrics, f, f + step * 7), map.framewalk_to_qn (f, step * 7).to_double());
+		}
+	}
+
+	/* time them */
+
+	double locked_sum = 0.0;
+	double indexed_sum = 0.0;
+	microseconds_t before = get_microseconds ();
+
+	for (framepos_t f = 0; f < end; f += step) {
+		Glib::Threads::RWLock::ReaderLock lm (map.lock);
+		locked_sum += map.pulse_at_minute_locked (map._metrics, map.minute_at_frame (f)) * 4.0;
+		locked_sum += map.beat_at_minute_locked (map._metrics, map.minute_at_frame (f));
+	}
+
+	microseconds_t const locked = get_microseconds () - before;
+	before = get_microseconds ();
+
+	for (framepos_t f = 0; f < end; f += step) {
+		indexed_sum += map.quarter_note_at_frame (f);
+		indexed_sum += map.beat_at_frame (f);
+	}
+
+	microseconds_t const indexed = get_microseconds () - before;
+
+	CPPUNIT_ASSERT_EQUAL (locked_sum, indexed_sum);
+
+	std::cout << "\nTempoMap lookups with " << n_tempi << " tempi, " << n_lookups << " frames: list walk "
+	          << locked << " usecs, indexed " << indexed << " usecs\n";
+}
@@ -13,6 +13,7 @@ class TempoTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (rampTest44);
 	CPPUNIT_TEST (tempoAtPulseTest);
 	CPPUNIT_TEST (tempoFundamentalsTest);
+	CPPUNIT_TEST (indexedLookupTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -28,5 +29,6 @@ public:
 	void rampTest44 ();
 	void tempoAtPulseTest();
 	void tempoFundamentalsTest();
+	void indexedLookupTest();
 };
 
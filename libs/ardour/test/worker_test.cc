@@ -0,0 +1,89 @@
+#include <string.h>
+
+#include <glibmm/timer.h>
+
+#include "ardour/worker.h"
+
+#include "worker_test.h"
+
+using namespace ARDOUR;
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WorkerTest);
+
+/** Checks that its requests are executed one at a time, in order */
+class SequenceWorkee : public Workee
+{
+public:
+	SequenceWorkee () : next (0), busy (0), errors (0), responses (0) {}
+
+	int work (Worker& worker, uint32_t size, const void* data) {
+		if (!g_atomic_int_compare_and_exchange (&busy, 0, 1)) {
+			g_atomic_int_inc (&errors);
+		}
+		uint32_t n;
+		memcpy (&n, data, sizeof (n));
+		if (size != sizeof (n) || n != (uint32_t) g_atomic_int_get (&next)) {
+			g_atomic_int_inc (&errors);
+		}
+		worker.respond (sizeof (n), &n);
+		g_atomic_int_set (&busy, 0);
+		g_atomic_int_set (&next, n + 1);
+		return 0;
+	}
+
+	int work_response (uint32_t, const void*) {
+		++responses;
+		return 0;
+	}
+
+	volatile gint next;
+	volatile gint busy;
+	volatile gint errors;
+	uint32_t      responses;
+};
+
+void
+WorkerTest::poolOrderTest ()
+{
+	const uint32_t n_workers  = 16;
+	const uint32_t n_requests = 200;
+
+	WorkerPool::instance ().set_thread_count (4);
+	WorkerPool::instance ().reset_stats ();
+
+	SequenceWorkee workees[n_workers];
+	Worker*        workers[n_workers];
+	for (uint32_t w = 0; w < n_workers; ++w) {
+		workers[w] = new Worker (&workees[w], 4096);
+	}
+
+	/* interleave the requests of all workers, as the process threads would */
+	for (uint32_t n = 0; n < n_requests; ++n) {
+		for (uint32_t w = 0; w < n_workers; ++w) {
+			while (!workers[w]->schedule (sizeof (n), &n)) {
+				Glib::usleep (100);
+			}
+		}
+	}
+
+	for (uint32_t w = 0; w < n_workers; ++w) {
+		for (int i = 0; i < 5000 && (uint32_t) g_atomic_int_get (&workees[w].next) != n_requests; ++i) {
+			Glib::usleep (1000);
+		}
+		CPPUNIT_ASSERT_EQUAL (n_requests, (uint32_t) g_atomic_int_get (&workees[w].next));
+		CPPUNIT_ASSERT_EQUAL (0, (int) g_atomic_int_get (&workees[w].errors));
+
+		workers[w]->emit_responses ();
+		CPPUNIT_ASSERT_EQUAL (n_requests, workees[w].responses);
+	}
+
+	/* removing a worker waits for the thread serving it to finish */
+	for (uint32_t w = 0; w < n_workers; ++w) {
+		delete workers[w];
+	}
+
+	WorkerPool::Stats s = WorkerPool::instance ().stats ();
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) n_workers * n_requests, s.requests);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, s.queued);
+	CPPUNIT_ASSERT (s.max_queued <= n_workers);
+}
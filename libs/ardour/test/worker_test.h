@@ -0,0 +1,12 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class WorkerTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (WorkerTest);
+	CPPUNIT_TEST (poolOrderTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void poolOrderTest ();
+};
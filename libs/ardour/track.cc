@@ -18,6 +18,7 @@
 #include "pbd/error.h"
 
 #include "ardour/amp.h"
+#include "ardour/ardour.h"
 #include "ardour/debug.h"
 #include "ardour/delivery.h"
 #include "ardour/diskstream.h"
@@ -620,7 +621,33 @@ Track::capture_buffer_load () const
 int
 Track::do_refill ()
 {
-	return _diskstream->do_refill ();
+	microseconds_t const then = get_microseconds ();
+	int const ret = _diskstream->do_refill ();
+	microseconds_t const elapsed = get_microseconds () - then;
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 refill took %2 usecs\n", name(), elapsed));
+
+	Glib::Threads::Mutex::Lock lm (_refill_stats_lock);
+	_refill_stats.count++;
+	_refill_stats.last = elapsed;
+	_refill_stats.max = std::max (_refill_stats.max, elapsed);
+	_refill_stats.total += elapsed;
+
+	return ret;
+}
+
+Track::RefillStats
+Track::refill_stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_refill_stats_lock);
+	return _refill_stats;
+}
+
+void
+Track::reset_refill_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (_refill_stats_lock);
+	_refill_stats = RefillStats ();
 }
 
 int
@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include "ardour/vumeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float Vumeterdsp::_w;
@@ -45,8 +46,7 @@ void Vumeterdsp::process (float const *p, int n)
 
     z1 = _z1 > 20 ? 20 : (_z1 < -20 ? -20 : _z1);
     z2 = _z2 > 20 ? 20 : (_z2 < -20 ? -20 : _z2);
-    m = _res ? 0: _m;
-    _res = false;
+    m = start ();
 
     n /= 4;
     while (n--)
@@ -64,6 +64,51 @@ void Vumeterdsp::process (float const *p, int n)
 	if (z2 > m) m = z2;
     }
 
+    store (z1, z2, m);
+}
+
+
+void Vumeterdsp::process (Vumeterdsp * const *meters, float const * const *p, int n_meters, int n)
+{
+    const int lanes = ARDOUR::meter_lanes;
+    float z1 [ARDOUR::max_meter_lanes];
+    float z2 [ARDOUR::max_meter_lanes];
+    float m [ARDOUR::max_meter_lanes];
+    int   i = 0;
+
+    for (; i + lanes <= n_meters; i += lanes)
+    {
+	for (int c = 0; c < lanes; ++c)
+	{
+	    Vumeterdsp *k = meters [i + c];
+	    z1 [c] = k->_z1 > 20 ? 20 : (k->_z1 < -20 ? -20 : k->_z1);
+	    z2 [c] = k->_z2 > 20 ? 20 : (k->_z2 < -20 ? -20 : k->_z2);
+	    m [c] = k->start ();
+	}
+	ARDOUR::vumeter_process (p + i, n, z1, z2, m, _w);
+	for (int c = 0; c < lanes; ++c)
+	{
+	    meters [i + c]->store (z1 [c], z2 [c], m [c]);
+	}
+    }
+    for (; i < n_meters; ++i)
+    {
+	meters [i]->process (p [i], n);
+    }
+}
+
+
+float Vumeterdsp::start (void)
+{
+    // Maximum to continue from, 0 after read().
+    float m = _res ? 0: _m;
+    _res = false;
+    return m;
+}
+
+
+void Vumeterdsp::store (float z1, float z2, float m)
+{
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     _z1 = z1;
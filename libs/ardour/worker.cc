@@ -18,13 +18,21 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
-#include "ardour/worker.h"
-#include "pbd/error.h"
+#include <algorithm>
 
 #include <glibmm/timer.h>
 
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/rc_configuration.h"
+#include "ardour/worker.h"
+
+#include "pbd/i18n.h"
+
 namespace ARDOUR {
 
 Worker::Worker(Workee* workee, uint32_t ring_size, bool threaded)
@@ -32,23 +40,19 @@ Worker::Worker(Workee* workee, uint32_t ring_size, bool threaded)
 	, _requests(threaded ? new RingBuffer<uint8_t>(ring_size) : NULL)
 	, _responses(new RingBuffer<uint8_t>(ring_size))
 	, _response((uint8_t*)malloc(ring_size))
-	, _sem("worker_semaphore", 0)
-	, _thread(NULL)
-	, _exit(false)
 	, _synchronous(!threaded)
+	, _queued(0)
+	, _claimed(false)
 {
 	if (threaded) {
-		_thread = Glib::Threads::Thread::create(
-			sigc::mem_fun(*this, &Worker::run));
+		WorkerPool::instance().add(this);
 	}
 }
 
 Worker::~Worker()
 {
-	_exit = true;
-	_sem.signal();
-	if (_thread) {
-		_thread->join();
+	if (_requests) {
+		WorkerPool::instance().remove(this);
 	}
 	delete _responses;
 	delete _requests;
@@ -62,16 +66,21 @@ Worker::schedule(uint32_t size, const void* data)
 		_workee->work(*this, size, data);
 		return true;
 	}
-	if (_requests->write_space() < size + sizeof(size)) {
+	const int64_t now = g_get_monotonic_time();
+	if (_requests->write_space() < size + sizeof(size) + sizeof(now)) {
 		return false;
 	}
 	if (_requests->write((const uint8_t*)&size, sizeof(size)) != sizeof(size)) {
 		return false;
 	}
+	if (_requests->write((const uint8_t*)&now, sizeof(now)) != sizeof(now)) {
+		return false;
+	}
 	if (_requests->write((const uint8_t*)data, size) != size) {
 		return false;
 	}
-	_sem.signal();
+	/* the pool exists as long as there are threaded workers */
+	WorkerPool::_instance->queue(this);
 	return true;
 }
 
@@ -91,7 +100,7 @@ Worker::respond(uint32_t size, const void* data)
 }
 
 bool
-Worker::verify_message_completeness(RingBuffer<uint8_t>* rb)
+Worker::verify_message_completeness(RingBuffer<uint8_t>* rb, uint32_t header)
 {
 	uint32_t read_space = rb->read_space();
 	uint32_t size;
@@ -104,9 +113,9 @@ Worker::verify_message_completeness(RingBuffer<uint8_t>* rb)
 		memcpy (&size, vec.buf[0], sizeof (size));
 	} else {
 		memcpy (&size, vec.buf[0], vec.len[0]);
-		memcpy (&size + vec.len[0], vec.buf[1], sizeof(size) - vec.len[0]);
+		memcpy ((uint8_t*)&size + vec.len[0], vec.buf[1], sizeof(size) - vec.len[0]);
 	}
-	if (read_space < size+sizeof(size)) {
+	if (read_space < size + sizeof(size) + header) {
 		/* message from writer is yet incomplete. respond next cycle */
 		return false;
 	}
@@ -131,55 +140,273 @@ Worker::emit_responses()
 	}
 }
 
+bool
+Worker::work_next(void*& buf, size_t& buf_size, int64_t& latency)
+{
+	uint32_t size;
+	int64_t  when;
+
+	if (_requests->read_space() < sizeof(size)) {
+		PBD::error << "Worker: no work-data on ring buffer" << endmsg;
+		return false;
+	}
+	while (!verify_message_completeness(_requests, sizeof(when))) {
+		/* the audio thread is writing the request right now */
+		Glib::usleep(100);
+	}
+	if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
+		PBD::error << "Worker: Error reading size from request ring"
+		           << endmsg;
+		return false;
+	}
+	if (_requests->read((uint8_t*)&when, sizeof(when)) < sizeof(when)) {
+		PBD::error << "Worker: Error reading time from request ring"
+		           << endmsg;
+		return false;
+	}
+
+	if (size > buf_size) {
+		void* b = realloc(buf, size);
+		if (b) {
+			buf      = b;
+			buf_size = size;
+		} else {
+			PBD::error << "Worker: Error allocating memory"
+			           << endmsg;
+			_requests->increment_read_idx(size);
+			return false;
+		}
+	}
+
+	if (_requests->read((uint8_t*)buf, size) < size) {
+		PBD::error << "Worker: Error reading body from request ring"
+		           << endmsg;
+		return false;  // TODO: This is probably fatal
+	}
+
+	latency = g_get_monotonic_time() - when;
+	_workee->work(*this, size, buf);
+	return true;
+}
+
+WorkerPool* WorkerPool::_instance = 0;
+
+WorkerPool&
+WorkerPool::instance ()
+{
+	if (!_instance) {
+		_instance = new WorkerPool;
+	}
+	return *_instance;
+}
+
+void
+WorkerPool::destroy ()
+{
+	delete _instance;
+	_instance = 0;
+}
+
+WorkerPool::WorkerPool ()
+	: _next (0)
+	, _sem ("worker_pool", 0)
+	, _quit (false)
+	, _n_queued (0)
+	, _total_latency (0)
+{
+	set_thread_count (std::max (Config->get_plugin_worker_threads (), (uint32_t) 1));
+	Config->ParameterChanged.connect_same_thread (_config_connection, boost::bind (&WorkerPool::config_changed, this, _1));
+}
+
+WorkerPool::~WorkerPool ()
+{
+	_config_connection.disconnect ();
+	set_thread_count (0);
+}
+
+void
+WorkerPool::config_changed (std::string p)
+{
+	if (p == "plugin-worker-threads") {
+		set_thread_count (std::max (Config->get_plugin_worker_threads (), (uint32_t) 1));
+	}
+}
+
+uint32_t
+WorkerPool::thread_count () const
+{
+	return _threads.size ();
+}
+
+/** Start or stop threads so that there are @param n of them. Pending work
+ *  is kept, and executed by the new threads.
+ */
+void
+WorkerPool::set_thread_count (uint32_t n)
+{
+	if (n == _threads.size ()) {
+		return;
+	}
+
+	if (!_threads.empty ()) {
+		_quit = true;
+		for (uint32_t i = 0; i < _threads.size (); ++i) {
+			_sem.signal ();
+		}
+		for (std::vector<pthread_t>::iterator i = _threads.begin(); i != _threads.end(); ++i) {
+			void* status;
+			pthread_join (*i, &status);
+		}
+		_threads.clear ();
+		_quit = false;
+	}
+
+	for (uint32_t i = 0; i < n; ++i) {
+		pthread_t t;
+		if (pthread_create_and_store ("plugin worker", &t, _thread_work, this)) {
+			PBD::error << _("Could not create plugin worker thread") << endmsg;
+			break;
+		}
+		_threads.push_back (t);
+	}
+}
+
+WorkerPool::Stats
+WorkerPool::stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	Stats s (_stats);
+	s.queued = g_atomic_int_get (&_n_queued);
+	s.avg_latency = s.requests > 0 ? _total_latency / s.requests : 0;
+	return s;
+}
+
 void
-Worker::run()
+WorkerPool::reset_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_stats = Stats ();
+	_total_latency = 0;
+}
+
+void
+WorkerPool::add (Worker* w)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_workers.push_back (w);
+}
+
+/** Remove @param w from the pool, waiting until no thread is executing
+ *  its work. Requests it has not taken on yet are dropped.
+ */
+void
+WorkerPool::remove (Worker* w)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	while (w->_claimed) {
+		_idle.wait (_lock);
+	}
+	std::vector<Worker*>::iterator i = std::find (_workers.begin (), _workers.end (), w);
+	if (i != _workers.end ()) {
+		_workers.erase (i);
+	}
+	if (g_atomic_int_compare_and_exchange (&w->_queued, 1, 0)) {
+		/* its wakeup is left in the semaphore, and ignored */
+		g_atomic_int_add (&_n_queued, -1);
+	}
+	if (_next >= _workers.size ()) {
+		_next = 0;
+	}
+}
+
+/** Called from the audio thread when @param w has a new request. */
+void
+WorkerPool::queue (Worker* w)
+{
+	/* one wakeup for each worker with pending requests that no thread
+	 * has taken on. If it is already queued, or a thread is executing
+	 * its work, that thread will see the request (see thread_work ()).
+	 */
+	if (g_atomic_int_compare_and_exchange (&w->_queued, 0, 1)) {
+		g_atomic_int_add (&_n_queued, 1);
+		_sem.signal ();
+	}
+}
+
+void*
+WorkerPool::_thread_work (void* arg)
+{
+	pthread_set_name (X_("plugin worker"));
+	((WorkerPool*) arg)->thread_work ();
+	return 0;
+}
+
+void
+WorkerPool::thread_work ()
 {
 	void*  buf      = NULL;
 	size_t buf_size = 0;
+
 	while (true) {
-		_sem.wait();
-		if (_exit) {
-			free(buf);
-			return;
-		}
+		_sem.wait ();
 
-		uint32_t size = _requests->read_space();
-		if (size < sizeof(size)) {
-			PBD::error << "Worker: no work-data on ring buffer" << endmsg;
-			continue;
+		if (_quit) {
+			break;
 		}
-		while (!verify_message_completeness(_requests)) {
-			Glib::usleep(2000);
-			if (_exit) {
-				if (buf) free(buf);
-				return;
+
+		Worker* w = 0;
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			_stats.max_queued = std::max (_stats.max_queued, (uint32_t) g_atomic_int_get (&_n_queued));
+
+			/* round-robin over the workers, starting after the last one served */
+			const size_t n = _workers.size ();
+			for (size_t i = 0; i < n; ++i) {
+				Worker* c = _workers[(_next + i) % n];
+				if (!c->_claimed && g_atomic_int_get (&c->_queued)) {
+					w = c;
+					_next = (_next + i + 1) % n;
+					break;
+				}
 			}
-		}
-		if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
-			PBD::error << "Worker: Error reading size from request ring"
-			           << endmsg;
-			continue;
+			if (!w) {
+				/* wakeup for a worker that has since been removed */
+				continue;
+			}
+			w->_claimed = true;
 		}
 
-		if (size > buf_size) {
-			buf = realloc(buf, size);
-			if (buf) {
-				buf_size = size;
-			} else {
-				PBD::error << "Worker: Error allocating memory"
-				           << endmsg;
-				buf_size = 0; // TODO: This is probably fatal
-			}
+		/* execute one request, then give other workers a turn */
+		int64_t latency = 0;
+		const bool ok = w->work_next (buf, buf_size, latency);
+
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		if (ok) {
+			++_stats.requests;
+			_total_latency += latency;
+			_stats.max_latency = std::max (_stats.max_latency, (uint64_t) latency);
 		}
 
-		if (_requests->read((uint8_t*)buf, size) < size) {
-			PBD::error << "Worker: Error reading body from request ring"
-			           << endmsg;
-			continue;  // TODO: This is probably fatal
+		if (w->_requests->read_space () > 0) {
+			/* still queued, wake up a thread for its next request */
+			_sem.signal ();
+		} else {
+			g_atomic_int_set (&w->_queued, 0);
+			g_atomic_int_add (&_n_queued, -1);
+			/* a request may have been written after the check above,
+			 * while _queued was still set */
+			if (w->_requests->read_space () > 0 && g_atomic_int_compare_and_exchange (&w->_queued, 0, 1)) {
+				g_atomic_int_add (&_n_queued, 1);
+				_sem.signal ();
+			}
 		}
 
-		_workee->work(*this, size, buf);
+		w->_claimed = false;
+		_idle.broadcast ();
 	}
+
+	free (buf);
 }
 
 } // namespace ARDOUR
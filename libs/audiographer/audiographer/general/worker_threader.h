@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef AUDIOGRAPHER_WORKER_THREADER_H
+#define AUDIOGRAPHER_WORKER_THREADER_H
+
+#include <glib.h>
+#include <vector>
+#include <algorithm>
+
+#include <glibmm/threads.h>
+
+#include "pbd/semutils.h"
+
+#include "audiographer/visibility.h"
+#include "audiographer/source.h"
+#include "audiographer/sink.h"
+#include "audiographer/exception.h"
+#include "audiographer/general/threader.h"
+
+namespace AudioGrapher
+{
+
+/** Threads that stay around to run the outputs of WorkerThreaders.
+  * The threads serve one WorkerThreader at a time. A WorkerThreader
+  * processed while they are busy (e.g. from one of the outputs of another
+  * one) runs its outputs in the calling thread.
+  */
+class LIBAUDIOGRAPHER_API WorkerThreads
+{
+  public:
+	/// Work shared between the calling thread and woken worker threads
+	class Job
+	{
+	  public:
+		virtual ~Job () {}
+
+		/// Runs tasks of the job until there are none left, called once by each woken thread
+		virtual void run () = 0;
+	};
+
+	/** Constructor, starts the threads
+	  * \n Not RT safe
+	  * \param n_threads number of threads, besides the thread processing the WorkerThreaders
+	  */
+	WorkerThreads (unsigned int n_threads);
+
+	/// Stops the threads, which must not be running a job \n Not RT safe
+	~WorkerThreads ();
+
+	/// \return number of threads
+	unsigned int size () const { return threads.size (); }
+
+	/** Wakes \a n_threads threads to run \a job.
+	  * \n RT safe
+	  * \return false if the threads are busy with another job
+	  */
+	bool start (Job * job, unsigned int n_threads);
+
+	/// Makes the threads free for another job, once all threads woken by start() returned from Job::run() \n RT safe
+	void finish (Job * job);
+
+  private:
+	void thread_main ();
+
+	std::vector<Glib::Threads::Thread *> threads;
+	PBD::Semaphore wakeup;
+	gpointer job;
+	gint     quit;
+};
+
+/** Class for distributing processing across the threads of WorkerThreads.
+  * Unlike Threader, nothing is allocated or locked per process() call:
+  * the outputs are the tasks, taken in turn by the calling thread and
+  * the worker threads, and the calling thread waits on a barrier for the
+  * threads it woke.
+  */
+template <typename T = DefaultSampleType>
+class /*LIBAUDIOGRAPHER_API*/ WorkerThreader
+  : public Source<T>
+  , public Sink<T>
+  , private WorkerThreads::Job
+{
+  private:
+	typedef std::vector<typename Source<T>::SinkPtr> OutputVec;
+
+  public:
+
+	/** Constructor
+	  * \n Not RT safe
+	  * \param workers the threads which run outputs besides the thread calling process()
+	  */
+	WorkerThreader (WorkerThreads & workers)
+	  : workers (workers)
+	  , context (0)
+	  , next_task (0)
+	  , participants (0)
+	  , done ("worker threader", 0)
+	  , exception (0)
+	{ }
+
+	virtual ~WorkerThreader () { delete (ThreaderException *) exception; }
+
+	/// Adds output \n RT safe
+	void add_output (typename Source<T>::SinkPtr output) { outputs.push_back (output); }
+
+	/// Clears outputs \n RT safe
+	void clear_outputs () { outputs.clear (); }
+
+	/// Removes a specific output \n RT safe
+	void remove_output (typename Source<T>::SinkPtr output) {
+		typename OutputVec::iterator new_end = std::remove(outputs.begin(), outputs.end(), output);
+		outputs.erase (new_end, outputs.end());
+	}
+
+	/// Processes context concurrently, each output in either the calling thread or a worker thread
+	void process (ProcessContext<T> const & c)
+	{
+		unsigned int const outs = outputs.size ();
+		if (outs == 0) {
+			return;
+		}
+
+		context = &c;
+		g_atomic_int_set (&next_task, 0);
+
+		/* the calling thread takes a task too */
+		unsigned int helpers = std::min (outs - 1, workers.size ());
+		g_atomic_int_set (&participants, helpers + 1);
+
+		if (helpers > 0 && !workers.start (this, helpers)) {
+			helpers = 0;
+			g_atomic_int_set (&participants, 1);
+		}
+
+		run_tasks ();
+
+		/* barrier: the last participant to finish lets the calling thread go on */
+		if (!g_atomic_int_dec_and_test (&participants)) {
+			done.wait ();
+		}
+
+		if (helpers > 0) {
+			workers.finish (this);
+		}
+
+		context = 0;
+
+		if (exception) {
+			ThreaderException e (*(ThreaderException *) exception);
+			delete (ThreaderException *) exception;
+			exception = 0;
+			throw e;
+		}
+	}
+
+	using Sink<T>::process;
+
+  private:
+
+	void run ()
+	{
+		run_tasks ();
+
+		if (g_atomic_int_dec_and_test (&participants)) {
+			done.signal ();
+		}
+	}
+
+	void run_tasks ()
+	{
+		unsigned int const outs = outputs.size ();
+
+		for (unsigned int i = g_atomic_int_add (&next_task, 1); i < outs; i = g_atomic_int_add (&next_task, 1)) {
+			try {
+				outputs[i]->process (*context);
+			} catch (std::exception const & e) {
+				// Only first exception will be passed on
+				ThreaderException * te = new ThreaderException (*this, e);
+				if (!g_atomic_pointer_compare_and_exchange (&exception, (gpointer) 0, (gpointer) te)) {
+					delete te;
+				}
+			}
+		}
+	}
+
+	OutputVec outputs;
+
+	WorkerThreads &           workers;
+	ProcessContext<T> const * context;
+	gint                      next_task;
+	gint                      participants;
+	PBD::Semaphore            done;
+	gpointer                  exception;
+};
+
+} // namespace
+
+#endif //AUDIOGRAPHER_WORKER_THREADER_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "audiographer/general/worker_threader.h"
+
+namespace AudioGrapher
+{
+
+WorkerThreads::WorkerThreads (unsigned int n_threads)
+	: wakeup ("audiographer workers", 0)
+	, job (0)
+	, quit (0)
+{
+	for (unsigned int i = 0; i < n_threads; ++i) {
+		threads.push_back (Glib::Threads::Thread::create (sigc::mem_fun (*this, &WorkerThreads::thread_main)));
+	}
+}
+
+WorkerThreads::~WorkerThreads ()
+{
+	g_atomic_int_set (&quit, 1);
+
+	for (unsigned int i = 0; i < threads.size (); ++i) {
+		wakeup.signal ();
+	}
+	for (std::vector<Glib::Threads::Thread *>::iterator i = threads.begin (); i != threads.end (); ++i) {
+		(*i)->join ();
+	}
+}
+
+bool
+WorkerThreads::start (Job * j, unsigned int n_threads)
+{
+	if (!g_atomic_pointer_compare_and_exchange (&job, (gpointer) 0, (gpointer) j)) {
+		return false;
+	}
+
+	n_threads = std::min (n_threads, size ());
+	for (unsigned int i = 0; i < n_threads; ++i) {
+		wakeup.signal ();
+	}
+	return true;
+}
+
+void
+WorkerThreads::finish (Job * j)
+{
+	g_atomic_pointer_compare_and_exchange (&job, (gpointer) j, (gpointer) 0);
+}
+
+void
+WorkerThreads::thread_main ()
+{
+	while (true) {
+		wakeup.wait ();
+
+		if (g_atomic_int_get (&quit)) {
+			return;
+		}
+
+		/* the job stays until every thread woken for it is done */
+		((Job *) g_atomic_pointer_get (&job))->run ();
+	}
+}
+
+} // namespace
@@ -0,0 +1,104 @@
+#include <sys/time.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <glibmm/thread.h>
+
+#include "audiographer/general/threader.h"
+#include "audiographer/general/worker_threader.h"
+
+#include "tests/utils.h"
+
+using namespace std;
+using namespace AudioGrapher;
+
+/** Compare the throughput of Threader (a task pushed to a Glib::ThreadPool
+  * per output per chunk, waiting on a condition) with WorkerThreader
+  * (persistent threads, a barrier) across chunk sizes, for a threader with
+  * as many outputs as an export with many formats per channel
+  * configuration has.
+  */
+
+/// Stands in for the per-format work: gain and peak of the chunk
+class WorkSink : public Sink<float>
+{
+  public:
+	WorkSink () : peak (0) {}
+
+	void process (ProcessContext<float> const & c)
+	{
+		float const * data = c.data ();
+		for (framecnt_t i = 0; i < c.frames (); ++i) {
+			peak = max (peak, fabsf (data[i] * 0.5f));
+		}
+	}
+	using Sink<float>::process;
+
+	float peak;
+};
+
+static double
+seconds_since (timeval const & start)
+{
+	timeval now;
+	gettimeofday (&now, 0);
+	return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1e6;
+}
+
+template <typename ThreaderT>
+static double
+frames_per_second (ThreaderT & threader, float * data, framecnt_t chunk, framecnt_t total)
+{
+	ProcessContext<float> c (data, chunk, 1);
+
+	timeval start;
+	gettimeofday (&start, 0);
+
+	for (framecnt_t done = 0; done < total; done += chunk) {
+		threader.process (c);
+	}
+
+	return total / seconds_since (start);
+}
+
+int main (int argc, char* argv[])
+{
+	int const n_outputs = argc > 1 ? atoi (argv[1]) : 16;
+	int const n_threads = max (1, argc > 2 ? atoi (argv[2]) : 4);
+	framecnt_t const total = 1 << 23;
+
+	Glib::thread_init ();
+
+	float * data = TestUtils::init_random_data (8192, 1.0);
+
+	/* Threader's thread pool does all the work, the calling thread
+	 * waits. WorkerThreader's calling thread works too.
+	 */
+	Glib::ThreadPool thread_pool (n_threads);
+	WorkerThreads workers (n_threads - 1);
+
+	Threader<float> threader (thread_pool);
+	WorkerThreader<float> worker_threader (workers);
+
+	for (int i = 0; i < n_outputs; ++i) {
+		boost::shared_ptr<WorkSink> sink (new WorkSink);
+		threader.add_output (sink);
+		worker_threader.add_output (sink);
+	}
+
+	cout << n_outputs << " outputs, " << n_threads << " threads, frames/s:\n";
+
+	for (framecnt_t chunk = 64; chunk <= 8192; chunk *= 2) {
+		double const pooled = frames_per_second (threader, data, chunk, total);
+		double const persistent = frames_per_second (worker_threader, data, chunk, total);
+
+		cout << chunk << " frames: Threader " << pooled << ", WorkerThreader " << persistent
+		     << " (" << persistent / pooled << "x)\n";
+	}
+
+	thread_pool.shutdown ();
+	delete [] data;
+
+	return 0;
+}
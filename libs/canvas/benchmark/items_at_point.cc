@@ -1,5 +1,5 @@
 #include <sys/time.h>
-#include "canvas/group.h"
+#include "canvas/container.h"
 #include "canvas/canvas.h"
 #include "canvas/root_group.h"
 #include "canvas/rectangle.h"
@@ -9,9 +9,9 @@ using namespace std;
 using namespace ArdourCanvas;
 
 static void
-test (int items_per_cell)
+test (uint32_t tree_lookup_threshold)
 {
-	Group::default_items_per_cell = items_per_cell;
+	Item::tree_lookup_threshold = tree_lookup_threshold;
 
 	int const n_rectangles = 10000;
 	int const n_tests = 1000;
@@ -37,9 +37,10 @@ test (int items_per_cell)
 
 int main ()
 {
-	int tests[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+	/* look at every item, or find them in a TreeLookupTable */
+	uint32_t tests[] = { 1000000, 0 };
 
-	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
+	for (unsigned int i = 0; i < sizeof (tests) / sizeof (uint32_t); ++i) {
 		timeval start;
 		timeval stop;
 
@@ -56,7 +57,7 @@ int main ()
 
 		double seconds = sec + ((double) usec / 1e6);
 
-		cout << "Test " << tests[i] << ": " << seconds << "\n";
+		cout << (tests[i] ? "DumbLookupTable" : "TreeLookupTable") << ": " << seconds << "\n";
 	}
 }
 
@@ -2,7 +2,7 @@
 #include <pangomm/init.h>
 #include "pbd/compose.h"
 #include "pbd/xml++.h"
-#include "canvas/group.h"
+#include "canvas/container.h"
 #include "canvas/canvas.h"
 #include "canvas/root_group.h"
 #include "canvas/rectangle.h"
@@ -16,22 +16,12 @@ class RenderParts : public Benchmark
 public:
 	RenderParts (string const & session) : Benchmark (session) {}
 
-	void set_items_per_cell (int items)
-	{
-		_items_per_cell = items;
-	}
-
 	void do_run (ImageCanvas& canvas)
 	{
-		Group::default_items_per_cell = _items_per_cell;
-
 		for (int i = 0; i < 1e4; i += 50) {
 			canvas.render_to_image (Rect (i, 0, i + 50, 1024));
 		}
 	}
-
-private:
-	int _items_per_cell;
 };
 
 int main (int argc, char* argv[])
@@ -43,12 +33,15 @@ int main (int argc, char* argv[])
 
 	Pango::init ();
 
-	RenderParts render_parts (argv[1]);
-
-	int tests[] = { 16, 32, 64, 128, 256, 512, 1024, 1e4, 1e5, 1e6 };
+	/* from finding the children of every item in a TreeLookupTable to
+	 * looking at each of them
+	 */
+	uint32_t tests[] = { 0, 16, 32, 64, 128, 256, 512, 1024, 1000000 };
 
-	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
-		render_parts.set_items_per_cell (tests[i]);
+	for (unsigned int i = 0; i < sizeof (tests) / sizeof (uint32_t); ++i) {
+		/* lookup tables are made when first needed, so use a new canvas */
+		Item::tree_lookup_threshold = tests[i];
+		RenderParts render_parts (argv[1]);
 		cout << tests[i] << " " << render_parts.run () << "\n";
 	}
 
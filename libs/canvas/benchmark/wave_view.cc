@@ -0,0 +1,187 @@
+#include <sys/time.h>
+#include <iostream>
+#include <cstdlib>
+
+#include <glibmm/timer.h>
+#include <pangomm/init.h>
+
+#include "pbd/compose.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/audioregion.h"
+#include "ardour/region_factory.h"
+#include "ardour/session.h"
+#include "ardour/session_event.h"
+
+#include "canvas/canvas.h"
+#include "canvas/root_group.h"
+#include "canvas/wave_view.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace ArdourCanvas;
+
+/** Time how long the WaveView drawing threads take to render the images
+ *  for many waveviews (as when zooming a session with many tracks) with
+ *  different numbers of threads, and how much of that is saved by
+ *  dropping requests for zoom levels that were left before they were
+ *  drawn, then how much of the work the image cache saves when going
+ *  back to zoom levels that were drawn before.
+ */
+
+static double
+seconds_since (timeval const & start)
+{
+	timeval now;
+	gettimeofday (&now, 0);
+	return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1e6;
+}
+
+static void
+wait_for_images ()
+{
+	while (WaveView::pending_drawing_requests () > 0) {
+		Glib::usleep (100);
+	}
+}
+
+static void
+zoom (vector<WaveView*>& views, ImageCanvas& canvas, double spp)
+{
+	for (vector<WaveView*>::iterator i = views.begin(); i != views.end(); ++i) {
+		(*i)->set_samples_per_pixel (spp);
+	}
+	/* queues a request for every waveview */
+	canvas.render_to_image (Rect (0, 0, 2048, 2048));
+}
+
+int main (int argc, char* argv[])
+{
+	if (argc < 3) {
+		cerr << "Syntax: wave_view <session-dir> <snapshot-name> [waveviews] [zoom-steps]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	int const n_views = argc > 3 ? atoi (argv[3]) : 100;
+	int const n_zooms = argc > 4 ? atoi (argv[4]) : 16;
+
+	Pango::init ();
+	ARDOUR::init (false, true, 0);
+	SessionEvent::create_per_thread_pool ("benchmark", 512);
+
+	AudioEngine* engine = AudioEngine::create ();
+	if (!engine->set_backend ("None (Dummy)", "Benchmark", "")) {
+		cerr << "Could not set up the dummy backend\n";
+		exit (EXIT_FAILURE);
+	}
+	init_post_engine ();
+	if (engine->start () != 0) {
+		cerr << "Could not start the dummy backend\n";
+		exit (EXIT_FAILURE);
+	}
+
+	Session* session = new Session (*engine, argv[1], argv[2]);
+	engine->set_session (session);
+
+	boost::shared_ptr<AudioRegion> region;
+	RegionFactory::RegionMap const regions (RegionFactory::all_regions ());
+	for (RegionFactory::RegionMap::const_iterator r = regions.begin(); r != regions.end() && !region; ++r) {
+		region = boost::dynamic_pointer_cast<AudioRegion> (r->second);
+	}
+	if (!region) {
+		cerr << "Session has no audio regions\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ImageCanvas canvas (Duple (2048, 2048));
+	Coord const height = 2048.0 / n_views;
+
+	vector<WaveView*> views;
+	for (int i = 0; i < n_views; ++i) {
+		WaveView* wv = new WaveView (canvas.root(), region);
+		wv->set_position (Duple (0, i * height));
+		wv->set_height (height);
+		views.push_back (wv);
+	}
+
+	/* every zoom level is used once only, so nothing comes from the cache */
+	double spp = 64;
+
+	int const threads[] = { 1, 2, 4, 8 };
+
+	for (unsigned int t = 0; t < sizeof (threads) / sizeof (int); ++t) {
+
+		WaveView::set_drawing_thread_count (threads[t]);
+
+		timeval start;
+		gettimeofday (&start, 0);
+
+		for (int z = 0; z < n_zooms; ++z) {
+			zoom (views, canvas, ++spp);
+			wait_for_images ();
+		}
+
+		double const all = seconds_since (start);
+
+		/* zoom through all levels without waiting, only the last one
+		 * needs to be drawn.
+		 */
+
+		gettimeofday (&start, 0);
+
+		for (int z = 0; z < n_zooms; ++z) {
+			zoom (views, canvas, ++spp);
+		}
+		wait_for_images ();
+
+		double const last = seconds_since (start);
+
+		cout << threads[t] << " threads: "
+		     << (n_views * n_zooms) / all << " images/s, "
+		     << n_zooms << " zoom steps in " << all << "s waiting for each, "
+		     << last << "s without waiting\n";
+	}
+
+	/* zoom through some levels twice, drawing the finished images (which
+	 * puts them in the cache). The second time round they come from the
+	 * cache as long as they fit in it.
+	 */
+
+	for (int pass = 0; pass < 2; ++pass) {
+
+		WaveViewCache::Stats const before (WaveView::image_cache_stats ());
+
+		timeval start;
+		gettimeofday (&start, 0);
+
+		for (int z = 0; z < n_zooms; ++z) {
+			zoom (views, canvas, spp + z);
+			wait_for_images ();
+			canvas.render_to_image (Rect (0, 0, 2048, 2048));
+		}
+
+		double const elapsed = seconds_since (start);
+
+		WaveViewCache::Stats const after (WaveView::image_cache_stats ());
+
+		cout << "pass " << pass + 1 << ": " << n_zooms << " zoom steps in " << elapsed << "s, cache: "
+		     << after.hits - before.hits << " hits, "
+		     << after.partial_hits - before.partial_hits << " partial hits, "
+		     << after.misses - before.misses << " misses, "
+		     << after.evictions - before.evictions << " evictions, "
+		     << after.entries << " images in " << after.size / 1048576 << " MB\n";
+	}
+
+	WaveView::stop_drawing_thread ();
+
+	for (vector<WaveView*>::iterator i = views.begin(); i != views.end(); ++i) {
+		delete *i;
+	}
+
+	engine->remove_session ();
+	delete session;
+	engine->stop ();
+
+	return 0;
+}
@@ -212,9 +212,13 @@ public:
 	void raise_child_to_top (Item *);
 	void raise_child (Item *, int);
 	void lower_child_to_bottom (Item *);
-	virtual void child_changed ();
+	virtual void child_changed (Item*);
 
 	static int default_items_per_cell;
+	/** Items with more children than this find them in a TreeLookupTable,
+	 *  others look at each of them.
+	 */
+	static uint32_t tree_lookup_threshold;
 
 
 	/* This is a sigc++ signal because it is solely
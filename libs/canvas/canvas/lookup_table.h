@@ -20,6 +20,7 @@
 #ifndef __CANVAS_LOOKUP_TABLE_H__
 #define __CANVAS_LOOKUP_TABLE_H__
 
+#include <map>
 #include <vector>
 #include <boost/multi_array.hpp>
 
@@ -42,6 +43,11 @@ public:
     virtual std::vector<Item*> items_at_point (Duple const &) const = 0;
     virtual bool has_item_at_point (Duple const & point) const = 0;
 
+    /** Called when the bounding box of one of our item's children
+     *  (or its position) may have changed.
+     */
+    virtual void child_changed (Item*) {}
+
 protected:
 
     Item const & _item;
@@ -57,6 +63,53 @@ public:
     bool has_item_at_point (Duple const & point) const;
 };
 
+/** A bounding volume hierarchy over the bounding boxes of the children
+ *  of an item, built when it is first needed. Changes of children are
+ *  applied lazily, by refitting the nodes above them before the next
+ *  lookup; the tree is rebuilt once more children were refitted than
+ *  there are children, since their boxes may have moved far apart.
+ */
+class LIBCANVAS_API TreeLookupTable : public LookupTable
+{
+public:
+    TreeLookupTable (Item const &);
+
+    std::vector<Item*> get (Rect const &);
+    std::vector<Item*> items_at_point (Duple const &) const;
+    bool has_item_at_point (Duple const & point) const;
+
+    void child_changed (Item*);
+
+private:
+    struct Node {
+	    Rect bbox;     /* in our item's coordinates */
+	    bool empty;    /* no child below this node has a bounding box */
+	    bool dirty;    /* leaves only: waiting to be refitted */
+	    int32_t parent;
+	    int32_t left;  /* -1 for leaves */
+	    int32_t right;
+	    Item* item;    /* leaves only */
+	    int32_t order; /* leaves only: stacking position of the item */
+    };
+
+    struct Leaf;
+    struct LeafCompare;
+
+    mutable std::vector<Node> _nodes;
+    mutable std::map<Item*, int32_t> _leaves;
+    mutable std::vector<int32_t> _dirty;
+    mutable uint32_t _refits;
+    mutable bool _built;
+
+    void update () const;
+    void build () const;
+    int32_t build (std::vector<Leaf>&, size_t, size_t, int32_t) const;
+    void refit (int32_t) const;
+    Rect to_item (Rect const &) const;
+    Duple to_item (Duple const &) const;
+    void find (Rect const &, std::vector<std::pair<int32_t, Item*> >&) const;
+};
+
 class LIBCANVAS_API OptimizingLookupTable : public LookupTable
 {
 public:
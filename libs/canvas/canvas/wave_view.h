@@ -21,6 +21,10 @@
 #ifndef __CANVAS_WAVE_VIEW_H__
 #define __CANVAS_WAVE_VIEW_H__
 
+#include <map>
+#include <set>
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/shared_array.hpp>
 #include <boost/scoped_array.hpp>
@@ -57,7 +61,7 @@ struct LIBCANVAS_API WaveViewThreadRequest
 	        Draw
         };
 
-	WaveViewThreadRequest  () : stop (0) {}
+	WaveViewThreadRequest  () : visible (true), sequence (0), stop (0) {}
 
 	bool should_stop () const { return (bool) g_atomic_int_get (const_cast<gint*>(&stop)); }
 	void cancel() { g_atomic_int_set (&stop, 1); }
@@ -73,6 +77,12 @@ struct LIBCANVAS_API WaveViewThreadRequest
 	Color      fill_color;
 	boost::weak_ptr<const ARDOUR::Region> region;
 
+	/* drawing threads serve requests of items that were visible when
+	   the request was made first, and newer requests before older ones.
+	*/
+	bool       visible;
+	uint64_t   sequence;
+
 	/* resulting image, after request has been satisfied */
 
 	Cairo::RefPtr<Cairo::ImageSurface> image;
@@ -89,6 +99,43 @@ class LIBCANVAS_API WaveViewCache
 	WaveViewCache();
 	~WaveViewCache();
 
+	struct Entry;
+
+  private:
+	/* the properties that make images interchangeable: images with the
+	   same LineKey differ only in the range of the source they show.
+	   Global properties (shape, log scaling) are not part of the key,
+	   the cache is cleared when they change.
+	*/
+	struct LineKey {
+		LineKey (boost::shared_ptr<ARDOUR::AudioSource> s, int chan, Coord hght, float amp, Color fcl, double spp)
+			: source (s), channel (chan), height (hght), amplitude (amp), fill_color (fcl), samples_per_pixel (spp) {}
+
+		boost::shared_ptr<ARDOUR::AudioSource> source;
+		int channel;
+		Coord height;
+		float amplitude;
+		Color fill_color;
+		double samples_per_pixel;
+
+		bool operator< (LineKey const & other) const {
+			if (source != other.source) { return source < other.source; }
+			if (channel != other.channel) { return channel < other.channel; }
+			if (height != other.height) { return height < other.height; }
+			if (amplitude != other.amplitude) { return amplitude < other.amplitude; }
+			if (fill_color != other.fill_color) { return fill_color < other.fill_color; }
+			return samples_per_pixel < other.samples_per_pixel;
+		}
+	};
+
+	/* the images of one LineKey, indexed by start. No image in a line
+	   is contained in another one (see ::add()), so their ends increase
+	   along with their starts.
+	*/
+	typedef std::map<framepos_t, boost::shared_ptr<Entry> > CacheLine;
+	typedef std::map<LineKey, CacheLine> ImageCache;
+
+  public:
 	struct Entry {
 
 		/* these properties define the cache entry as unique.
@@ -112,9 +159,6 @@ class LIBCANVAS_API WaveViewCache
 
 		Cairo::RefPtr<Cairo::ImageSurface> image;
 
-		/* last time the cache entry was used */
-		uint64_t timestamp;
-
 		Entry (int chan, Coord hght, float amp, Color fcl, double spp, framepos_t strt, framepos_t ed,
 		       Cairo::RefPtr<Cairo::ImageSurface> img)
 			: channel (chan)
@@ -124,23 +168,47 @@ class LIBCANVAS_API WaveViewCache
 			, samples_per_pixel (spp)
 			, start (strt)
 			, end (ed)
-			, image (img) {}
+			, image (img)
+			, cached (false)
+			, size (0)
+			, lru_prev (0)
+			, lru_next (0) {}
+
+	  private:
+		friend class WaveViewCache;
+
+		/* the rest is valid only while the entry is in the cache */
+
+		bool cached;
+		uint64_t size; /* bytes */
+		ImageCache::iterator line;
+
+		/* intrusive LRU list, most recently used first */
+		Entry* lru_prev;
+		Entry* lru_next;
+	};
+
+	struct Stats {
+		Stats () : hits (0), partial_hits (0), misses (0), evictions (0), entries (0), size (0) {}
+
+		uint64_t hits;         /* lookups finding an image for the whole range */
+		uint64_t partial_hits; /* lookups finding an image for its start */
+		uint64_t misses;
+		uint64_t evictions;    /* images removed to stay below the threshold */
+		uint64_t entries;
+		uint64_t size;         /* bytes */
 	};
 
 	uint64_t image_cache_threshold () const { return _image_cache_threshold; }
 	void set_image_cache_threshold (uint64_t);
 	void clear_cache ();
 
+	Stats stats () const;
+	void reset_stats ();
+
 	void add (boost::shared_ptr<ARDOUR::AudioSource>, boost::shared_ptr<Entry>);
 	void use (boost::shared_ptr<ARDOUR::AudioSource>, boost::shared_ptr<Entry>);
 
-        void consolidate_image_cache (boost::shared_ptr<ARDOUR::AudioSource>,
-                                      int channel,
-                                      Coord height,
-                                      float amplitude,
-                                      Color fill_color,
-                                      double samples_per_pixel);
-
         boost::shared_ptr<Entry> lookup_image (boost::shared_ptr<ARDOUR::AudioSource>,
                                                framepos_t start, framepos_t end,
                                                int _channel,
@@ -151,35 +219,19 @@ class LIBCANVAS_API WaveViewCache
                                                bool& full_image);
 
   private:
-        /* an unsorted, unindexd collection of cache entries associated with
-           a particular AudioSource. All cache Entries in the collection
-           share the AudioSource in common, but represent different parameter
-           settings (e.g. height, color, samples per pixel etc.)
-        */
-        typedef std::vector<boost::shared_ptr<Entry> > CacheLine;
-        /* Indexed, non-sortable structure used to lookup images associated
-         * with a particular AudioSource
-         */
-        typedef std::map <boost::shared_ptr<ARDOUR::AudioSource>,CacheLine> ImageCache;
         ImageCache cache_map;
 
-        /* Linear, sortable structure used when we need to do a timestamp-based
-         * flush of entries from the cache.
-         */
-        typedef std::pair<boost::shared_ptr<ARDOUR::AudioSource>,boost::shared_ptr<Entry> > ListEntry;
-        typedef std::vector<ListEntry> CacheList;
-
-        struct SortByTimestamp {
-	        bool operator() (const WaveViewCache::ListEntry& a, const WaveViewCache::ListEntry& b) {
-		        return a.second->timestamp < b.second->timestamp;
-	        }
-        };
-        friend struct SortByTimestamp;
+        Entry* lru_head; /* most recently used */
+        Entry* lru_tail; /* least recently used, flushed first */
 
         uint64_t image_cache_size;
         uint64_t _image_cache_threshold;
 
-        uint64_t compute_image_cache_size ();
+        Stats _stats;
+
+        void lru_link (Entry*);
+        void lru_unlink (Entry*);
+        void remove (Entry*, bool keep_line = false);
         void cache_flush ();
         bool cache_full ();
 };
@@ -279,7 +331,19 @@ public:
 	static void start_drawing_thread ();
 	static void stop_drawing_thread ();
 
+	/** Set the number of threads that render images; if they are
+	 *  running, they are restarted. By default there is one thread per
+	 *  CPU core (but one), at most four.
+	 */
+	static void set_drawing_thread_count (uint32_t);
+	static uint32_t drawing_thread_count ();
+
+	/** @return the number of images queued or being rendered */
+	static uint32_t pending_drawing_requests ();
+
 	static void set_image_cache_size (uint64_t);
+	/** @return hit/miss and size statistics of the image cache shared by all WaveViews */
+	static WaveViewCache::Stats image_cache_stats ();
 
 #ifdef CANVAS_COMPATIBILITY
 	void*& property_gain_src () {
@@ -406,9 +470,16 @@ public:
         static Glib::Threads::Mutex request_queue_lock;
         static Glib::Threads::Mutex current_image_lock;
         static Glib::Threads::Cond request_cond;
-        static Glib::Threads::Thread* _drawing_thread;
+        static Glib::Threads::Cond request_done;
+        static std::vector<Glib::Threads::Thread*> _drawing_threads;
+        static uint32_t _drawing_thread_count;
+        static uint64_t request_sequence;
         typedef std::set<WaveView const *> DrawingRequestQueue;
         static DrawingRequestQueue request_queue;
+        /* WaveViews whose request a drawing thread is working on; each
+           is served by one thread at a time.
+        */
+        static DrawingRequestQueue requests_in_progress;
 };
 
 } // namespace ArdourCanvas
@@ -33,6 +33,7 @@ using namespace PBD;
 using namespace ArdourCanvas;
 
 int Item::default_items_per_cell = 64;
+uint32_t Item::tree_lookup_threshold = 32;
 
 Item::Item (Canvas* canvas)
 	: Fill (*this)
@@ -280,7 +281,7 @@ Item::set_position (Duple p)
 
 
 		if (_parent) {
-			_parent->child_changed ();
+			_parent->child_changed (this);
 		}
 	}
 }
@@ -378,7 +379,7 @@ Item::propagate_show_hide ()
 	/* bounding box may have changed while we were hidden */
 
 	if (_parent) {
-		_parent->child_changed ();
+		_parent->child_changed (this);
 	}
 
 	_canvas->item_shown_or_hidden (this);
@@ -640,7 +641,7 @@ Item::end_change ()
 		_canvas->item_changed (this, _pre_change_bounding_box);
 
 		if (_parent) {
-			_parent->child_changed ();
+			_parent->child_changed (this);
 		}
 	}
 }
@@ -1012,7 +1013,11 @@ void
 Item::ensure_lut () const
 {
 	if (!_lut) {
-		_lut = new DumbLookupTable (*this);
+		if (_items.size() > tree_lookup_threshold) {
+			_lut = new TreeLookupTable (*this);
+		} else {
+			_lut = new DumbLookupTable (*this);
+		}
 	}
 }
 
@@ -1024,13 +1029,15 @@ Item::invalidate_lut () const
 }
 
 void
-Item::child_changed ()
+Item::child_changed (Item* child)
 {
-	invalidate_lut ();
+	if (_lut) {
+		_lut->child_changed (child);
+	}
 	_bounding_box_dirty = true;
 
 	if (_parent) {
-		_parent->child_changed ();
+		_parent->child_changed (this);
 	}
 }
 
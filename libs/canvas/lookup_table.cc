@@ -17,6 +17,8 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <algorithm>
+
 #include "canvas/item.h"
 #include "canvas/lookup_table.h"
 
@@ -103,6 +105,333 @@ DumbLookupTable::has_item_at_point (Duple const & point) const
 	return false;
 }
 
+/** Distance by which the bounding box of a child is grown when looking
+ *  for the items at a point, since some items (e.g. lines) cover points
+ *  just outside of their bounding box. Item::covers() has the final say.
+ */
+static const Distance tree_covers_slop = 8.0;
+
+struct TreeLookupTable::Leaf {
+	Leaf (Item* i, Rect const & r, int32_t o) : item (i), bbox (r), order (o) {}
+
+	Item* item;
+	Rect bbox;
+	int32_t order;
+};
+
+struct TreeLookupTable::LeafCompare {
+	LeafCompare (bool x) : by_x (x) {}
+	bool operator() (Leaf const & a, Leaf const & b) const {
+		if (by_x) {
+			return a.bbox.x0 + a.bbox.x1 < b.bbox.x0 + b.bbox.x1;
+		}
+		return a.bbox.y0 + a.bbox.y1 < b.bbox.y0 + b.bbox.y1;
+	}
+	bool by_x;
+};
+
+static inline bool
+overlaps (Rect const & a, Rect const & b)
+{
+	return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+TreeLookupTable::TreeLookupTable (Item const & item)
+	: LookupTable (item)
+	, _refits (0)
+	, _built (false)
+{
+
+}
+
+void
+TreeLookupTable::build () const
+{
+	list<Item*> const & items = _item.items ();
+	vector<Leaf> leaves;
+	int32_t order = 0;
+
+	leaves.reserve (items.size ());
+
+	for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+		Rect item_bbox = (*i)->bounding_box ();
+		if (item_bbox) {
+			item_bbox = (*i)->item_to_parent (item_bbox);
+		}
+		leaves.push_back (Leaf (*i, item_bbox, order++));
+	}
+
+	_nodes.clear ();
+	_leaves.clear ();
+	_dirty.clear ();
+	_refits = 0;
+	_built = true;
+
+	if (leaves.empty ()) {
+		return;
+	}
+
+	_nodes.reserve (2 * leaves.size () - 1);
+	build (leaves, 0, leaves.size (), -1);
+}
+
+/** Build the (sub-)tree for leaves [@param begin, @param end), splitting
+ *  them at the median of the longer side of their bounding box.
+ *  @return index of the root node of the sub-tree.
+ */
+int32_t
+TreeLookupTable::build (vector<Leaf>& leaves, size_t begin, size_t end, int32_t parent) const
+{
+	int32_t const n = _nodes.size ();
+
+	_nodes.push_back (Node ());
+	_nodes[n].parent = parent;
+	_nodes[n].dirty = false;
+
+	if (end - begin == 1) {
+		Leaf const & l (leaves[begin]);
+		_nodes[n].bbox = l.bbox;
+		_nodes[n].empty = !l.bbox;
+		_nodes[n].left = -1;
+		_nodes[n].right = -1;
+		_nodes[n].item = l.item;
+		_nodes[n].order = l.order;
+		_leaves[l.item] = n;
+		return n;
+	}
+
+	Rect bbox;
+	bool have_one = false;
+
+	for (size_t i = begin; i < end; ++i) {
+		if (!leaves[i].bbox) {
+			continue;
+		}
+		bbox = have_one ? bbox.extend (leaves[i].bbox) : leaves[i].bbox;
+		have_one = true;
+	}
+
+	size_t const mid = begin + (end - begin) / 2;
+	nth_element (leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end, LeafCompare (bbox.width() >= bbox.height()));
+
+	int32_t const left = build (leaves, begin, mid, n);
+	int32_t const right = build (leaves, mid, end, n);
+
+	/* _nodes may have been reallocated by now */
+
+	_nodes[n].left = left;
+	_nodes[n].right = right;
+	_nodes[n].item = 0;
+	_nodes[n].order = 0;
+	_nodes[n].bbox = bbox;
+	_nodes[n].empty = !have_one;
+
+	return n;
+}
+
+void
+TreeLookupTable::child_changed (Item* child)
+{
+	if (!_built) {
+		return;
+	}
+
+	map<Item*, int32_t>::const_iterator l = _leaves.find (child);
+
+	if (l == _leaves.end ()) {
+		/* added since the tree was built; our item should have
+		 * invalidated us, but to be safe ...
+		 */
+		_built = false;
+		return;
+	}
+
+	if (!_nodes[l->second].dirty) {
+		_nodes[l->second].dirty = true;
+		_dirty.push_back (l->second);
+	}
+}
+
+/** Recompute the bounding box of leaf @param n and of the nodes above it */
+void
+TreeLookupTable::refit (int32_t n) const
+{
+	Node& leaf (_nodes[n]);
+
+	leaf.dirty = false;
+	leaf.bbox = leaf.item->bounding_box ();
+	if (leaf.bbox) {
+		leaf.bbox = leaf.item->item_to_parent (leaf.bbox);
+	}
+	leaf.empty = !leaf.bbox;
+
+	for (n = leaf.parent; n >= 0; n = _nodes[n].parent) {
+		Node& node (_nodes[n]);
+		Node const & left (_nodes[node.left]);
+		Node const & right (_nodes[node.right]);
+
+		if (left.empty) {
+			node.bbox = right.bbox;
+		} else if (right.empty) {
+			node.bbox = left.bbox;
+		} else {
+			node.bbox = left.bbox.extend (right.bbox);
+		}
+		node.empty = left.empty && right.empty;
+	}
+}
+
+void
+TreeLookupTable::update () const
+{
+	if (_built && _refits + _dirty.size () > _leaves.size ()) {
+		/* boxes have moved a lot since the tree was built, they
+		 * probably overlap a lot more than they need to.
+		 */
+		_built = false;
+	}
+
+	if (!_built) {
+		build ();
+		return;
+	}
+
+	for (vector<int32_t>::const_iterator i = _dirty.begin(); i != _dirty.end(); ++i) {
+		refit (*i);
+	}
+
+	_refits += _dirty.size ();
+	_dirty.clear ();
+}
+
+Rect
+TreeLookupTable::to_item (Rect const & r) const
+{
+	/* all children share their ancestors, and hence their scroll offset */
+	Item const * child = _item.items().front ();
+	return child->item_to_parent (child->window_to_item (r));
+}
+
+Duple
+TreeLookupTable::to_item (Duple const & d) const
+{
+	Item const * child = _item.items().front ();
+	return child->item_to_parent (child->window_to_item (d));
+}
+
+/** Find the children with a bounding box overlapping @param area, in
+ *  our item's coordinates, paired with their stacking order.
+ */
+void
+TreeLookupTable::find (Rect const & area, vector<pair<int32_t, Item*> >& found) const
+{
+	if (_nodes.empty ()) {
+		return;
+	}
+
+	/* the tree is balanced when built, so this is plenty */
+	int32_t stack[64];
+	int depth = 0;
+
+	stack[depth++] = 0;
+
+	while (depth) {
+		Node const & node (_nodes[stack[--depth]]);
+
+		if (node.empty || !overlaps (node.bbox, area)) {
+			continue;
+		}
+
+		if (node.left < 0) {
+			found.push_back (make_pair (node.order, node.item));
+		} else {
+			stack[depth++] = node.right;
+			stack[depth++] = node.left;
+		}
+	}
+
+	sort (found.begin(), found.end());
+}
+
+vector<Item*>
+TreeLookupTable::get (Rect const & area)
+{
+	/* area is in window coordinates */
+
+	vector<Item*> vitems;
+
+	if (_item.items().empty()) {
+		return vitems;
+	}
+
+	update ();
+
+	vector<pair<int32_t, Item*> > found;
+
+	/* allow for item_to_window() rounding to whole pixels */
+	find (to_item (area).expand (1.0), found);
+
+	vitems.reserve (found.size ());
+
+	for (vector<pair<int32_t, Item*> >::const_iterator i = found.begin(); i != found.end(); ++i) {
+		vitems.push_back (i->second);
+	}
+
+	return vitems;
+}
+
+vector<Item*>
+TreeLookupTable::items_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	vector<Item*> vitems;
+
+	if (_item.items().empty()) {
+		return vitems;
+	}
+
+	update ();
+
+	Duple const p = to_item (point);
+	vector<pair<int32_t, Item*> > found;
+
+	find (Rect (p.x, p.y, p.x, p.y).expand (tree_covers_slop), found);
+
+	for (vector<pair<int32_t, Item*> >::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if (i->second->covers (point)) {
+			vitems.push_back (i->second);
+		}
+	}
+
+	return vitems;
+}
+
+bool
+TreeLookupTable::has_item_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	if (_item.items().empty()) {
+		return false;
+	}
+
+	update ();
+
+	Duple const p = to_item (point);
+	vector<pair<int32_t, Item*> > found;
+
+	find (Rect (p.x, p.y, p.x, p.y).expand (tree_covers_slop), found);
+
+	for (vector<pair<int32_t, Item*> >::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if (i->second->visible() && i->second->covers (point)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 OptimizingLookupTable::OptimizingLookupTable (Item const & item, int items_per_cell)
 	: LookupTable (item)
 	, _items_per_cell (items_per_cell)
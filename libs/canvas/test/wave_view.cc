@@ -88,6 +88,7 @@ WaveViewTest::all ()
 	render_all_at_once ();
 	render_in_pieces ();
 	cache ();
+	cache_replace_line ();
 }
 
 void
@@ -162,3 +163,41 @@ WaveViewTest::cache ()
 	CPPUNIT_ASSERT ((*i)->end() == 256);
 	++i;
 }
+
+static boost::shared_ptr<WaveViewCache::Entry>
+cache_entry (framepos_t start, framepos_t end)
+{
+	return boost::shared_ptr<WaveViewCache::Entry> (
+		new WaveViewCache::Entry (0, 64, 1.0, 0xffffffff, 1.0, start, end,
+		                          Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, end - start, 64)));
+}
+
+/** Add an image covering every image in its cache line, which leaves the
+ *  line empty while the covered images are removed.
+ */
+void
+WaveViewTest::cache_replace_line ()
+{
+	WaveViewCache cache;
+	boost::shared_ptr<AudioSource> src = _audio_region->audio_source ();
+
+	cache.add (src, cache_entry (0, 100));
+	cache.add (src, cache_entry (100, 200));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, cache.stats().entries);
+
+	boost::shared_ptr<WaveViewCache::Entry> wide = cache_entry (0, 300);
+	cache.add (src, wide);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, cache.stats().entries);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 300 * 64 * 4, cache.stats().size);
+
+	bool full = false;
+	CPPUNIT_ASSERT (cache.lookup_image (src, 50, 250, 0, 64, 1.0, 0xffffffff, 1.0, full) == wide);
+	CPPUNIT_ASSERT (full);
+
+	/* the line is still usable, and removed once flushed empty */
+	cache.add (src, cache_entry (300, 400));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, cache.stats().entries);
+	cache.clear_cache ();
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0, cache.stats().entries);
+	CPPUNIT_ASSERT (!cache.lookup_image (src, 0, 100, 0, 64, 1.0, 0xffffffff, 1.0, full));
+}
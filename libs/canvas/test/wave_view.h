@@ -16,6 +16,7 @@ private:
 	void render_all_at_once ();
 	void render_in_pieces ();
 	void cache ();
+	void cache_replace_line ();
 
 	ArdourCanvas::ImageCanvas* _canvas;
 	ArdourCanvas::WaveView* _wave_view;
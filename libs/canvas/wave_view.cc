@@ -29,6 +29,7 @@
 #include "pbd/base_ui.h"
 #include "pbd/compose.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/signals.h"
 #include "pbd/stacktrace.h"
 
@@ -67,8 +68,12 @@ gint WaveView::drawing_thread_should_quit = 0;
 Glib::Threads::Mutex WaveView::request_queue_lock;
 Glib::Threads::Mutex WaveView::current_image_lock;
 Glib::Threads::Cond WaveView::request_cond;
-Glib::Threads::Thread* WaveView::_drawing_thread = 0;
+Glib::Threads::Cond WaveView::request_done;
+std::vector<Glib::Threads::Thread*> WaveView::_drawing_threads;
+uint32_t WaveView::_drawing_thread_count = 0;
+uint64_t WaveView::request_sequence = 0;
 WaveView::DrawingRequestQueue WaveView::request_queue;
+WaveView::DrawingRequestQueue WaveView::requests_in_progress;
 
 PBD::Signal0<void> WaveView::VisualPropertiesChanged;
 PBD::Signal0<void> WaveView::ClipLevelChanged;
@@ -111,7 +116,10 @@ WaveView::WaveView (Canvas* c, boost::shared_ptr<ARDOUR::AudioRegion> region)
 	VisualPropertiesChanged.connect_same_thread (invalidation_connection, boost::bind (&WaveView::handle_visual_property_change, this));
 	ClipLevelChanged.connect_same_thread (invalidation_connection, boost::bind (&WaveView::handle_clip_level_change, this));
 
-	ImageReady.connect (image_ready_connection, invalidator (*this), boost::bind (&WaveView::image_ready, this), gui_context());
+	if (gui_context()) {
+		/* without a GUI (benchmarks) nothing needs to be redrawn */
+		ImageReady.connect (image_ready_connection, invalidator (*this), boost::bind (&WaveView::image_ready, this), gui_context());
+	}
 }
 
 WaveView::WaveView (Item* parent, boost::shared_ptr<ARDOUR::AudioRegion> region)
@@ -144,12 +152,26 @@ WaveView::WaveView (Item* parent, boost::shared_ptr<ARDOUR::AudioRegion> region)
 	VisualPropertiesChanged.connect_same_thread (invalidation_connection, boost::bind (&WaveView::handle_visual_property_change, this));
 	ClipLevelChanged.connect_same_thread (invalidation_connection, boost::bind (&WaveView::handle_clip_level_change, this));
 
-	ImageReady.connect (image_ready_connection, invalidator (*this), boost::bind (&WaveView::image_ready, this), gui_context());
+	if (gui_context()) {
+		/* without a GUI (benchmarks) nothing needs to be redrawn */
+		ImageReady.connect (image_ready_connection, invalidator (*this), boost::bind (&WaveView::image_ready, this), gui_context());
+	}
 }
 
 WaveView::~WaveView ()
 {
 	invalidate_image_cache ();
+
+	{
+		/* a drawing thread may still be busy with our (now cancelled)
+		 * request, wait for it to let go of us.
+		 */
+		Glib::Threads::Mutex::Lock lm (request_queue_lock);
+		while (requests_in_progress.find (this) != requests_in_progress.end()) {
+			request_done.wait (request_queue_lock);
+		}
+	}
+
 	if (images ) {
 		images->clear_cache ();
 	}
@@ -763,15 +785,9 @@ WaveView::cache_request_result (boost::shared_ptr<WaveViewThreadRequest> req) co
 	                                                                       req->start,
 	                                                                       req->end,
 	                                                                       req->image));
-	images->add (_region->audio_source (_channel), ret);
-
-	/* consolidate cache first (removes fully-contained
-	 * duplicate images)
-	 */
+	/* this also removes cached images fully contained in this one */
 
-	images->consolidate_image_cache (_region->audio_source (_channel),
-	                                 req->channel, req->height, req->amplitude,
-	                                 req->fill_color, req->samples_per_pixel);
+	images->add (_region->audio_source (_channel), ret);
 
 	return ret;
 }
@@ -939,16 +955,7 @@ WaveView::queue_get_image (boost::shared_ptr<const ARDOUR::Region> region, frame
 	req->fill_color = _fill_color;
 	req->amplitude = _region_amplitude * _amplitude_above_axis;
 	req->width = desired_image_width ();
-
-	if (current_request) {
-		/* this will stop rendering in progress (which might otherwise
-		   be long lived) for any current request.
-		*/
-		Glib::Threads::Mutex::Lock lm (request_queue_lock);
-		if (current_request) {
-			current_request->cancel ();
-		}
-	}
+	req->visible = visible() && _canvas->visible_area().intersection (item_to_window (bounding_box()));
 
 	start_drawing_thread ();
 
@@ -956,6 +963,31 @@ WaveView::queue_get_image (boost::shared_ptr<const ARDOUR::Region> region, frame
 
 	{
 		Glib::Threads::Mutex::Lock lm (request_queue_lock);
+
+		if (current_request) {
+
+			if (!current_request->should_stop() &&
+			    request_queue.find (this) != request_queue.end() &&
+			    current_request->start <= start && current_request->end >= end &&
+			    current_request->samples_per_pixel == req->samples_per_pixel &&
+			    current_request->channel == req->channel &&
+			    current_request->height == req->height &&
+			    current_request->fill_color == req->fill_color &&
+			    current_request->amplitude == req->amplitude) {
+				/* a queued request, not yet started, already
+				 * covers this one: keep it in its place.
+				 */
+				current_request->visible = current_request->visible || req->visible;
+				return;
+			}
+
+			/* this will stop rendering in progress (which might otherwise
+			   be long lived) for any current request.
+			*/
+			current_request->cancel ();
+		}
+
+		req->sequence = ++request_sequence;
 		current_request = req;
 
 		DEBUG_TRACE (DEBUG::WaveView, string_compose ("%1 now has current request %2\n", this, req));
@@ -1166,7 +1198,7 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 			/* doesn't cover the area we need ... reset */
 			_current_image.reset ();
 		} else {
-			/* timestamp our continuing use of this image/cache entry */
+			/* note our continuing use of this image/cache entry */
 			images->use (_region->audio_source (_channel), _current_image);
 			image_to_draw = _current_image;
 		}
@@ -1524,24 +1556,84 @@ WaveView::set_image_cache_size (uint64_t sz)
 	images->set_image_cache_threshold (sz);
 }
 
+WaveViewCache::Stats
+WaveView::image_cache_stats ()
+{
+	if (!images) {
+		return WaveViewCache::Stats ();
+	}
+
+	return images->stats ();
+}
+
 /*-------------------------------------------------*/
 
 void
 WaveView::start_drawing_thread ()
 {
-	if (!_drawing_thread) {
-		_drawing_thread = Glib::Threads::Thread::create (sigc::ptr_fun (WaveView::drawing_thread));
+	if (!_drawing_threads.empty ()) {
+		return;
+	}
+
+	if (_drawing_thread_count == 0) {
+		_drawing_thread_count = std::max (1, std::min ((int) hardware_concurrency () - 1, 4));
+	}
+
+	for (uint32_t n = 0; n < _drawing_thread_count; ++n) {
+		_drawing_threads.push_back (Glib::Threads::Thread::create (sigc::ptr_fun (WaveView::drawing_thread)));
 	}
 }
 
 void
 WaveView::stop_drawing_thread ()
 {
-	while (_drawing_thread) {
+	if (_drawing_threads.empty ()) {
+		return;
+	}
+
+	{
 		Glib::Threads::Mutex::Lock lm (request_queue_lock);
 		g_atomic_int_set (&drawing_thread_should_quit, 1);
-		request_cond.signal ();
+		request_cond.broadcast ();
 	}
+
+	for (std::vector<Glib::Threads::Thread*>::iterator t = _drawing_threads.begin(); t != _drawing_threads.end(); ++t) {
+		(*t)->join ();
+	}
+
+	_drawing_threads.clear ();
+	g_atomic_int_set (&drawing_thread_should_quit, 0);
+}
+
+void
+WaveView::set_drawing_thread_count (uint32_t n)
+{
+	n = std::max (n, (uint32_t) 1);
+
+	if (n == _drawing_thread_count) {
+		return;
+	}
+
+	_drawing_thread_count = n;
+
+	if (!_drawing_threads.empty ()) {
+		/* queued requests stay queued for the new threads */
+		stop_drawing_thread ();
+		start_drawing_thread ();
+	}
+}
+
+uint32_t
+WaveView::drawing_thread_count ()
+{
+	return _drawing_threads.size ();
+}
+
+uint32_t
+WaveView::pending_drawing_requests ()
+{
+	Glib::Threads::Mutex::Lock lm (request_queue_lock);
+	return request_queue.size () + requests_in_progress.size ();
 }
 
 void
@@ -1549,11 +1641,9 @@ WaveView::drawing_thread ()
 {
 	using namespace Glib::Threads;
 
-	WaveView const * requestor;
 	Mutex::Lock lm (request_queue_lock);
-	bool run = true;
 
-	while (run) {
+	while (true) {
 
 		/* remember that we hold the lock at this point, no matter what */
 
@@ -1561,29 +1651,42 @@ WaveView::drawing_thread ()
 			break;
 		}
 
-		if (request_queue.empty()) {
-			request_cond.wait (request_queue_lock);
-		}
+		/* find the most urgent request of a WaveView that no other
+		 * thread is drawing, and drop cancelled ones (e.g. for a zoom
+		 * level that has been left already) while we are at it.
+		 */
 
-		if (request_queue.empty()) {
-			continue;
-		}
+		WaveView const * requestor = 0;
+		boost::shared_ptr<WaveViewThreadRequest> req;
 
-		/* remove the request from the queue (remember: the "request"
-		 * is just a pointer to a WaveView object)
-		 */
+		for (DrawingRequestQueue::iterator i = request_queue.begin(); i != request_queue.end(); ) {
 
-		requestor = *(request_queue.begin());
-		request_queue.erase (request_queue.begin());
+			boost::shared_ptr<WaveViewThreadRequest> r = (*i)->current_request;
 
-		DEBUG_TRACE (DEBUG::WaveView, string_compose ("start request for %1 at %2\n", requestor, g_get_monotonic_time()));
+			if (!r || r->should_stop()) {
+				request_queue.erase (i++);
+				continue;
+			}
+
+			if (requests_in_progress.find (*i) == requests_in_progress.end() &&
+			    (!req || (r->visible && !req->visible) || (r->visible == req->visible && r->sequence > req->sequence))) {
+				requestor = *i;
+				req = r;
+			}
 
-		boost::shared_ptr<WaveViewThreadRequest> req = requestor->current_request;
+			++i;
+		}
 
 		if (!req) {
+			request_cond.wait (request_queue_lock);
 			continue;
 		}
 
+		request_queue.erase (requestor);
+		requests_in_progress.insert (requestor);
+
+		DEBUG_TRACE (DEBUG::WaveView, string_compose ("start request for %1 at %2\n", requestor, g_get_monotonic_time()));
+
 		/* Generate an image. Unlock the request queue lock
 		 * while we do this, so that other things can happen
 		 * as we do rendering.
@@ -1600,16 +1703,25 @@ WaveView::drawing_thread ()
 		lm.acquire ();
 
 		req.reset (); /* drop/delete request as appropriate */
-	}
 
-	/* thread is vanishing */
-	_drawing_thread = 0;
+		requests_in_progress.erase (requestor);
+		request_done.broadcast ();
+
+		if (!request_queue.empty ()) {
+			/* another thread may have passed over a new request of
+			 * this WaveView while we were drawing it.
+			 */
+			request_cond.signal ();
+		}
+	}
 }
 
 /*-------------------------------------------------*/
 
 WaveViewCache::WaveViewCache ()
-	: image_cache_size (0)
+	: lru_head (0)
+	, lru_tail (0)
+	, image_cache_size (0)
 	, _image_cache_threshold (100 * 1048576) /* bytes */
 {
 }
@@ -1631,183 +1743,204 @@ WaveViewCache::lookup_image (boost::shared_ptr<ARDOUR::AudioSource> src,
 {
 	ImageCache::iterator x;
 
-	if ((x = cache_map.find (src)) == cache_map.end ()) {
-		/* nothing in the cache for this audio source at all */
+	if ((x = cache_map.find (LineKey (src, channel, height, amplitude, fill_color, samples_per_pixel))) == cache_map.end ()) {
+		/* nothing in the cache for this audio source and these properties */
+		_stats.misses++;
 		return boost::shared_ptr<WaveViewCache::Entry> ();
 	}
 
 	CacheLine& caches = x->second;
-	boost::shared_ptr<Entry> best_partial;
-	framecnt_t max_coverage = 0;
 
-	/* Find a suitable ImageSurface, if it exists.
-	*/
-
-	for (CacheLine::iterator c = caches.begin(); c != caches.end(); ++c) {
+	/* The last image starting at or before @param start is the one
+	 * reaching furthest beyond it, since ends increase with starts
+	 * within a line.
+	 */
 
-		boost::shared_ptr<Entry> e (*c);
+	CacheLine::iterator c = caches.upper_bound (start);
 
-		if (channel != e->channel
-		    || height != e->height
-		    || amplitude != e->amplitude
-		    || samples_per_pixel != e->samples_per_pixel
-		    || fill_color != e->fill_color) {
-			continue;
-		}
+	if (c == caches.begin ()) {
+		_stats.misses++;
+		return boost::shared_ptr<Entry> ();
+	}
 
-		switch (Evoral::coverage (start, end, e->start, e->end)) {
-			case Evoral::OverlapExternal:  /* required range is inside image range */
-				DEBUG_TRACE (DEBUG::WaveView, string_compose ("found image spanning %1..%2 covers %3..%4\n",
-							e->start, e->end, start, end));
-				use (src, e);
-				full_coverage = true;
-				return e;
-
-			case Evoral::OverlapStart: /* required range start is covered by image range */
-				if ((e->end - start) > max_coverage) {
-					best_partial = e;
-					max_coverage = e->end - start;
-				}
-				break;
+	boost::shared_ptr<Entry> e ((--c)->second);
 
-			case Evoral::OverlapNone:
-			case Evoral::OverlapEnd:
-			case Evoral::OverlapInternal:
-				break;
-		}
+	if (e->end >= end) {
+		/* required range is inside image range */
+		DEBUG_TRACE (DEBUG::WaveView, string_compose ("found image spanning %1..%2 covers %3..%4\n",
+		                                              e->start, e->end, start, end));
+		use (src, e);
+		_stats.hits++;
+		full_coverage = true;
+		return e;
 	}
 
-	if (best_partial) {
+	if (e->end > start) {
+		/* required range start is covered by image range */
 		DEBUG_TRACE (DEBUG::WaveView, string_compose ("found PARTIAL image spanning %1..%2 partially covers %3..%4\n",
-		                                              best_partial->start, best_partial->end, start, end));
-		use (src, best_partial);
+		                                              e->start, e->end, start, end));
+		use (src, e);
+		_stats.partial_hits++;
 		full_coverage = false;
-		return best_partial;
+		return e;
 	}
 
+	_stats.misses++;
 	return boost::shared_ptr<Entry> ();
 }
 
 void
-WaveViewCache::consolidate_image_cache (boost::shared_ptr<ARDOUR::AudioSource> src,
-                                        int channel,
-                                        Coord height,
-                                        float amplitude,
-                                        Color fill_color,
-                                        double samples_per_pixel)
-{
-	list <uint32_t> deletion_list;
-	uint32_t other_entries = 0;
-	ImageCache::iterator x;
+WaveViewCache::lru_link (Entry* e)
+{
+	e->lru_prev = 0;
+	e->lru_next = lru_head;
 
-	/* MUST BE CALLED FROM (SINGLE) GUI THREAD */
+	if (lru_head) {
+		lru_head->lru_prev = e;
+	} else {
+		lru_tail = e;
+	}
 
-	if ((x = cache_map.find (src)) == cache_map.end ()) {
-		return;
+	lru_head = e;
+}
+
+void
+WaveViewCache::lru_unlink (Entry* e)
+{
+	if (e->lru_prev) {
+		e->lru_prev->lru_next = e->lru_next;
+	} else {
+		lru_head = e->lru_next;
 	}
 
-	CacheLine& caches  = x->second;
+	if (e->lru_next) {
+		e->lru_next->lru_prev = e->lru_prev;
+	} else {
+		lru_tail = e->lru_prev;
+	}
 
-	for (CacheLine::iterator c1 = caches.begin(); c1 != caches.end(); ) {
+	e->lru_prev = 0;
+	e->lru_next = 0;
+}
 
-		CacheLine::iterator nxt = c1;
-		++nxt;
+void
+WaveViewCache::use (boost::shared_ptr<ARDOUR::AudioSource> src, boost::shared_ptr<Entry> ce)
+{
+	/* MUST BE CALLED FROM (SINGLE) GUI THREAD */
 
-		boost::shared_ptr<Entry> e1 (*c1);
+	if (!ce->cached || ce.get() == lru_head) {
+		/* flushed from the cache (but still drawn by some WaveView)
+		 * or already the most recently used image.
+		 */
+		return;
+	}
 
-		if (channel != e1->channel
-		    || height != e1->height
-		    || amplitude != e1->amplitude
-		    || samples_per_pixel != e1->samples_per_pixel
-		    || fill_color != e1->fill_color) {
+	lru_unlink (ce.get());
+	lru_link (ce.get());
+}
 
-			/* doesn't match current properties, ignore and move on
-			 * to the next one.
-			 */
+void
+WaveViewCache::add (boost::shared_ptr<ARDOUR::AudioSource> src, boost::shared_ptr<Entry> ce)
+{
+	/* MUST BE CALLED FROM (SINGLE) GUI THREAD */
 
-			other_entries++;
-			c1 = nxt;
-			continue;
-		}
+	if (ce->cached) {
+		return;
+	}
 
-		/* c1 now points to a cached image entry that matches current
-		 * properties. Check all subsequent cached imaged entries to
-		 * see if there are others that also match but represent
-		 * subsets of the range covered by this one.
-		 */
+	ImageCache::iterator x = cache_map.insert (make_pair (LineKey (src, ce->channel, ce->height, ce->amplitude, ce->fill_color, ce->samples_per_pixel), CacheLine())).first;
+	CacheLine& caches = x->second;
 
-		for (CacheLine::iterator c2 = c1; c2 != caches.end(); ) {
+	/* Keep the line free of images that are fully contained in
+	 * another one: if an existing image already covers the new one
+	 * there is no need to add it, and existing images covered by the
+	 * new one are removed (they start at or after it, and since ends
+	 * increase with starts, they are adjacent).
+	 */
 
-			CacheLine::iterator nxt2 = c2;
-			++nxt2;
+	CacheLine::iterator c = caches.upper_bound (ce->start);
 
-			boost::shared_ptr<Entry> e2 (*c2);
+	if (c != caches.begin ()) {
+		CacheLine::iterator prev = c;
+		--prev;
+		if (prev->second->end >= ce->end) {
+			DEBUG_TRACE (DEBUG::WaveView, string_compose ("image spanning %1..%2 already covered by %3..%4\n",
+			                                              ce->start, ce->end, prev->second->start, prev->second->end));
+			use (src, prev->second);
+			return;
+		}
+	}
 
-			if (e1 == e2 || channel != e2->channel
-			    || height != e2->height
-			    || amplitude != e2->amplitude
-			    || samples_per_pixel != e2->samples_per_pixel
-			    || fill_color != e2->fill_color) {
+	c = caches.lower_bound (ce->start);
 
-				/* properties do not match, ignore for the
-				 * purposes of consolidation.
-				 */
-				c2 = nxt2;
-				continue;
-			}
+	while (c != caches.end() && c->second->end <= ce->end) {
+		boost::shared_ptr<Entry> contained (c->second);
+		++c;
+		/* keep the line even if it becomes empty: x and caches are used below */
+		remove (contained.get(), true);
+	}
 
-			if (e2->start >= e1->start && e2->end <= e1->end) {
-				/* c2 is fully contained by c1, so delete it */
-				caches.erase (c2);
+	Cairo::RefPtr<Cairo::ImageSurface> img (ce->image);
 
-				/* and re-start the whole iteration */
-				nxt = caches.begin ();
-				break;
-			}
+	ce->size = img->get_height() * img->get_width () * 4; /* 4 = bytes per FORMAT_ARGB32 pixel */
+	ce->line = x;
+	ce->cached = true;
 
-			c2 = nxt2;
-		}
+	caches.insert (make_pair (ce->start, ce));
+	lru_link (ce.get());
 
-		c1 = nxt;
-	}
-}
+	image_cache_size += ce->size;
+	_stats.entries++;
 
-void
-WaveViewCache::use (boost::shared_ptr<ARDOUR::AudioSource> src, boost::shared_ptr<Entry> ce)
-{
-	ce->timestamp = g_get_monotonic_time ();
+	if (cache_full()) {
+		cache_flush ();
+	}
 }
 
 void
-WaveViewCache::add (boost::shared_ptr<ARDOUR::AudioSource> src, boost::shared_ptr<Entry> ce)
+WaveViewCache::remove (Entry* e, bool keep_line)
 {
-	/* MUST BE CALLED FROM (SINGLE) GUI THREAD */
+	/* remove the entry from its cache line and the LRU list. The line
+	 * holds the last reference to the entry in the cache, so @param e
+	 * must not be used after this unless the caller keeps its own.
+	 * A line left empty is removed too, unless @param keep_line is set.
+	 */
 
-	Cairo::RefPtr<Cairo::ImageSurface> img (ce->image);
+	ImageCache::iterator x = e->line;
 
-	image_cache_size += img->get_height() * img->get_width () * 4; /* 4 = bytes per FORMAT_ARGB32 pixel */
+	lru_unlink (e);
+	e->cached = false;
 
-	if (cache_full()) {
-		cache_flush ();
+	if (image_cache_size > e->size) {
+		image_cache_size -= e->size;
+	} else {
+		image_cache_size = 0;
 	}
+	_stats.entries--;
 
-	ce->timestamp = g_get_monotonic_time ();
+	x->second.erase (e->start);
 
-	cache_map[src].push_back (ce);
+	if (x->second.empty() && !keep_line) {
+		/* remove cache line from main cache: no more entries */
+		cache_map.erase (x);
+	}
 }
 
-uint64_t
-WaveViewCache::compute_image_cache_size()
+WaveViewCache::Stats
+WaveViewCache::stats () const
 {
-	uint64_t total = 0;
-	for (ImageCache::iterator s = cache_map.begin(); s != cache_map.end(); ++s) {
-		CacheLine& per_source_cache (s->second);
-		for (CacheLine::iterator c = per_source_cache.begin(); c != per_source_cache.end(); ++c) {
-			Cairo::RefPtr<Cairo::ImageSurface> img ((*c)->image);
-			total += img->get_height() * img->get_width() * 4; /* 4 = bytes per FORMAT_ARGB32 pixel */
-		}
-	}
-	return total;
+	Stats s (_stats);
+	s.size = image_cache_size;
+	return s;
+}
+
+void
+WaveViewCache::reset_stats ()
+{
+	_stats.hits = 0;
+	_stats.partial_hits = 0;
+	_stats.misses = 0;
+	_stats.evictions = 0;
 }
 
 bool
@@ -1819,63 +1952,16 @@ WaveViewCache::cache_full()
 void
 WaveViewCache::cache_flush ()
 {
-	/* Build a sortable list of all cache entries */
-
-	CacheList cache_list;
+	/* remove least recently used images until we are below the threshold */
 
-	for (ImageCache::const_iterator cm = cache_map.begin(); cm != cache_map.end(); ++cm) {
-		for (CacheLine::const_iterator cl = cm->second.begin(); cl != cm->second.end(); ++cl) {
-			cache_list.push_back (make_pair (cm->first, *cl));
-		}
-	}
-
-	/* sort list in LRU order */
-	SortByTimestamp sorter;
-	sort (cache_list.begin(), cache_list.end(), sorter);
-
-	while (image_cache_size > _image_cache_threshold && !cache_map.empty() && !cache_list.empty()) {
-
-		ListEntry& le (cache_list.front());
-
-		ImageCache::iterator x;
+	while (image_cache_size > _image_cache_threshold && lru_tail) {
 
-		if ((x = cache_map.find (le.first)) != cache_map.end ()) {
+		DEBUG_TRACE (DEBUG::WaveView, string_compose ("Removing cache line entry for %1\n", lru_tail->line->first.source->name()));
 
-			CacheLine& cl  = x->second;
+		remove (lru_tail);
+		_stats.evictions++;
 
-			for (CacheLine::iterator c = cl.begin(); c != cl.end(); ++c) {
-
-				if (*c == le.second) {
-
-					DEBUG_TRACE (DEBUG::WaveView, string_compose ("Removing cache line entry for %1\n", x->first->name()));
-
-					/* Remove this entry from this cache line */
-					cl.erase (c);
-
-					if (cl.empty()) {
-						/* remove cache line from main cache: no more entries */
-						cache_map.erase (x);
-					}
-
-					break;
-				}
-			}
-
-			Cairo::RefPtr<Cairo::ImageSurface> img (le.second->image);
-			uint64_t size = img->get_height() * img->get_width() * 4; /* 4 = bytes per FORMAT_ARGB32 pixel */
-
-			if (image_cache_size > size) {
-				image_cache_size -= size;
-			} else {
-				image_cache_size = 0;
-			}
-			DEBUG_TRACE (DEBUG::WaveView, string_compose ("cache shrunk to %1\n", image_cache_size));
-		}
-
-		/* Remove from the linear list, even if we didn't find it in
-		 * the actual cache_mao
-		 */
-		cache_list.erase (cache_list.begin());
+		DEBUG_TRACE (DEBUG::WaveView, string_compose ("cache shrunk to %1\n", image_cache_size));
 	}
 }
 
@@ -1883,10 +1969,10 @@ void
 WaveViewCache::clear_cache ()
 {
 	DEBUG_TRACE (DEBUG::WaveView, "clear cache\n");
-	const uint64_t image_cache_threshold = _image_cache_threshold;
-	_image_cache_threshold = 0;
-	cache_flush ();
-	_image_cache_threshold = image_cache_threshold;
+
+	while (lru_tail) {
+		remove (lru_tail);
+	}
 }
 
 void
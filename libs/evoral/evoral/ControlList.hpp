@@ -21,6 +21,7 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -254,9 +255,28 @@ public:
 		ControlList::const_iterator first;
 	};
 
+	/** Contiguous copy of the event times (and pointers to the events),
+	 *  so that evaluation can binary-search rather than walk the list.
+	 *  It is rebuilt by non-realtime code after the list is changed, and
+	 *  may only be used while the lock is held and flat_events_valid().
+	 */
+	struct FlatEvents {
+		std::vector<double>        when;
+		std::vector<ControlEvent*> events;
+	};
+
 	const EventList& events() const { return _events; }
 	double default_value() const { return _default_value; }
 
+	bool flat_events_valid () const { return !g_atomic_int_get (&_flat_dirty); }
+	const FlatEvents& flat_events () const { return _flat_events; }
+
+	/** Rebuild the flat events if the list has changed since they were
+	 *  last built.  Takes the write lock, so it must not be called with
+	 *  the lock held, nor from a realtime thread.
+	 */
+	void build_flat_events_if_necessary () const;
+
 	// FIXME: const violations for Curve
 	Glib::Threads::RWLock& lock()       const { return _lock; }
 	LookupCache& lookup_cache() const { return _lookup_cache; }
@@ -320,6 +340,9 @@ protected:
 
 	/** Called by unlocked_eval() to handle cases of 3 or more control points. */
 	double multipoint_eval (double x) const;
+	double flat_multipoint_eval (double x) const;
+
+	void unlocked_build_flat_events () const;
 
 	void build_search_cache_if_necessary (double start) const;
 
@@ -336,6 +359,8 @@ protected:
 
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
+	mutable FlatEvents    _flat_events;
+	mutable gint          _flat_dirty;
 
 	mutable Glib::Threads::RWLock _lock;
 
@@ -42,6 +42,7 @@ public:
 
 private:
 	double multipoint_eval (double x);
+	void flat_get_vector (double rx, double dx, float *arg, int32_t veclen);
 
 	void _get_vector (double x0, double x1, float *arg, int32_t veclen);
 
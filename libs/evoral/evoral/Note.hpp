@@ -44,6 +44,14 @@ public:
 	Note(const Note<Time>& copy);
 	~Note();
 
+#ifndef COMPILER_MSVC
+	/* There may be hundreds of thousands of notes in a model, so they are
+	   allocated from a pool rather than one by one from the heap.
+	*/
+	static void* operator new(size_t);
+	static void  operator delete(void*, size_t);
+#endif
+
 	inline bool operator==(const Note<Time>& other) {
 		return time() == other.time() &&
 			note() == other.note() &&
@@ -106,6 +114,8 @@ public:
 
 private:
 	// Event buffers are self-contained
+	uint8_t     _on_event_buffer[3];
+	uint8_t     _off_event_buffer[3];
 	Event<Time> _on_event;
 	Event<Time> _off_event;
 };
@@ -302,6 +302,8 @@ public:
 	bool add_note_unlocked (const NotePtr note, void* arg = 0);
 	void remove_note_unlocked(const constNotePtr note);
 
+	NotePtr note_by_id (event_id_t);
+
 	void add_patch_change_unlocked (const PatchChangePtr);
 	void remove_patch_change_unlocked (const constPatchChangePtr);
 
@@ -343,11 +345,17 @@ private:
 
 	void get_notes_by_pitch (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 	void get_notes_by_velocity (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
+	void update_note_range ();
 
 	const TypeMap& _type_map;
 
 	Notes        _notes;       // notes indexed by time
 	Pitches      _pitches[16]; // notes indexed by channel+pitch
+
+	/** _notes sorted by ID; built when first needed, and cleared whenever
+	 *  notes are added or removed.
+	 */
+	std::vector<NotePtr> _notes_by_id;
 	SysExes      _sysexes;
 	PatchChanges _patch_changes;
 
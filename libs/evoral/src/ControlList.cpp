@@ -27,6 +27,7 @@
 #define isnan_local std::isnan
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -67,6 +68,7 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
 	_lookup_cache.range.second = _events.end();
 	_search_cache.left = -1;
 	_search_cache.first = _events.end();
+	_flat_dirty = 1;
 	_sort_pending = false;
 	new_write_pass = true;
 	_in_write_pass = false;
@@ -89,6 +91,7 @@ ControlList::ControlList (const ControlList& other)
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
 	_search_cache.first = _events.end();
+	_flat_dirty = 1;
 	_sort_pending = false;
 	new_write_pass = true;
 	_in_write_pass = false;
@@ -115,6 +118,7 @@ ControlList::ControlList (const ControlList& other, double start, double end)
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
 	_search_cache.first = _events.end();
+	_flat_dirty = 1;
 	_sort_pending = false;
 
 	/* now grab the relevant points, and shift them back if necessary */
@@ -212,6 +216,8 @@ ControlList::maybe_signal_changed ()
 
 	if (_frozen) {
 		_changed_when_thawed = true;
+	} else {
+		build_flat_events_if_necessary ();
 	}
 }
 
@@ -948,6 +954,8 @@ ControlList::thaw ()
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
 		}
+
+		unlocked_build_flat_events ();
 	}
 }
 
@@ -959,6 +967,7 @@ ControlList::mark_dirty () const
 	_lookup_cache.range.second = _events.end();
 	_search_cache.left = -1;
 	_search_cache.first = _events.end();
+	g_atomic_int_set (&_flat_dirty, 1);
 
 	if (_curve) {
 		_curve->mark_dirty();
@@ -967,6 +976,37 @@ ControlList::mark_dirty () const
 	Dirty (); /* EMIT SIGNAL */
 }
 
+void
+ControlList::build_flat_events_if_necessary () const
+{
+	if (flat_events_valid ()) {
+		return;
+	}
+
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	unlocked_build_flat_events ();
+}
+
+void
+ControlList::unlocked_build_flat_events () const
+{
+	if (flat_events_valid () || _sort_pending) {
+		return;
+	}
+
+	_flat_events.when.clear ();
+	_flat_events.events.clear ();
+	_flat_events.when.reserve (_events.size());
+	_flat_events.events.reserve (_events.size());
+
+	for (const_iterator i = _events.begin(); i != _events.end(); ++i) {
+		_flat_events.when.push_back ((*i)->when);
+		_flat_events.events.push_back (*i);
+	}
+
+	g_atomic_int_set (&_flat_dirty, 0);
+}
+
 void
 ControlList::truncate_end (double last_coordinate)
 {
@@ -1235,6 +1275,10 @@ ControlList::multipoint_eval (double x) const
 	double uval, lval;
 	double fraction;
 
+	if (flat_events_valid ()) {
+		return flat_multipoint_eval (x);
+	}
+
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
@@ -1302,6 +1346,34 @@ ControlList::multipoint_eval (double x) const
 	return (*range.first)->value;
 }
 
+/** Binary-search equivalent of multipoint_eval() using the flat events.
+ *  As there, x is known to lie after the first point and before the last.
+ */
+double
+ControlList::flat_multipoint_eval (double x) const
+{
+	const vector<double>& when (_flat_events.when);
+	const vector<double>::size_type i = lower_bound (when.begin(), when.end(), x) - when.begin();
+
+	assert (i > 0 && i < when.size());
+
+	const ControlEvent* const after = _flat_events.events[i];
+
+	if (when[i] == x) {
+		/* x is a control point in the data */
+		return after->value;
+	}
+
+	const ControlEvent* const before = _flat_events.events[i - 1];
+
+	if (_interpolation == Discrete) {
+		return before->value;
+	}
+
+	const double fraction = (double) (x - before->when) / (double) (after->when - before->when);
+	return before->value + (fraction * (after->value - before->value));
+}
+
 void
 ControlList::build_search_cache_if_necessary (double start) const
 {
@@ -16,6 +16,7 @@
  * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <algorithm>
 #include <iostream>
 #include <float.h>
 #include <cmath>
@@ -184,6 +185,8 @@ Curve::rt_safe_get_vector (double x0, double x1, float *vec, int32_t veclen)
 void
 Curve::get_vector (double x0, double x1, float *vec, int32_t veclen)
 {
+	_list.build_flat_events_if_necessary ();
+
 	Glib::Threads::RWLock::ReaderLock lm(_list.lock());
 	_get_vector (x0, x1, vec, veclen);
 }
@@ -323,11 +326,79 @@ Curve::_get_vector (double x0, double x1, float *vec, int32_t veclen)
 		dx = (hx - lx) / (veclen - 1);
 	}
 
+	if (dx >= 0 && _list.flat_events_valid ()) {
+		flat_get_vector (rx, dx, vec, veclen);
+		return;
+	}
+
 	for (i = 0; i < veclen; ++i, rx += dx) {
 		vec[i] = multipoint_eval (rx);
 	}
 }
 
+/** Fill @param vec with the values at @param rx, @param rx + @param dx, ...
+ *  using the flat events.  The segment containing each value is found by
+ *  walking forwards from the previous one, and every run of values within
+ *  the same segment is then computed in one pass.  The results are the
+ *  same as those of multipoint_eval().
+ */
+void
+Curve::flat_get_vector (double rx, double dx, float *vec, int32_t veclen)
+{
+	const ControlList::FlatEvents& flat (_list.flat_events());
+	const vector<double>& when (flat.when);
+	const vector<double>::size_type npoints = when.size();
+	const bool curved = (_list.interpolation() == ControlList::Curved);
+
+	vector<double>::size_type n = lower_bound (when.begin(), when.end(), rx) - when.begin();
+	int32_t i = 0;
+
+	while (i < veclen) {
+
+		while (n < npoints && when[n] < rx) {
+			++n;
+		}
+
+		if (n == npoints) {
+			/* we're after the last point */
+			const float val = flat.events.back()->value;
+			while (i < veclen) {
+				vec[i++] = val;
+			}
+			return;
+		}
+
+		if (when[n] == rx || n == 0) {
+			/* x is a control point in the data, or we're before the first point */
+			vec[i++] = flat.events[n]->value;
+			rx += dx;
+			continue;
+		}
+
+		const ControlEvent* const before = flat.events[n - 1];
+		const ControlEvent* const after = flat.events[n];
+		const double upto = when[n];
+		const double vdelta = after->value - before->value;
+
+		if (vdelta == 0.0) {
+			for (; i < veclen && rx < upto; ++i, rx += dx) {
+				vec[i] = before->value;
+			}
+		} else if (curved && after->coeff) {
+			const double* const c = after->coeff;
+			for (; i < veclen && rx < upto; ++i, rx += dx) {
+				const double x2 = rx * rx;
+				vec[i] = c[0] + (c[1] * rx) + (c[2] * x2) + (c[3] * x2 * rx);
+			}
+		} else {
+			const double trange = after->when - before->when;
+			for (; i < veclen && rx < upto; ++i, rx += dx) {
+				vec[i] = before->value + (vdelta * ((rx - before->when) / trange));
+			}
+		}
+	}
+}
+
 double
 Curve::multipoint_eval (double x)
 {
@@ -19,7 +19,12 @@
 #include <cassert>
 #include <iostream>
 #include <limits>
+#include <new>
 #include <glib.h>
+#include <string.h>
+
+#include <boost/pool/singleton_pool.hpp>
+
 #ifndef COMPILER_MSVC
 #include "evoral/Note.hpp"
 #endif
@@ -30,8 +35,8 @@ namespace Evoral {
 
 template<typename Time>
 Note<Time>::Note(uint8_t chan, Time t, Time l, uint8_t n, uint8_t v)
-	: _on_event (MIDI_EVENT, t, 3, NULL, true)
-	, _off_event (MIDI_EVENT, t + l, 3, NULL, true)
+	: _on_event (MIDI_EVENT, t, 3, _on_event_buffer, false)
+	, _off_event (MIDI_EVENT, t + l, 3, _off_event_buffer, false)
 {
 	assert(chan < 16);
 
@@ -54,22 +59,16 @@ Note<Time>::Note(uint8_t chan, Time t, Time l, uint8_t n, uint8_t v)
 
 template<typename Time>
 Note<Time>::Note(const Note<Time>& copy)
-	: _on_event(copy._on_event, true)
-	, _off_event(copy._off_event, true)
+	: _on_event (copy._on_event.event_type(), copy.time(), 3, _on_event_buffer, false)
+	, _off_event (copy._off_event.event_type(), copy.end_time(), 3, _off_event_buffer, false)
 {
 	set_id (copy.id());
 
-	assert(_on_event.buffer());
-	assert(_off_event.buffer());
-	/*
-	  assert(copy._on_event.size == 3);
-	  _on_event.buffer = _on_event_buffer;
-	  memcpy(_on_event_buffer, copy._on_event_buffer, 3);
+	assert(copy._on_event.size() == 3);
+	memcpy(_on_event_buffer, copy._on_event.buffer(), 3);
 
-	  assert(copy._off_event.size == 3);
-	  _off_event.buffer = _off_event_buffer;
-	  memcpy(_off_event_buffer, copy._off_event_buffer, 3);
-	*/
+	assert(copy._off_event.size() == 3);
+	memcpy(_off_event_buffer, copy._off_event.buffer(), 3);
 
 	assert(time() == copy.time());
 	assert(end_time() == copy.end_time());
@@ -85,6 +84,47 @@ Note<Time>::~Note()
 {
 }
 
+#ifndef COMPILER_MSVC
+
+struct NotePoolTag {};
+
+template<typename Time> void*
+Note<Time>::operator new (size_t size)
+{
+	typedef boost::singleton_pool<NotePoolTag, sizeof (Note<Time>)> Pool;
+
+	if (size != sizeof (Note<Time>)) {
+		return ::operator new (size);
+	}
+
+	void* p = Pool::malloc ();
+
+	if (!p) {
+		throw std::bad_alloc ();
+	}
+
+	return p;
+}
+
+template<typename Time> void
+Note<Time>::operator delete (void* p, size_t size)
+{
+	typedef boost::singleton_pool<NotePoolTag, sizeof (Note<Time>)> Pool;
+
+	if (!p) {
+		return;
+	}
+
+	if (size != sizeof (Note<Time>)) {
+		::operator delete (p);
+		return;
+	}
+
+	Pool::free (p);
+}
+
+#endif
+
 template<typename Time> void
 Note<Time>::set_id (event_id_t id)
 {
@@ -261,6 +261,47 @@ SMF::seek_to_start() const
 	}
 }
 
+/** Seek to the first event at or after \a tick, by binary search over the
+ * events of the track (which are all in memory, in time order).
+ *
+ * \return the time in ticks of the event before it (0 if there is none), to
+ * which the delta time of the next event read is relative.
+ */
+uint64_t
+SMF::seek_to_tick(uint64_t tick) const
+{
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+	if (!_smf_track) {
+		cerr << "WARNING: SMF seek_to_tick() with no track" << endl;
+		return 0;
+	}
+
+	/* events are numbered from 1 */
+	size_t lo = 1;
+	size_t hi = _smf_track->number_of_events + 1;
+
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		if (smf_track_get_event_by_number(_smf_track, mid)->time_pulses < tick) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if (lo > _smf_track->number_of_events) {
+		/* past the last event */
+		_smf_track->next_event_number = 0;
+	} else {
+		_smf_track->next_event_number = lo;
+	}
+
+	if (lo > 1) {
+		return smf_track_get_event_by_number(_smf_track, lo - 1)->time_pulses;
+	}
+	return 0;
+}
+
 /** Read an event from the current position in file.
  *
  * File position MUST be at the beginning of a delta time, or this will die very messily.
@@ -111,23 +111,10 @@ Sequence<Time>::const_iterator::const_iterator(const Sequence<Time>&
 	_note_iter = seq.note_lower_bound(t);
 
 	// Find first sysex event at or after t
-	for (typename Sequence<Time>::SysExes::const_iterator i = seq.sysexes().begin();
-	     i != seq.sysexes().end(); ++i) {
-		if ((*i)->time() >= t) {
-			_sysex_iter = i;
-			break;
-		}
-	}
-	assert(_sysex_iter == seq.sysexes().end() || (*_sysex_iter)->time() >= t);
+	_sysex_iter = seq.sysex_lower_bound(t);
 
 	// Find first patch event at or after t
-	for (typename Sequence<Time>::PatchChanges::const_iterator i = seq.patch_changes().begin(); i != seq.patch_changes().end(); ++i) {
-		if ((*i)->time() >= t) {
-			_patch_change_iter = i;
-			break;
-		}
-	}
-	assert (_patch_change_iter == seq.patch_changes().end() || (*_patch_change_iter)->time() >= t);
+	_patch_change_iter = seq.patch_change_lower_bound(t);
 
 	// Find first control event after t
 	_control_iters.reserve(seq._controls.size());
@@ -493,7 +480,8 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
 		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		_notes.insert (_notes.end(), n);
+		_pitches[n->channel()].insert (n);
 	}
 
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
@@ -611,6 +599,11 @@ Sequence<Time>::clear()
 {
 	WriteLock lock(write_lock());
 	_notes.clear();
+	_notes_by_id.clear ();
+	for (int c = 0; c < 16; ++c) {
+		_pitches[c].clear ();
+	}
+	update_note_range ();
 	for (Controls::iterator li = _controls.begin(); li != _controls.end(); ++li)
 		li->second->list()->clear();
 }
@@ -663,12 +656,14 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 			case DeleteStuckNotes:
 				cerr << "WARNING: Stuck note lost: " << (*n)->note() << endl;
 				_notes.erase(n);
+				_notes_by_id.clear ();
 				break;
 			case ResolveStuckNotes:
 				if (when <= (*n)->time()) {
 					cerr << "WARNING: Stuck note resolution - end time @ "
 					     << when << " is before note on: " << (**n) << endl;
 					_notes.erase (*n);
+					_notes_by_id.clear ();
 				} else {
 					(*n)->set_length (when - (*n)->time());
 					cerr << "WARNING: resolved note-on with no note-off to generate " << (**n) << endl;
@@ -711,8 +706,12 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	if (note->note() > _highest_note)
 		_highest_note = note->note();
 
-	_notes.insert (note);
+	/* notes are usually added in time order (e.g. when a model is loaded),
+	   and inserting with a hint at the end is then constant time.
+	*/
+	_notes.insert (_notes.end(), note);
 	_pitches[note->channel()].insert (note);
+	_notes_by_id.clear ();
 
 	_edited = true;
 
@@ -743,20 +742,6 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 			_notes.erase (i);
-
-			if (note->note() == _lowest_note || note->note() == _highest_note) {
-
-				_lowest_note = 127;
-				_highest_note = 0;
-
-				for (typename Sequence<Time>::Notes::iterator ii = _notes.begin(); ii != _notes.end(); ++ii) {
-					if ((*ii)->note() < _lowest_note)
-						_lowest_note = (*ii)->note();
-					if ((*ii)->note() > _highest_note)
-						_highest_note = (*ii)->note();
-				}
-			}
-
 			erased = true;
 			break;
 		}
@@ -783,20 +768,6 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 				DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\tID-based pass, erasing note #%2 %3 @ %4\n", this, (*i)->id(), (int)(*i)->note(), (*i)->time()));
 				_notes.erase (i);
-
-				if (note->note() == _lowest_note || note->note() == _highest_note) {
-
-					_lowest_note = 127;
-					_highest_note = 0;
-
-					for (typename Sequence<Time>::Notes::iterator ii = _notes.begin(); ii != _notes.end(); ++ii) {
-						if ((*ii)->note() < _lowest_note)
-							_lowest_note = (*ii)->note();
-						if ((*ii)->note() > _highest_note)
-							_highest_note = (*ii)->note();
-					}
-				}
-
 				erased = true;
 				id_matched = true;
 				break;
@@ -848,6 +819,11 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 			warning << string_compose ("erased note %1 not found in pitches for channel %2", *note, (int) note->channel()) << endmsg;
 		}
 
+		if (note->note() == _lowest_note || note->note() == _highest_note) {
+			update_note_range ();
+		}
+
+		_notes_by_id.clear ();
 		_edited = true;
 
 	} else {
@@ -1187,6 +1163,72 @@ void
 Sequence<Time>::set_notes (const typename Sequence<Time>::Notes& n)
 {
 	_notes = n;
+	_notes_by_id.clear ();
+
+	for (int c = 0; c < 16; ++c) {
+		_pitches[c].clear ();
+	}
+
+	for (typename Notes::const_iterator i = _notes.begin(); i != _notes.end(); ++i) {
+		_pitches[(*i)->channel()].insert (*i);
+	}
+
+	update_note_range ();
+}
+
+/** Recompute the lowest and highest note numbers from the pitch indices */
+template<typename Time>
+void
+Sequence<Time>::update_note_range ()
+{
+	_lowest_note = 127;
+	_highest_note = 0;
+
+	for (int c = 0; c < 16; ++c) {
+		if (!_pitches[c].empty()) {
+			_lowest_note = std::min (_lowest_note, (*_pitches[c].begin())->note());
+			_highest_note = std::max (_highest_note, (*_pitches[c].rbegin())->note());
+		}
+	}
+}
+
+namespace {
+
+struct EarlierNoteId {
+	template<typename NotePtr>
+	bool operator() (NotePtr const & a, NotePtr const & b) const {
+		return a->id() < b->id();
+	}
+	template<typename NotePtr>
+	bool operator() (NotePtr const & a, event_id_t b) const {
+		return a->id() < b;
+	}
+};
+
+} /* anonymous namespace */
+
+/** Return the note with ID @param id, or a null pointer if there is none.
+ *
+ *  Finding a note by ID takes O(log N) time, except that the first lookup
+ *  after notes have been added or removed takes O(N log N) time. Call this
+ *  from the GUI thread, or with the write lock held.
+ */
+template<typename Time>
+typename Sequence<Time>::NotePtr
+Sequence<Time>::note_by_id (event_id_t id)
+{
+	if (_notes_by_id.size() != _notes.size()) {
+		_notes_by_id.assign (_notes.begin(), _notes.end());
+		std::sort (_notes_by_id.begin(), _notes_by_id.end(), EarlierNoteId());
+	}
+
+	typename std::vector<NotePtr>::const_iterator i = std::lower_bound (_notes_by_id.begin(), _notes_by_id.end(), id, EarlierNoteId());
+
+	if (i != _notes_by_id.end() && (*i)->id() == id) {
+		return *i;
+	}
+
+	return NotePtr ();
 }
 
 // CONST iterator implementations (x3)
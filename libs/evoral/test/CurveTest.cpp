@@ -472,3 +472,62 @@ CurveTest::constrainedCubic ()
 		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, g[x], 0.000008);
 	}
 }
+
+/* Evaluation using the flat events must give the same results as
+ * walking the list.  (Evaluating exactly at a control point may differ
+ * in the last bit, as the list walk may interpolate right up to it.)
+ */
+void
+CurveTest::flatEvents ()
+{
+	float list_vec[4096];
+	float flat_vec[4096];
+
+	static const ControlList::InterpolationStyle styles[] = {
+		ControlList::Discrete, ControlList::Linear, ControlList::Curved
+	};
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+
+		boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+		cl->create_curve ();
+		cl->set_interpolation (styles[s]);
+
+		for (int i = 0; i < 1000; ++i) {
+			/* include a few coincident points (vertical steps), which
+			 * the spline solver does not cope with
+			 */
+			bool const step = (styles[s] != ControlList::Curved && i % 50 == 1);
+			cl->fast_simple_add ((step ? i - 1 : i) * 64.0, (i * 7919) % 1000 / 1000.0);
+		}
+
+		/* fast_simple_add() and mark_dirty() leave the flat events
+		 * to be rebuilt, so the RT-safe variants walk the list.
+		 */
+		cl->mark_dirty ();
+		CPPUNIT_ASSERT (!cl->flat_events_valid ());
+
+		std::vector<double> list_vals;
+		for (double x = -100.25; x < 64100.0; x += 37.5) {
+			bool ok;
+			list_vals.push_back (cl->rt_safe_eval (x, ok));
+			CPPUNIT_ASSERT (ok);
+		}
+		CPPUNIT_ASSERT (cl->curve().rt_safe_get_vector (-1000.0, 66000.0, list_vec, 4096));
+
+		/* get_vector() builds the flat events, which are then used by
+		 * both the vector and the single-point evaluation.
+		 */
+		cl->curve().get_vector (-1000.0, 66000.0, flat_vec, 4096);
+		CPPUNIT_ASSERT (cl->flat_events_valid ());
+
+		for (int i = 0; i < 4096; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (list_vec[i], flat_vec[i], 1e-6);
+		}
+
+		size_t n = 0;
+		for (double x = -100.25; x < 64100.0; x += 37.5, ++n) {
+			CPPUNIT_ASSERT_EQUAL (list_vals[n], cl->eval (x));
+		}
+	}
+}
@@ -13,6 +13,7 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (flatEvents);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -23,6 +24,7 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void flatEvents ();
 
 private:
 	boost::shared_ptr<Evoral::ControlList> TestCtrlList() {
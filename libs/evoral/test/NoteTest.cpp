@@ -16,6 +16,16 @@ NoteTest::copyTest ()
 	Note<Time> b(a);
 	CPPUNIT_ASSERT (a == b);
 
+	// Copies must not share event buffers
+	b.set_note (61);
+	b.set_velocity (0x41);
+	b.set_off_velocity (0x42);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 60, a.note());
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x40, a.velocity());
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x40, a.off_velocity());
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 61, b.off_event().note());
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x42, b.off_velocity());
+
 	// Broken due to event double free!
 	// Note<Time> c(1, Beats(3.0), Beats(4.0), 61, 0x41);
 	// c = a;
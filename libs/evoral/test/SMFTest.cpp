@@ -1,5 +1,8 @@
 #include "SMFTest.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
@@ -117,3 +120,54 @@ SMFTest::writeTest ()
 
 	// TODO: Check files are actually equivalent
 }
+
+void
+SMFTest::seekTest ()
+{
+	TestSMF smf;
+	string  testdata_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TakeFive.mid", testdata_path));
+
+	smf.open(testdata_path);
+	CPPUNIT_ASSERT(!smf.is_empty());
+
+	/* times of all events, read from the start */
+	vector<uint64_t> times;
+	uint64_t time    = 0;
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+
+	smf.seek_to_start();
+	while (smf.read_event(&delta_t, &size, &buf) >= 0) {
+		time += delta_t;
+		times.push_back (time);
+	}
+	CPPUNIT_ASSERT(!times.empty());
+
+	/* seeking to each event's time, and between events, gives the first
+	 * event at or after that time, with the time of the one before it
+	 */
+	for (size_t n = 0; n < times.size(); n += 7) {
+		const uint64_t ticks[] = { times[n], times[n] + 1 };
+		for (size_t t = 0; t < 2; ++t) {
+			const size_t first = lower_bound (times.begin(), times.end(), ticks[t]) - times.begin();
+			const uint64_t before = smf.seek_to_tick (ticks[t]);
+
+			CPPUNIT_ASSERT_EQUAL (first > 0 ? times[first - 1] : uint64_t(0), before);
+
+			if (first == times.size()) {
+				CPPUNIT_ASSERT_EQUAL (-1, smf.read_event(&delta_t, &size, &buf));
+			} else {
+				CPPUNIT_ASSERT (smf.read_event(&delta_t, &size, &buf) >= 0);
+				CPPUNIT_ASSERT_EQUAL (times[first], before + delta_t);
+			}
+		}
+	}
+
+	/* past the end */
+	CPPUNIT_ASSERT_EQUAL (times.back(), smf.seek_to_tick (times.back() + 1));
+	CPPUNIT_ASSERT_EQUAL (-1, smf.read_event(&delta_t, &size, &buf));
+
+	free (buf);
+}
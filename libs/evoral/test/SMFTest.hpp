@@ -55,6 +55,7 @@ class SMFTest : public CppUnit::TestFixture
 	CPPUNIT_TEST(createNewFileTest);
 	CPPUNIT_TEST(takeFiveTest);
 	CPPUNIT_TEST(writeTest);
+	CPPUNIT_TEST(seekTest);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -75,6 +76,7 @@ public:
 	void createNewFileTest();
 	void takeFiveTest();
 	void writeTest();
+	void seekTest();
 
 private:
 	DummyTypeMap*     type_map;
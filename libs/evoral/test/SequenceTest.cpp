@@ -194,3 +194,40 @@ SequenceTest::controlInterpolationTest ()
 		last_value = i->second;
 	}
 }
+
+void
+SequenceTest::noteIndexTest ()
+{
+	seq->clear();
+
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		CPPUNIT_ASSERT(seq->add_note_unlocked(*i));
+	}
+
+	CPPUNIT_ASSERT_EQUAL((uint8_t) 64, seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL((uint8_t) 75, seq->highest_note());
+
+	// Every note can be found by its ID
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		CPPUNIT_ASSERT((*i)->id() >= 0);
+		CPPUNIT_ASSERT(seq->note_by_id((*i)->id()) == *i);
+	}
+
+	// Removing the lowest and highest notes narrows the range, and they can
+	// no longer be found
+	seq->remove_note_unlocked(test_notes.front());
+	seq->remove_note_unlocked(test_notes.back());
+
+	CPPUNIT_ASSERT_EQUAL((uint8_t) 65, seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL((uint8_t) 74, seq->highest_note());
+	CPPUNIT_ASSERT(!seq->note_by_id(test_notes.front()->id()));
+	CPPUNIT_ASSERT(!seq->note_by_id(test_notes.back()->id()));
+	CPPUNIT_ASSERT(seq->note_by_id(test_notes[5]->id()) == test_notes[5]);
+
+	// A note added after a lookup can be found too
+	boost::shared_ptr< Note<Time> > n (new Note<Time>(1, Beats(250), Beats(10), 20, 64));
+	CPPUNIT_ASSERT(seq->add_note_unlocked(n));
+	CPPUNIT_ASSERT(seq->note_by_id(n->id()) == n);
+	CPPUNIT_ASSERT_EQUAL((uint8_t) 20, seq->lowest_note());
+	CPPUNIT_ASSERT_EQUAL(size_t(11), seq->notes().size());
+}
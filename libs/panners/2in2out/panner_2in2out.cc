@@ -451,9 +451,7 @@ Panner2in2out::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
 	dst = obufs.get_audio(0).data();
 	pbuf = buffers[0];
 
-	for (pframes_t n = 0; n < nframes; ++n) {
-		dst[n] += src[n] * pbuf[n];
-	}
+	mix_buffers_with_gain_curve (dst, src, nframes, pbuf);
 
 	/* XXX it would be nice to mark the buffer as written to */
 
@@ -462,9 +460,7 @@ Panner2in2out::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
 	dst = obufs.get_audio(1).data();
 	pbuf = buffers[1];
 
-	for (pframes_t n = 0; n < nframes; ++n) {
-		dst[n] += src[n] * pbuf[n];
-	}
+	mix_buffers_with_gain_curve (dst, src, nframes, pbuf);
 
 	/* XXX it would be nice to mark the buffer as written to */
 }
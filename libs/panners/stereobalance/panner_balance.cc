@@ -253,9 +253,7 @@ Pannerbalance::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
 	dst = obufs.get_audio(which).data();
 	pbuf = buffers[which];
 
-	for (pframes_t n = 0; n < nframes; ++n) {
-		dst[n] += src[n] * pbuf[n];
-	}
+	mix_buffers_with_gain_curve (dst, src, nframes, pbuf);
 
 	/* XXX it would be nice to mark the buffer as written to */
 }
@@ -32,11 +32,15 @@
 #include "pbd/cartesian.h"
 #include "pbd/compose.h"
 
+#include "evoral/Curve.hpp"
+
 #include "ardour/amp.h"
 #include "ardour/audio_buffer.h"
+#include "ardour/automation_list.h"
 #include "ardour/buffer_set.h"
 #include "ardour/pan_controllable.h"
 #include "ardour/pannable.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/speakers.h"
 
 #include "vbap.h"
@@ -59,6 +63,11 @@ static PanPluginDescriptor _descriptor = {
 
 extern "C" ARDOURPANNER_API PanPluginDescriptor* panner_descriptor () { return &_descriptor; }
 
+/** Number of samples over which speaker gains are interpolated when
+ *  following automation; the direction is evaluated once for each.
+ */
+static const pframes_t interpolation_interval = 64;
+
 VBAPanner::Signal::Signal (Session&, VBAPanner&, uint32_t, uint32_t n_speakers)
 {
         resize_gains (n_speakers);
@@ -122,35 +131,39 @@ void
 VBAPanner::update ()
 {
         /* recompute signal directions based on panner azimuth and, if relevant, width (diffusion) and elevation parameters */
-        double elevation = _pannable->pan_elevation_control->get_value() * 90.0;
-
-        if (_signals.size() > 1) {
-                double w = - (_pannable->pan_width_control->get_value());
-                double signal_direction = 1.0 - (_pannable->pan_azimuth_control->get_value() + (w/2));
-                double grd_step_per_signal = w / (_signals.size() - 1);
-                for (vector<Signal*>::iterator s = _signals.begin(); s != _signals.end(); ++s) {
-
-                        Signal* signal = *s;
+        double const azimuth = _pannable->pan_azimuth_control->get_value();
+        double const width = _pannable->pan_width_control->get_value();
+        double const elevation = _pannable->pan_elevation_control->get_value();
+
+        for (uint32_t n = 0; n < _signals.size(); ++n) {
+                Signal* signal = _signals[n];
+                signal->direction = signal_direction (n, azimuth, width, elevation);
+                compute_gains (signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
+        }
 
-                        int over = signal_direction;
-                        over -= (signal_direction >= 0) ? 0 : 1;
-                        signal_direction -= (double)over;
+        SignalPositionChanged(); /* emit */
+}
 
-                        signal->direction = AngularVector (signal_direction * 360.0, elevation);
-                        compute_gains (signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
-                        signal_direction += grd_step_per_signal;
-                }
-        } else if (_signals.size() == 1) {
-                double center = (1.0 - _pannable->pan_azimuth_control->get_value()) * 360.0;
+/** @return direction of signal @a which for the given values of the
+ *  azimuth, width and elevation controls.
+ */
+AngularVector
+VBAPanner::signal_direction (uint32_t which, double azimuth, double width, double elevation) const
+{
+        if (_signals.size() > 1) {
+                double w = - width;
+                double direction = 1.0 - (azimuth + (w/2)) + which * (w / (_signals.size() - 1));
 
-                /* width has no role to play if there is only 1 signal: VBAP does not do "diffusion" of a single channel */
+                int over = direction;
+                over -= (direction >= 0) ? 0 : 1;
+                direction -= (double)over;
 
-                Signal* s = _signals.front();
-                s->direction = AngularVector (center, elevation);
-                compute_gains (s->desired_gains, s->desired_outputs, s->direction.azi, s->direction.ele);
+                return AngularVector (direction * 360.0, elevation * 90.0);
         }
 
-        SignalPositionChanged(); /* emit */
+        /* width has no role to play if there is only 1 signal: VBAP does not do "diffusion" of a single channel */
+
+        return AngularVector ((1.0 - azimuth) * 360.0, elevation * 90.0);
 }
 
 void
@@ -355,11 +368,114 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
 }
 
 void
-VBAPanner::distribute_one_automated (AudioBuffer& /*src*/, BufferSet& /*obufs*/,
-                                     framepos_t /*start*/, framepos_t /*end*/,
-				     pframes_t /*nframes*/, pan_t** /*buffers*/, uint32_t /*which*/)
+VBAPanner::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
+                                     framepos_t start, framepos_t end,
+				     pframes_t nframes, pan_t** buffers, uint32_t which)
 {
-	/* XXX to be implemented */
+	Sample* const src = srcbuf.data();
+	Signal* signal (_signals[which]);
+
+	assert (signal->gains.size() == obufs.count().n_audio());
+
+	/* fetch the automation of the controls which apply; the others keep
+	   their current values. There are at least as many buffers as
+	   speakers, and elevation is only used with 3 or more speakers.
+	*/
+
+	pan_t* const azimuth = buffers[0];
+	pan_t* const width = (_signals.size() > 1 && !_pannable->pan_width_control->list()->empty()) ? buffers[1] : 0;
+	pan_t* const elevation = (_speakers->dimension() == 3 && !_pannable->pan_elevation_control->list()->empty()) ? buffers[2] : 0;
+
+	bool ok = _pannable->pan_azimuth_control->list()->curve().rt_safe_get_vector (start, end, azimuth, nframes);
+
+	if (ok && width) {
+		ok = _pannable->pan_width_control->list()->curve().rt_safe_get_vector (start, end, width, nframes);
+	}
+
+	if (ok && elevation) {
+		ok = _pannable->pan_elevation_control->list()->curve().rt_safe_get_vector (start, end, elevation, nframes);
+	}
+
+	if (!ok) {
+		/* fallback */
+		distribute_one (srcbuf, obufs, 1.0, nframes, which);
+		memcpy (signal->outputs, signal->desired_outputs, sizeof (signal->outputs));
+		return;
+	}
+
+	double const fixed_width = _pannable->pan_width_control->get_value();
+	double const fixed_elevation = _pannable->pan_elevation_control->get_value();
+
+	/* move the signal once for each interval, ramping the speaker gains
+	   from where the last one ended to the direction at its end.
+	*/
+
+	for (pframes_t offset = 0; offset < nframes; offset += interpolation_interval) {
+
+		pframes_t const len = min (interpolation_interval, nframes - offset);
+		pframes_t const last = offset + len - 1;
+
+		AngularVector const direction = signal_direction (which, azimuth[last],
+		                                                  width ? width[last] : fixed_width,
+		                                                  elevation ? elevation[last] : fixed_elevation);
+
+		compute_gains (signal->desired_gains, signal->desired_outputs, direction.azi, direction.ele);
+
+		/* the azimuth data for this interval has been used, so its
+		   space can hold the gain ramps.
+		*/
+
+		mix_block (src, obufs, offset, len, azimuth + offset, signal);
+	}
+
+	memcpy (signal->outputs, signal->desired_outputs, sizeof (signal->outputs));
+}
+
+/** Mix @a len samples of @a src from @a offset into every speaker which
+ *  has a gain for the signal at the start or the end of them, moving the
+ *  gains to signal->desired_gains.
+ *
+ *  @param ramp space for @a len gain coefficients
+ */
+void
+VBAPanner::mix_block (Sample const * src, BufferSet& obufs, pframes_t offset, pframes_t len, pan_t* ramp, Signal* signal)
+{
+	uint32_t const n_outputs = signal->gains.size();
+
+	for (uint32_t o = 0; o < n_outputs; ++o) {
+
+		double target = 0.0;
+
+		for (int n = 0; n < 3; ++n) {
+			if (signal->desired_outputs[n] == (int) o) {
+				target = signal->desired_gains[n];
+			}
+		}
+
+		double const current = signal->gains[o];
+
+		if (current == 0.0 && target == 0.0) {
+			continue;
+		}
+
+		Sample* const dst = obufs.get_audio (o).data() + offset;
+
+		if (fabs (target - current) > 0.00001) {
+
+			pan_t const delta = (target - current) / len;
+
+			for (pframes_t n = 0; n < len; ++n) {
+				ramp[n] = current + delta * n;
+			}
+
+			mix_buffers_with_gain_curve (dst, src + offset, len, ramp);
+
+		} else {
+			mix_buffers_with_gain (dst, src + offset, len, target);
+		}
+
+		signal->gains[o] = target;
+	}
 }
 
 XMLNode&
@@ -83,6 +83,8 @@ private:
         boost::shared_ptr<VBAPSpeakers>  _speakers;
 
 	void compute_gains (double g[3], int ls[3], int azi, int ele);
+	PBD::AngularVector signal_direction (uint32_t which, double azimuth, double width, double elevation) const;
+	void mix_block (Sample const * src, BufferSet& obufs, pframes_t offset, pframes_t len, pan_t* ramp, Signal* signal);
         void update ();
         void clear_signals ();
 
@@ -49,6 +49,16 @@ public:
 		return false;
 	}
 
+	/** @return estimate of the memory this command holds, in bytes */
+	virtual size_t memory_cost () const {
+		return sizeof (Command) + _name.capacity ();
+	}
+
+	/** Called once the command is complete and kept only for undo/redo,
+	 *  to hold its state in a more compact form.
+	 */
+	virtual void compact () {}
+
 protected:
 	Command() {}
 	Command(const std::string& name) : _name(name) {}
@@ -27,6 +27,7 @@
 #include "pbd/command.h"
 #include "pbd/stacktrace.h"
 #include "pbd/xml++.h"
+#include "pbd/xml_delta.h"
 #include "pbd/demangle.h"
 
 #include <sigc++/slot.h>
@@ -98,20 +99,23 @@ private:
 /** This command class is initialized with before and after mementos
  * (from Stateful::get_state()), so undo becomes restoring the before
  * memento, and redo is restoring the after memento.
+ *
+ * Once compacted, the after memento is kept as its differences from the
+ * before memento.
  */
 template <class obj_T>
 class LIBPBD_TEMPLATE_API MementoCommand : public Command
 {
 public:
 	MementoCommand (obj_T& a_object, XMLNode* a_before, XMLNode* a_after)
-		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after)
+		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after), after_delta (0)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, boost::bind (&MementoCommand::binder_dying, this));
 	}
 
 	MementoCommand (MementoCommandBinder<obj_T>* b, XMLNode* a_before, XMLNode* a_after)
-		: _binder (b), before (a_before), after (a_after)
+		: _binder (b), before (a_before), after (a_after), after_delta (0)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, boost::bind (&MementoCommand::binder_dying, this));
@@ -121,6 +125,7 @@ public:
 		drop_references ();
 		delete before;
 		delete after;
+		delete after_delta;
 		delete _binder;
 	}
 
@@ -131,6 +136,10 @@ public:
 	void operator() () {
 		if (after) {
 			_binder->get()->set_state(*after, Stateful::current_state_version);
+		} else if (after_delta) {
+			XMLNode* a = PBD::xml_apply_delta (*before, *after_delta);
+			_binder->get()->set_state(*a, Stateful::current_state_version);
+			delete a;
 		}
 	}
 
@@ -142,7 +151,7 @@ public:
 
 	virtual XMLNode &get_state() {
 		std::string name;
-		if (before && after) {
+		if (before && (after || after_delta)) {
 			name = "MementoCommand";
 		} else if (before) {
 			name = "MementoUndoCommand";
@@ -161,15 +170,42 @@ public:
 
 		if (after) {
 			node->add_child_copy(*after);
+		} else if (after_delta) {
+			node->add_child_nocopy(*PBD::xml_apply_delta (*before, *after_delta));
 		}
 
 		return *node;
 	}
 
+	size_t memory_cost () const {
+		size_t cost = sizeof (*this) + _name.capacity ();
+		if (before) {
+			cost += before->memory_cost ();
+		}
+		if (after) {
+			cost += after->memory_cost ();
+		}
+		if (after_delta) {
+			cost += after_delta->memory_cost ();
+		}
+		return cost;
+	}
+
+	void compact () {
+		if (!before || !after) {
+			return;
+		}
+		if ((after_delta = PBD::xml_delta (*before, *after)) != 0) {
+			delete after;
+			after = 0;
+		}
+	}
+
 protected:
 	MementoCommandBinder<obj_T>* _binder;
 	XMLNode* before;
 	XMLNode* after;
+	XMLNode* after_delta;
 	PBD::ScopedConnection _binder_death_connection;
 };
 
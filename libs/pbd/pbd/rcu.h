@@ -122,26 +122,7 @@ public:
 
 	boost::shared_ptr<T> write_copy ()
 	{
-		m_lock.lock();
-
-		// clean out any dead wood
-
-		typename std::list<boost::shared_ptr<T> >::iterator i;
-
-		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
-			if ((*i).unique()) {
-				i = m_dead_wood.erase (i);
-			} else {
-				++i;
-			}
-		}
-
-		/* store the current so that we can do compare and exchange
-		   when someone calls update(). Notice that we hold
-		   a lock, so this store of m_rcu_value is atomic.
-		*/
-
-		current_write_old = RCUManager<T>::x.m_rcu_value;
+		begin_write ();
 
 		boost::shared_ptr<T> new_copy (new T(**current_write_old));
 
@@ -152,6 +133,17 @@ public:
 		*/
 	}
 
+	/** As write_copy(), for writers that rebuild the value from scratch
+	 *  rather than modify the current one: returns a new, default
+	 *  constructed T instead of a copy. update() MUST be called as well.
+	 */
+	boost::shared_ptr<T> write_new ()
+	{
+		begin_write ();
+
+		return boost::shared_ptr<T> (new T);
+	}
+
 	bool update (boost::shared_ptr<T> new_value)
 	{
 		/* we still hold the write lock - other writers are locked out */
@@ -194,6 +186,30 @@ public:
 	}
 
 private:
+	void begin_write ()
+	{
+		m_lock.lock();
+
+		// clean out any dead wood
+
+		typename std::list<boost::shared_ptr<T> >::iterator i;
+
+		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
+			if ((*i).unique()) {
+				i = m_dead_wood.erase (i);
+			} else {
+				++i;
+			}
+		}
+
+		/* store the current so that we can do compare and exchange
+		   when someone calls update(). Notice that we hold
+		   a lock, so this store of m_rcu_value is atomic.
+		*/
+
+		current_write_old = RCUManager<T>::x.m_rcu_value;
+	}
+
 	Glib::Threads::Mutex                      m_lock;
 	boost::shared_ptr<T>*            current_write_old;
 	std::list<boost::shared_ptr<T> > m_dead_wood;
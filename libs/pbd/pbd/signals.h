@@ -24,6 +24,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #ifdef nil
 #undef nil
@@ -58,8 +59,9 @@ class LIBPBD_API SignalBase
 {
 public:
 	SignalBase ()
+		: _emitting (0)
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
-	: _debug_connection (false)
+		, _debug_connection (false)
 #endif
 	{}
 	virtual ~SignalBase () {}
@@ -69,7 +71,39 @@ public:
 #endif
 
 protected:
+	/** Counts an emission in progress for its lifetime */
+	class EmissionGuard {
+	public:
+		EmissionGuard (gint& emitting) : _emitting (emitting) { g_atomic_int_inc (&_emitting); }
+		~EmissionGuard () { g_atomic_int_add (&_emitting, -1); }
+	private:
+		gint& _emitting;
+	};
+
+	/** @return the index of @a c in @a slots, a vector of (connection, slot)
+	 *  pairs sorted by connection, or the index it would be inserted at.
+	 */
+	template<typename Slots>
+	static size_t slot_position (Slots const & slots, boost::shared_ptr<Connection> const & c) {
+		size_t lo = 0;
+		size_t hi = slots.size ();
+		while (lo < hi) {
+			size_t const mid = lo + (hi - lo) / 2;
+			if (slots[mid].first < c) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		return lo;
+	}
+
+	/* Held by connect and disconnect, never by emission */
 	mutable Glib::Threads::Mutex _mutex;
+	/* Emissions in progress, in any thread. Slot lists replaced while
+	 * this is not 0 may still be in use.
+	 */
+	gint _emitting;
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
 	bool _debug_connection;
 #endif
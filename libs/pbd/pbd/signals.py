@@ -101,20 +101,35 @@ def signal(f, n, v):
     print("private:", file=f)
 
     print("""
-	/** The slots that this signal will call on emission */
-	typedef std::map<boost::shared_ptr<Connection>, slot_function_type> Slots;
-	Slots _slots;
+	/** The slots that this signal will call on emission, sorted by
+	 *  connection. A list is never modified once it is in _slots:
+	 *  connect and disconnect put a modified copy in its place
+	 *  (read-copy-update), so that emission can use it without taking
+	 *  _mutex or copying it. 0 if there are no slots.
+	 */
+	typedef std::vector<std::pair<boost::shared_ptr<Connection>, slot_function_type> > Slots;
+	Slots* _slots;
+
+	/** Lists replaced while an emission was in progress, deleted once none is */
+	std::vector<Slots*> _retired;
 """, file=f)
 
     print("public:", file=f)
     print("", file=f)
+    print("\tSignal%d () : _slots (0) {}" % n, file=f)
+    print("", file=f)
     print("\t~Signal%d () {" % n, file=f)
 
     print("\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = _slots.begin(); i != _slots.end(); ++i) {" % typename, file=f)
-
-    print("\t\t\ti->first->signal_going_away ();", file=f)
+    print("\t\tif (_slots) {", file=f)
+    print("\t\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
+    print("\t\t\tfor (%sSlots::const_iterator i = _slots->begin(); i != _slots->end(); ++i) {" % typename, file=f)
+    print("\t\t\t\ti->first->signal_going_away ();", file=f)
+    print("\t\t\t}", file=f)
+    print("\t\t\tdelete _slots;", file=f)
+    print("\t\t}", file=f)
+    print("\t\tfor (%sstd::vector<Slots*>::const_iterator i = _retired.begin(); i != _retired.end(); ++i) {" % typename, file=f)
+    print("\t\t\tdelete *i;", file=f)
     print("\t\t}", file=f)
     print("\t}", file=f)
     print("", file=f)
@@ -230,34 +245,28 @@ def signal(f, n, v):
     else:
         print("\ttypename C::result_type operator() (%s)" % comma_separated(Anan), file=f)
     print("\t{", file=f)
-    print("\t\t/* First, take a copy of our list of slots as it is now */", file=f)
+    print("\t\t/* First, take our list of slots as it is now. It is not deleted", file=f)
+    print("\t\t   while we are emitting.", file=f)
+    print("\t\t*/", file=f)
     print("", file=f)
-    print("\t\tSlots s;", file=f)
-    print("\t\t{", file=f)
-    print("\t\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t\ts = _slots;", file=f)
-    print("\t\t}", file=f)
+    print("\t\tEmissionGuard eg (_emitting);", file=f)
+    print("\t\tSlots const * s = (Slots const *) g_atomic_pointer_get (&_slots);", file=f)
     print("", file=f)
     if not v:
         print("\t\tstd::list<R> r;", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = s.begin(); i != s.end(); ++i) {" % typename, file=f)
+    print("\t\tfor (size_t i = 0; s && i < s->size(); ++i) {", file=f)
     print("""
 			/* We may have just called a slot, and this may have resulted in
-			   disconnection of other slots from us.  The list copy means that
-			   this won't cause any problems with invalidated iterators, but we
-			   must check to see if the slot we are about to call is still on the list.
+			   disconnection of other slots from us.  Our list is not modified
+			   by that, so there are no problems with invalidated iterators, but
+			   we must check to see if the slot we are about to call is still
+			   connected.
 			*/
-			bool still_there = false;
-			{
-				Glib::Threads::Mutex::Lock lm (_mutex);
-				still_there = _slots.find (i->first) != _slots.end ();
-			}
-
-			if (still_there) {""", file=f)
+			if (still_connected (s, (*s)[i].first)) {""", file=f)
     if v:
-        print("\t\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
+        print("\t\t\t\t((*s)[i].second)(%s);" % comma_separated(an), file=f)
     else:
-        print("\t\t\t\tr.push_back ((i->second)(%s));" % comma_separated(an), file=f)
+        print("\t\t\t\tr.push_back (((*s)[i].second)(%s));" % comma_separated(an), file=f)
     print("\t\t\t}", file=f)
     print("\t\t}", file=f)
     print("", file=f)
@@ -270,13 +279,13 @@ def signal(f, n, v):
     print("""
 	bool empty () const {
 		Glib::Threads::Mutex::Lock lm (_mutex);
-		return _slots.empty ();
+		return !_slots;
 	}
 """, file=f)
     print("""
 	bool size () const {
 		Glib::Threads::Mutex::Lock lm (_mutex);
-		return _slots.size ();
+		return _slots ? _slots->size () : 0;
 	}
 """, file=f)
 
@@ -290,14 +299,55 @@ def signal(f, n, v):
     print("\tfriend class Connection;", file=f)
 
     print("""
+	/** @return true if @a c is in our current list of slots. Only to be
+	 *  called during an emission, which used @a s as its list.
+	 */
+	bool still_connected (Slots const * s, boost::shared_ptr<Connection> const & c)
+	{
+		Slots const * now = (Slots const *) g_atomic_pointer_get (&_slots);
+		if (now == s) {
+			return true;
+		}
+		if (!now) {
+			return false;
+		}
+		size_t const p = slot_position (*now, c);
+		return p < now->size () && (*now)[p].first == c;
+	}
+
+	/** Make @a s our list of slots. Must be called with _mutex held. */
+	void _set_slots (Slots* s)
+	{
+		Slots* old = _slots;
+
+		/* compare-and-exchange, rather than set, for a full barrier
+		   before we look at _emitting.
+		*/
+		g_atomic_pointer_compare_and_exchange (&_slots, old, s);
+
+		if (old) {
+			_retired.push_back (old);
+		}
+
+		/* An emission that starts from now on uses the new list */
+		if (g_atomic_int_get (&_emitting) == 0) {
+			for (""" + typename + """std::vector<Slots*>::const_iterator i = _retired.begin(); i != _retired.end(); ++i) {
+				delete *i;
+			}
+			_retired.clear ();
+		}
+	}
+
 	boost::shared_ptr<Connection> _connect (PBD::EventLoop::InvalidationRecord* ir, slot_function_type f)
 	{
 		boost::shared_ptr<Connection> c (new Connection (this, ir));
 		Glib::Threads::Mutex::Lock lm (_mutex);
-		_slots[c] = f;
+		Slots* s = _slots ? new Slots (*_slots) : new Slots;
+		s->insert (s->begin() + slot_position (*s, c), std::make_pair (c, f));
+		_set_slots (s);
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
                 if (_debug_connection) {
-                        std::cerr << "+++++++ CONNECT " << this << " size now " << _slots.size() << std::endl;
+                        std::cerr << "+++++++ CONNECT " << this << " size now " << s->size() << std::endl;
                         PBD::stacktrace (std::cerr, 10);
                 }
 #endif
@@ -307,14 +357,30 @@ def signal(f, n, v):
     print("""
 	void disconnect (boost::shared_ptr<Connection> c)
 	{
+		size_t remaining = 0;
 		{
 			Glib::Threads::Mutex::Lock lm (_mutex);
-    			_slots.erase (c);
-    		}
+			if (_slots) {
+				size_t const p = slot_position (*_slots, c);
+				if (p < _slots->size () && (*_slots)[p].first == c) {
+					Slots* s = 0;
+					if (_slots->size () > 1) {
+						s = new Slots;
+						s->reserve (_slots->size () - 1);
+						s->insert (s->end(), _slots->begin(), _slots->begin() + p);
+						s->insert (s->end(), _slots->begin() + p + 1, _slots->end());
+						remaining = s->size ();
+					}
+					_set_slots (s);
+				} else {
+					remaining = _slots->size ();
+				}
+			}
+		}
 		c->disconnected ();
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
                	if (_debug_connection) {
-    			std::cerr << "------- DISCCONNECT " << this << " size now " << _slots.size() << std::endl;
+    			std::cerr << "------- DISCCONNECT " << this << " size now " << remaining << std::endl;
                         PBD::stacktrace (std::cerr, 10);
 		}
 #endif
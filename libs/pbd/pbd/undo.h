@@ -25,6 +25,7 @@
 #include <map>
 #include <sigc++/slot.h>
 #include <sigc++/bind.h>
+#include <boost/function.hpp>
 #ifndef  COMPILER_MSVC
 #include <sys/time.h>
 #else
@@ -57,6 +58,9 @@ class LIBPBD_API UndoTransaction : public Command
 
 	XMLNode &get_state();
 
+	size_t memory_cost () const;
+	void compact ();
+
 	void set_timestamp (struct timeval &t) {
 		_timestamp = t;
 	}
@@ -69,6 +73,7 @@ class LIBPBD_API UndoTransaction : public Command
 	std::list<Command*>    actions;
 	struct timeval        _timestamp;
 	bool                  _clearing;
+	mutable size_t        _memory_cost;
 
 	friend void command_death (UndoTransaction*, Command *);
 
@@ -79,16 +84,16 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
 {
   public:
 	UndoHistory();
-	~UndoHistory() {}
+	~UndoHistory();
 
 	void add (UndoTransaction* ut);
 	void undo (unsigned int n);
 	void redo (unsigned int n);
 
-	unsigned long undo_depth() const { return UndoList.size(); }
+	unsigned long undo_depth() const { return UndoList.size() + _spilled.size(); }
 	unsigned long redo_depth() const { return RedoList.size(); }
 
-	std::string next_undo() const { return (UndoList.empty() ? std::string() : UndoList.back()->name()); }
+	std::string next_undo() const;
 	std::string next_redo() const { return (RedoList.empty() ? std::string() : RedoList.back()->name()); }
 
 	void clear ();
@@ -108,6 +113,27 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
 
 	void set_depth (uint32_t);
 
+	/** Limit the memory held by undo transactions to @a bytes (0 for no
+	 *  limit); the most recent transaction is always kept. The oldest
+	 *  transactions beyond the limit are spilled, if set_spill() was
+	 *  called, and deleted otherwise.
+	 */
+	void set_memory_limit (size_t bytes);
+
+	/** @return estimate of the memory held by undo transactions, in bytes */
+	size_t memory_cost () const;
+
+	typedef boost::function<UndoTransaction* (XMLNode const &)> TransactionRestorer;
+	typedef boost::function<bool (XMLNode const &)> TransactionChecker;
+
+	/** Write transactions beyond the memory limit to compressed files in
+	 *  @a dir, and recreate them with @a restore when undo reaches them.
+	 *  Only transactions whose state @a can_restore accepts are written;
+	 *  the others stay in memory, in their place in the history.
+	 *  An empty @a dir drops spilled transactions and stops spilling.
+	 */
+	void set_spill (std::string const & dir, TransactionRestorer restore, TransactionChecker can_restore);
+
 	PBD::Signal0<void> Changed;
 	PBD::Signal0<void> BeginUndoRedo;
 	PBD::Signal0<void> EndUndoRedo;
@@ -115,10 +141,35 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
   private:
 	bool _clearing;
 	uint32_t _depth;
+	size_t _memory_limit;
 	std::list<UndoTransaction*> UndoList;
 	std::list<UndoTransaction*> RedoList;
 
+	/** A transaction older than those in UndoList, either written to a
+	 *  spill file or, if it could not be restored from one, kept as it is.
+	 */
+	struct Spilled {
+		Spilled (std::string const & n, uint32_t f, UndoTransaction* k)
+			: name (n), file (f), kept (k) {}
+
+		std::string name;
+		uint32_t file;          ///< spill file number, if kept is 0
+		UndoTransaction* kept;
+	};
+
+	std::string _spill_dir;
+	TransactionRestorer _restore;
+	TransactionChecker _can_restore;
+	std::list<Spilled> _spilled; ///< oldest first
+	uint32_t _next_spill;        ///< file number for the next spilled transaction
+
 	void remove (UndoTransaction*);
+	void trim ();
+	bool spill (UndoTransaction*);
+	bool unspill ();
+	void drop_spilled ();
+	void drop_oldest_spilled ();
+	std::string spill_path (uint32_t) const;
 };
 
 
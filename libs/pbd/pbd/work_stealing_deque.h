@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef __pbd_work_stealing_deque_h__
+#define __pbd_work_stealing_deque_h__
+
+#include <glib.h>
+
+#include "pbd/malign.h"
+
+namespace PBD {
+
+/** A fixed-capacity, lock-free work-stealing deque of pointers
+ *  (Chase & Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005).
+ *
+ *  One thread owns the deque and may push() and pop() at the bottom;
+ *  any other thread may steal() from the top. The deque never grows:
+ *  the caller must guarantee that no more than capacity() items are
+ *  queued at any one time. Indices increase monotonically (they are
+ *  never reset) so that a thief that was preempted between reading the
+ *  indices and claiming a slot can never succeed with a stale index.
+ *
+ *  All glib atomic operations used here imply a full memory barrier.
+ */
+template<class T>
+class /*LIBPBD_API*/ WorkStealingDeque
+{
+  public:
+	WorkStealingDeque (guint sz)
+		: _top (0)
+		, _bottom (0)
+	{
+		guint power_of_two;
+		for (power_of_two = 1; 1U<<power_of_two < sz; power_of_two++) {}
+		_size = 1<<power_of_two;
+		_size_mask = _size - 1;
+		cache_aligned_malloc ((void**) &_buf, _size * sizeof (T*));
+		for (guint i = 0; i < _size; ++i) {
+			_buf[i] = 0;
+		}
+	}
+
+	~WorkStealingDeque () {
+		cache_aligned_free (_buf);
+	}
+
+	guint capacity () const { return _size; }
+
+	/** Owner only: add an item at the bottom */
+	void push (T* item) {
+		gint const b = g_atomic_int_get (&_bottom);
+		g_atomic_pointer_set (&_buf[b & _size_mask], item);
+		g_atomic_int_set (&_bottom, b + 1);
+	}
+
+	/** Owner only: remove the most recently pushed item.
+	 *  @return the item, or 0 if the deque is empty.
+	 */
+	T* pop () {
+		gint const b = g_atomic_int_get (&_bottom) - 1;
+		g_atomic_int_set (&_bottom, b);
+		gint const t = g_atomic_int_get (&_top);
+
+		if (b - t < 0) {
+			/* empty: restore bottom */
+			g_atomic_int_set (&_bottom, t);
+			return 0;
+		}
+
+		T* item = (T*) g_atomic_pointer_get (&_buf[b & _size_mask]);
+
+		if (b - t > 0) {
+			/* more than one item left, no race with thieves */
+			return item;
+		}
+
+		/* last item: race against thieves for it */
+		if (!g_atomic_int_compare_and_exchange (&_top, t, t + 1)) {
+			item = 0;
+		}
+		g_atomic_int_set (&_bottom, t + 1);
+		return item;
+	}
+
+	/** Any thread: remove the least recently pushed item.
+	 *  @return the item, or 0 if the deque is empty or the
+	 *  item was claimed by another thread.
+	 */
+	T* steal () {
+		gint const t = g_atomic_int_get (&_top);
+		gint const b = g_atomic_int_get (&_bottom);
+
+		if (b - t <= 0) {
+			return 0;
+		}
+
+		T* item = (T*) g_atomic_pointer_get (&_buf[t & _size_mask]);
+
+		if (!g_atomic_int_compare_and_exchange (&_top, t, t + 1)) {
+			return 0;
+		}
+		return item;
+	}
+
+	/** Any thread: approximate number of queued items */
+	gint size () const {
+		return g_atomic_int_get (&_bottom) - g_atomic_int_get (&_top);
+	}
+
+  private:
+	WorkStealingDeque (WorkStealingDeque const &);
+	WorkStealingDeque& operator= (WorkStealingDeque const &);
+
+	/* keep the thief-side and owner-side indices on separate cache lines */
+	volatile gint _top;
+	char _pad0[64 - sizeof (gint)];
+	volatile gint _bottom;
+	char _pad1[64 - sizeof (gint)];
+
+	T* volatile* _buf;
+	guint _size;
+	guint _size_mask;
+};
+
+} /* namespace */
+
+#endif /* __pbd_work_stealing_deque_h__ */
@@ -141,6 +141,8 @@ public:
 
 	void dump (std::ostream &, std::string p = "") const;
 
+	size_t memory_cost () const;
+
 private:
 	std::string         _name;
 	bool                _is_content;
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef __libpbd_xml_delta_h__
+#define __libpbd_xml_delta_h__
+
+#include "pbd/libpbd_visibility.h"
+
+class XMLNode;
+
+namespace PBD {
+
+/** Encode @a target as its differences from @a base, so that undo records
+ *  need not hold two full copies of states which mostly agree (e.g. the
+ *  before and after states of a playlist with one region moved).
+ *
+ *  Children of @a target which are equal to children of @a base are replaced
+ *  by references to runs of them; the node itself and other children are
+ *  copied.
+ *
+ *  @return new delta node, or 0 if @a target shares no children with @a base.
+ */
+LIBPBD_API XMLNode* xml_delta (XMLNode const & base, XMLNode const & target);
+
+/** @return new copy of the node encoded by @a delta, which was returned by
+ *  xml_delta() for @a base.
+ */
+LIBPBD_API XMLNode* xml_apply_delta (XMLNode const & base, XMLNode const & delta);
+
+} // namespace PBD
+
+#endif /* __libpbd_xml_delta_h__ */
@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
 #include <glibmm/thread.h>
+#include <glibmm/threads.h>
 
 #include "signals_test.h"
 #include "pbd/signals.h"
+#include "pbd/timing.h"
 
 using namespace std;
 
@@ -89,3 +95,151 @@ SignalsTest::testScopedConnectionList ()
 
 	CPPUNIT_ASSERT_EQUAL (1, N);
 }
+
+static PBD::ScopedConnection others[4];
+
+static void
+disconnect_others ()
+{
+	++N;
+	for (int i = 0; i < 4; ++i) {
+		others[i].disconnect ();
+	}
+}
+
+void
+SignalsTest::testDisconnectDuringEmission ()
+{
+	Emitter* e = new Emitter;
+	PBD::ScopedConnection c;
+
+	/* whichever slot is called first disconnects the slots in others[],
+	 * which must not be called after that; c is called either way, so
+	 * there are one or two calls.
+	 */
+	e->Fred.connect_same_thread (c, boost::bind (&disconnect_others));
+	for (int i = 0; i < 4; ++i) {
+		e->Fred.connect_same_thread (others[i], boost::bind (&disconnect_others));
+	}
+
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT (N >= 1 && N <= 2);
+
+	/* now only c is left */
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, N);
+	CPPUNIT_ASSERT_EQUAL (true, (bool) e->Fred.size ());
+
+	c.disconnect ();
+	CPPUNIT_ASSERT (e->Fred.empty ());
+
+	delete e;
+}
+
+static gint emissions = 0;
+static gint stop_emitting = 0;
+
+static void
+count_emission ()
+{
+	g_atomic_int_inc (&emissions);
+}
+
+static void
+emit_until_stopped (Emitter* e)
+{
+	while (!g_atomic_int_get (&stop_emitting)) {
+		e->emit ();
+	}
+}
+
+void
+SignalsTest::testConcurrentConnection ()
+{
+	Emitter* e = new Emitter;
+	PBD::ScopedConnection c;
+	e->Fred.connect_same_thread (c, boost::bind (&count_emission));
+
+	g_atomic_int_set (&stop_emitting, 0);
+
+	std::vector<Glib::Threads::Thread*> emitters;
+	for (int i = 0; i < 4; ++i) {
+		emitters.push_back (Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&emit_until_stopped), e)));
+	}
+
+	/* connect and disconnect while the other threads emit */
+	for (int i = 0; i < 20000; ++i) {
+		PBD::ScopedConnection d;
+		e->Fred.connect_same_thread (d, boost::bind (&count_emission));
+	}
+
+	g_atomic_int_set (&stop_emitting, 1);
+	for (std::vector<Glib::Threads::Thread*>::iterator i = emitters.begin(); i != emitters.end(); ++i) {
+		(*i)->join ();
+	}
+
+	CPPUNIT_ASSERT_EQUAL (true, (bool) e->Fred.size ());
+
+	g_atomic_int_set (&emissions, 0);
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, g_atomic_int_get (&emissions));
+
+	delete e;
+}
+
+static void
+time_emissions (Emitter* e, int n, PBD::TimingData* timing)
+{
+	timing->start_timing ();
+	for (int i = 0; i < n; ++i) {
+		e->emit ();
+	}
+	timing->add_elapsed ();
+}
+
+void
+SignalsTest::testEmissionThroughput ()
+{
+	int const n = 1000000;
+
+	for (int slots = 0; slots <= 16; slots = slots ? slots * 4 : 1) {
+
+		Emitter* e = new Emitter;
+		PBD::ScopedConnectionList connections;
+		for (int i = 0; i < slots; ++i) {
+			e->Fred.connect_same_thread (connections, boost::bind (&count_emission));
+		}
+
+		/* one emitting thread, then the same number of emissions in
+		 * each of four threads at once
+		 */
+		PBD::TimingData one;
+		time_emissions (e, n, &one);
+
+		std::vector<PBD::TimingData> timings (4);
+		std::vector<Glib::Threads::Thread*> emitters;
+		for (int i = 0; i < 4; ++i) {
+			emitters.push_back (Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&time_emissions), e, n, &timings[i])));
+		}
+		for (std::vector<Glib::Threads::Thread*>::iterator i = emitters.begin(); i != emitters.end(); ++i) {
+			(*i)->join ();
+		}
+
+		uint64_t min, max, avg, total;
+		one.get_min_max_avg_total (min, max, avg, total);
+		std::cout << "\n" << slots << " slots: 1 thread " << n / (double) std::max (total, (uint64_t) 1) << " emissions/us";
+
+		uint64_t slowest = 0;
+		for (int i = 0; i < 4; ++i) {
+			timings[i].get_min_max_avg_total (min, max, avg, total);
+			slowest = std::max (slowest, total);
+		}
+		std::cout << ", 4 threads " << 4 * n / (double) std::max (slowest, (uint64_t) 1) << " emissions/us";
+
+		connections.drop_connections ();
+		delete e;
+	}
+	std::cout << std::endl;
+}
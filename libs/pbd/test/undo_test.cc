@@ -0,0 +1,237 @@
+#include <vector>
+
+#include "pbd/compose.h"
+#include "pbd/convert.h"
+#include "pbd/file_utils.h"
+#include "pbd/undo.h"
+#include "pbd/xml++.h"
+
+#include "undo_test.h"
+#include "test_common.h"
+
+using namespace std;
+using namespace PBD;
+
+CPPUNIT_TEST_SUITE_REGISTRATION (UndoTest);
+
+/** A command which logs its value when done and its negated value when
+ *  undone, holding some memory as a memento would.
+ */
+class ValueCommand : public Command
+{
+public:
+	ValueCommand (vector<int>& log, int value)
+		: _log (log)
+		, _value (value)
+		, _payload (4096)
+	{}
+
+	~ValueCommand () {
+		drop_references ();
+	}
+
+	void operator() () { _log.push_back (_value); }
+	void undo () { _log.push_back (-_value); }
+
+	size_t memory_cost () const {
+		return sizeof (*this) + _payload.capacity ();
+	}
+
+	XMLNode& get_state () {
+		XMLNode* node = new XMLNode ("ValueCommand");
+		node->add_property ("value", (long) _value);
+		return *node;
+	}
+
+private:
+	vector<int>& _log;
+	int _value;
+	vector<char> _payload;
+};
+
+static UndoTransaction*
+transaction (vector<int>& log, int value)
+{
+	UndoTransaction* ut = new UndoTransaction;
+	ut->set_name (string_compose ("set %1", value));
+	ut->add_command (new ValueCommand (log, value));
+	return ut;
+}
+
+static UndoTransaction*
+restore_transaction (XMLNode const & node, vector<int>* log)
+{
+	UndoTransaction* ut = new UndoTransaction;
+	ut->set_name (node.property ("name")->value ());
+
+	for (XMLNodeConstIterator i = node.children().begin(); i != node.children().end(); ++i) {
+		ut->add_command (new ValueCommand (*log, PBD::atoi ((*i)->property ("value")->value ())));
+	}
+
+	return ut;
+}
+
+static bool
+can_restore_all (XMLNode const &)
+{
+	return true;
+}
+
+/** Pretend that transactions for multiples of 3 can't be restored */
+static bool
+can_restore_transaction (XMLNode const & node)
+{
+	for (XMLNodeConstIterator i = node.children().begin(); i != node.children().end(); ++i) {
+		if (PBD::atoi ((*i)->property ("value")->value ()) % 3 == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static size_t
+transaction_cost ()
+{
+	vector<int> log;
+	UndoTransaction* ut = transaction (log, 0);
+	size_t const cost = ut->memory_cost ();
+	delete ut;
+	return cost;
+}
+
+static unsigned long
+saved_transactions (UndoHistory& history, int32_t depth)
+{
+	XMLNode& state (history.get_state (depth));
+	unsigned long const n = state.children().size ();
+	delete &state;
+	return n;
+}
+
+static void
+add_transactions (UndoHistory& history, vector<int>& log, int n)
+{
+	for (int i = 1; i <= n; ++i) {
+		history.add (transaction (log, i));
+	}
+}
+
+void
+UndoTest::testMemoryLimit ()
+{
+	vector<int> log;
+	UndoHistory history;
+
+	size_t const cost = transaction_cost ();
+	CPPUNIT_ASSERT (cost > 4096);
+
+	history.set_memory_limit (cost * 3);
+	add_transactions (history, log, 10);
+
+	/* without anywhere to spill to, the oldest are gone */
+	CPPUNIT_ASSERT_EQUAL (3UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_cost () <= cost * 3);
+
+	history.undo (10);
+	CPPUNIT_ASSERT_EQUAL (3UL, (unsigned long) log.size ());
+	CPPUNIT_ASSERT_EQUAL (-8, log.back ());
+
+	/* the latest transaction stays, whatever its cost */
+	history.set_memory_limit (1);
+	add_transactions (history, log, 1);
+	CPPUNIT_ASSERT_EQUAL (1UL, history.undo_depth ());
+}
+
+void
+UndoTest::testSpill ()
+{
+	vector<int> log;
+	UndoHistory history;
+
+	history.set_spill (test_output_directory ("undo_spill"), boost::bind (&restore_transaction, _1, &log), &can_restore_all);
+
+	size_t const cost = transaction_cost ();
+	history.set_memory_limit (cost * 3);
+	add_transactions (history, log, 10);
+
+	CPPUNIT_ASSERT_EQUAL (10UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_cost () <= cost * 3);
+	CPPUNIT_ASSERT_EQUAL (10UL, saved_transactions (history, -1));
+	CPPUNIT_ASSERT_EQUAL (5UL, saved_transactions (history, 5));
+
+	history.undo (10);
+	CPPUNIT_ASSERT_EQUAL (10UL, (unsigned long) log.size ());
+	for (int i = 0; i < 10; ++i) {
+		CPPUNIT_ASSERT_EQUAL (i - 10, log[i]);
+	}
+	CPPUNIT_ASSERT_EQUAL (0UL, history.undo_depth ());
+	CPPUNIT_ASSERT_EQUAL (10UL, history.redo_depth ());
+
+	/* redo spills again, and undo brings them back again */
+	log.clear ();
+	history.redo (10);
+	CPPUNIT_ASSERT_EQUAL (10UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_cost () <= cost * 3);
+	CPPUNIT_ASSERT_EQUAL (string ("set 10"), history.next_undo ());
+
+	history.undo (10);
+	CPPUNIT_ASSERT_EQUAL (20UL, (unsigned long) log.size ());
+	CPPUNIT_ASSERT_EQUAL (-1, log.back ());
+}
+
+void
+UndoTest::testDepthWithSpill ()
+{
+	vector<int> log;
+	UndoHistory history;
+
+	history.set_spill (test_output_directory ("undo_spill"), boost::bind (&restore_transaction, _1, &log), &can_restore_all);
+
+	size_t const cost = transaction_cost ();
+	history.set_memory_limit (cost * 2);
+	history.set_depth (5);
+	add_transactions (history, log, 10);
+
+	/* the depth counts spilled transactions */
+	CPPUNIT_ASSERT_EQUAL (5UL, history.undo_depth ());
+
+	history.undo (10);
+	CPPUNIT_ASSERT_EQUAL (5UL, (unsigned long) log.size ());
+	CPPUNIT_ASSERT_EQUAL (-6, log.back ());
+}
+
+void
+UndoTest::testKeepUnrestorable ()
+{
+	vector<int> log;
+	UndoHistory history;
+
+	history.set_spill (test_output_directory ("undo_spill"), boost::bind (&restore_transaction, _1, &log), &can_restore_transaction);
+
+	size_t const cost = transaction_cost ();
+	history.set_memory_limit (cost * 3);
+	add_transactions (history, log, 10);
+
+	/* 3, 6 and 9 stay in memory, between those that were spilled */
+	CPPUNIT_ASSERT_EQUAL (10UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_cost () > cost * 3);
+	CPPUNIT_ASSERT (history.memory_cost () <= cost * 6);
+	CPPUNIT_ASSERT_EQUAL (10UL, saved_transactions (history, -1));
+
+	history.undo (10);
+	CPPUNIT_ASSERT_EQUAL (10UL, (unsigned long) log.size ());
+	for (int i = 0; i < 10; ++i) {
+		CPPUNIT_ASSERT_EQUAL (i - 10, log[i]);
+	}
+
+	/* and trimming to a depth deletes them with the spilled ones */
+	log.clear ();
+	history.redo (10);
+	history.set_depth (2);
+	CPPUNIT_ASSERT_EQUAL (2UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_cost () <= cost * 2);
+
+	history.undo (10);
+	CPPUNIT_ASSERT_EQUAL (12UL, (unsigned long) log.size ());
+	CPPUNIT_ASSERT_EQUAL (-9, log.back ());
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class UndoTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (UndoTest);
+	CPPUNIT_TEST (testMemoryLimit);
+	CPPUNIT_TEST (testSpill);
+	CPPUNIT_TEST (testDepthWithSpill);
+	CPPUNIT_TEST (testKeepUnrestorable);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testMemoryLimit ();
+	void testSpill ();
+	void testDepthWithSpill ();
+	void testKeepUnrestorable ();
+};
@@ -3,6 +3,7 @@
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 #include "pbd/xml++.h"
+#include "pbd/xml_delta.h"
 
 #include <stdint.h>
 #include <unistd.h>
@@ -304,3 +305,47 @@ XMLTest::testPerfLargeXMLDocument ()
 
 	test_xml_document ("testPerfLargeXMLDocument", node_options);
 }
+
+static XMLNode*
+make_playlist (int n_regions)
+{
+	XMLNode* node = new XMLNode ("Playlist");
+	node->add_property ("name", "Audio 1");
+
+	for (int i = 0; i < n_regions; ++i) {
+		XMLNode* region = node->add_child ("Region");
+		region->add_property ("id", (long) i);
+		region->add_property ("position", (long) i * 48000);
+		region->add_child ("Envelope")->add_property ("default", "yes");
+	}
+
+	return node;
+}
+
+void
+XMLTest::testDelta ()
+{
+	XMLNode* before = make_playlist (100);
+	XMLNode* after = make_playlist (100);
+
+	/* move one region, remove one and add one */
+	after->children()[10]->property ("position")->set_value ("0");
+	after->remove_nodes_and_delete ("id", "50");
+	after->add_child ("Region")->add_property ("id", (long) 100);
+
+	XMLNode* delta = xml_delta (*before, *after);
+	CPPUNIT_ASSERT (delta);
+	CPPUNIT_ASSERT (delta->memory_cost () < after->memory_cost () / 4);
+
+	XMLNode* applied = xml_apply_delta (*before, *delta);
+	CPPUNIT_ASSERT (*applied == *after);
+
+	/* nothing in common */
+	XMLNode other ("Route");
+	CPPUNIT_ASSERT (xml_delta (other, *after) == 0);
+
+	delete applied;
+	delete delta;
+	delete after;
+	delete before;
+}
@@ -8,6 +8,7 @@ class XMLTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (testPerfSmallXMLDocument);
 	CPPUNIT_TEST (testPerfMediumXMLDocument);
 	CPPUNIT_TEST (testPerfLargeXMLDocument);
+	CPPUNIT_TEST (testDelta);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -15,4 +16,5 @@ public:
 	void testPerfSmallXMLDocument ();
 	void testPerfMediumXMLDocument ();
 	void testPerfLargeXMLDocument ();
+	void testDelta ();
 };
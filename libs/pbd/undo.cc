@@ -22,16 +22,26 @@
 #include <sstream>
 #include <time.h>
 
+#include <glibmm/miscutils.h>
+
+#include "pbd/gstdio_compat.h"
+#include "pbd/compose.h"
+#include "pbd/debug.h"
+#include "pbd/error.h"
 #include "pbd/undo.h"
 #include "pbd/xml++.h"
 
 #include <sigc++/bind.h>
 
+#include "pbd/i18n.h"
+
 using namespace std;
 using namespace sigc;
+using namespace PBD;
 
 UndoTransaction::UndoTransaction ()
 	: _clearing(false)
+	, _memory_cost(0)
 {
 	gettimeofday (&_timestamp, 0);
 }
@@ -39,6 +49,7 @@ UndoTransaction::UndoTransaction ()
 UndoTransaction::UndoTransaction (const UndoTransaction& rhs)
 	: Command(rhs._name)
 	, _clearing(false)
+	, _memory_cost(0)
 {
         _timestamp = rhs._timestamp;
 	clear ();
@@ -72,6 +83,7 @@ UndoTransaction::operator= (const UndoTransaction& rhs)
 	_name = rhs._name;
 	clear ();
 	actions.insert(actions.end(),rhs.actions.begin(),rhs.actions.end());
+	_memory_cost = 0;
 	return *this;
 }
 
@@ -85,12 +97,14 @@ UndoTransaction::add_command (Command *const cmd)
 
 	cmd->DropReferences.connect_same_thread (*this, boost::bind (&command_death, this, cmd));
 	actions.push_back (cmd);
+	_memory_cost = 0;
 }
 
 void
 UndoTransaction::remove_command (Command* const action)
 {
 	actions.remove (action);
+	_memory_cost = 0;
 }
 
 bool
@@ -107,9 +121,34 @@ UndoTransaction::clear ()
 		delete *i;
 	}
 	actions.clear ();
+	_memory_cost = 0;
 	_clearing = false;
 }
 
+/** @return estimate of the memory held by the commands, computed once
+ *  for each change of them.
+ */
+size_t
+UndoTransaction::memory_cost () const
+{
+	if (_memory_cost == 0) {
+		_memory_cost = sizeof (UndoTransaction) + _name.capacity ();
+		for (list<Command*>::const_iterator i = actions.begin(); i != actions.end(); ++i) {
+			_memory_cost += (*i)->memory_cost ();
+		}
+	}
+	return _memory_cost;
+}
+
+void
+UndoTransaction::compact ()
+{
+	for (list<Command*>::iterator i = actions.begin(); i != actions.end(); ++i) {
+		(*i)->compact ();
+	}
+	_memory_cost = 0;
+}
+
 void
 UndoTransaction::operator() ()
 {
@@ -168,56 +207,74 @@ UndoHistory::UndoHistory ()
 {
 	_clearing = false;
 	_depth = 0;
+	_memory_limit = 0;
+	_next_spill = 0;
+}
+
+UndoHistory::~UndoHistory ()
+{
+	drop_spilled ();
 }
 
 void
 UndoHistory::set_depth (uint32_t d)
 {
-	UndoTransaction* ut;
-	uint32_t current_depth = UndoList.size();
-
 	_depth = d;
+	trim ();
+}
 
-	if (d > current_depth) {
-		/* not even transactions to meet request */
-		return;
-	}
-
-	if (_depth > 0) {
+void
+UndoHistory::set_memory_limit (size_t bytes)
+{
+	_memory_limit = bytes;
+	trim ();
+}
 
-		uint32_t cnt = current_depth - d;
+void
+UndoHistory::set_spill (std::string const & dir, TransactionRestorer restore, TransactionChecker can_restore)
+{
+	drop_spilled ();
+	_spill_dir = dir;
+	_restore = restore;
+	_can_restore = can_restore;
+}
 
-		while (cnt--) {
-			ut = UndoList.front();
-			UndoList.pop_front ();
-			delete ut;
+size_t
+UndoHistory::memory_cost () const
+{
+	size_t cost = 0;
+	for (list<UndoTransaction*>::const_iterator i = UndoList.begin(); i != UndoList.end(); ++i) {
+		cost += (*i)->memory_cost ();
+	}
+	for (list<Spilled>::const_iterator i = _spilled.begin(); i != _spilled.end(); ++i) {
+		if (i->kept) {
+			cost += i->kept->memory_cost ();
 		}
 	}
+	return cost;
+}
+
+std::string
+UndoHistory::next_undo () const
+{
+	if (!UndoList.empty ()) {
+		return UndoList.back()->name();
+	}
+	if (!_spilled.empty ()) {
+		return _spilled.back().name;
+	}
+	return std::string ();
 }
 
 void
 UndoHistory::add (UndoTransaction* const ut)
 {
-	uint32_t current_depth = UndoList.size();
-
 	ut->DropReferences.connect_same_thread (*this, boost::bind (&UndoHistory::remove, this, ut));
 
-	/* if the current undo history is larger than or equal to the currently
-	   requested depth, then pop off at least 1 element to make space
-	   at the back for new one.
+	/* the transaction is complete, so its commands can drop whatever
+	   they only needed while it was being built.
 	*/
-
-	if ((_depth > 0) && current_depth && (current_depth >= _depth)) {
-
-		uint32_t cnt = 1 + (current_depth - _depth);
-
-		while (cnt--) {
-			UndoTransaction* ut;
-			ut = UndoList.front ();
-			UndoList.pop_front ();
-			delete ut;
-		}
-	}
+	ut->compact ();
 
 	UndoList.push_back (ut);
 	/* Adding a transacrion makes the redo list meaningless. */
@@ -230,9 +287,153 @@ UndoHistory::add (UndoTransaction* const ut)
 
 	/* we are now owners of the transaction and must delete it when finished with it */
 
+	trim ();
+
+	DEBUG_TRACE (DEBUG::UndoHistory, string_compose ("added \"%1\", %2 bytes; %3 in memory using %4 bytes, %5 spilled\n",
+	                                                 ut->name(), ut->memory_cost(), UndoList.size(), memory_cost(), _spilled.size()));
+
 	Changed (); /* EMIT SIGNAL */
 }
 
+/** Remove the oldest transactions beyond the depth, and spill the oldest
+ *  of those left beyond the memory limit.
+ */
+void
+UndoHistory::trim ()
+{
+	if (_depth > 0) {
+		while (undo_depth () > _depth) {
+			if (!_spilled.empty ()) {
+				drop_oldest_spilled ();
+			} else {
+				UndoTransaction* ut = UndoList.front ();
+				UndoList.pop_front ();
+				delete ut;
+			}
+		}
+	}
+
+	if (_memory_limit > 0) {
+		size_t cost = memory_cost ();
+
+		while (cost > _memory_limit && UndoList.size () > 1) {
+			UndoTransaction* ut = UndoList.front ();
+			UndoList.pop_front ();
+			size_t const ut_cost = ut->memory_cost ();
+			if (spill (ut)) {
+				cost -= min (cost, ut_cost);
+			}
+		}
+	}
+}
+
+/** Write a transaction which has just left the front of the undo list to
+ *  the spill directory, if there is one, and delete it. A transaction
+ *  which could not be restored from its file is kept in memory instead.
+ *  @return true if the transaction is no longer in memory.
+ */
+bool
+UndoHistory::spill (UndoTransaction* ut)
+{
+	if (!_spill_dir.empty ()) {
+
+		XMLTree tree;
+		tree.set_root (&ut->get_state ());
+
+		if (!_can_restore (*tree.root ())) {
+			DEBUG_TRACE (DEBUG::UndoHistory, string_compose ("keeping \"%1\", which can't be restored\n", ut->name()));
+			_spilled.push_back (Spilled (ut->name (), 0, ut));
+			return false;
+		}
+
+		std::string const path = spill_path (_next_spill);
+		tree.set_compression (1);
+
+		if (tree.write (path)) {
+			_spilled.push_back (Spilled (ut->name (), _next_spill++, 0));
+		} else {
+			error << string_compose (_("Could not write undo transaction to %1"), path) << endmsg;
+			/* older transactions can't be undone without this one */
+			drop_spilled ();
+		}
+	}
+
+	delete ut;
+	return true;
+}
+
+/** Recreate the most recently spilled transaction at the front of the undo
+ *  list, skipping those which can no longer be restored.
+ *  @return true if a transaction was restored.
+ */
+bool
+UndoHistory::unspill ()
+{
+	while (!_spilled.empty ()) {
+
+		if (UndoTransaction* ut = _spilled.back().kept) {
+			_spilled.pop_back ();
+			UndoList.push_front (ut);
+			return true;
+		}
+
+		std::string const path = spill_path (_spilled.back().file);
+		UndoTransaction* ut = 0;
+
+		{
+			XMLTree tree;
+			if (tree.read (path) && tree.root ()) {
+				ut = _restore (*tree.root ());
+			}
+		}
+
+		::g_unlink (path.c_str ());
+		_spilled.pop_back ();
+
+		if (ut && !ut->empty ()) {
+			ut->DropReferences.connect_same_thread (*this, boost::bind (&UndoHistory::remove, this, ut));
+			UndoList.push_front (ut);
+			return true;
+		}
+
+		error << string_compose (_("Could not restore undo transaction from %1"), path) << endmsg;
+		delete ut;
+	}
+
+	return false;
+}
+
+void
+UndoHistory::drop_spilled ()
+{
+	while (!_spilled.empty ()) {
+		drop_oldest_spilled ();
+	}
+	_next_spill = 0;
+}
+
+void
+UndoHistory::drop_oldest_spilled ()
+{
+	Spilled const s = _spilled.front ();
+	_spilled.pop_front ();
+
+	if (s.kept) {
+		bool const was_clearing = _clearing;
+		_clearing = true;
+		delete s.kept;
+		_clearing = was_clearing;
+	} else {
+		::g_unlink (spill_path (s.file).c_str ());
+	}
+}
+
+std::string
+UndoHistory::spill_path (uint32_t n) const
+{
+	return Glib::build_filename (_spill_dir, string_compose ("%1.undo", n));
+}
+
 void
 UndoHistory::remove (UndoTransaction* const ut)
 {
@@ -243,6 +444,13 @@ UndoHistory::remove (UndoTransaction* const ut)
 	UndoList.remove (ut);
 	RedoList.remove (ut);
 
+	for (list<Spilled>::iterator i = _spilled.begin(); i != _spilled.end(); ++i) {
+		if (i->kept == ut) {
+			_spilled.erase (i);
+			break;
+		}
+	}
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -260,7 +468,7 @@ UndoHistory::undo (unsigned int n)
 		UndoRedoSignaller exception_safe_signaller (*this);
 
 		while (n--) {
-			if (UndoList.size() == 0) {
+			if (UndoList.size() == 0 && !unspill ()) {
 				return;
 			}
 			UndoTransaction* ut = UndoList.back ();
@@ -294,6 +502,8 @@ UndoHistory::redo (unsigned int n)
 		}
 	}
 
+	trim ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -319,6 +529,7 @@ UndoHistory::clear_undo ()
                 delete *i;
         }
 	UndoList.clear ();
+	drop_spilled ();
 	_clearing = false;
 
 	Changed (); /* EMIT SIGNAL */
@@ -336,36 +547,44 @@ UndoHistory::clear ()
 XMLNode&
 UndoHistory::get_state (int32_t depth)
 {
-    XMLNode *node = new XMLNode ("UndoHistory");
-
-    if (depth == 0) {
-
-	    return (*node);
+	XMLNode *node = new XMLNode ("UndoHistory");
 
-    } else if (depth < 0) {
+	if (depth == 0) {
+		return (*node);
+	}
 
-	    /* everything */
+	/* the last "depth" transactions, or everything if depth < 0,
+	   oldest first, starting with those that were spilled.
+	*/
 
-	    for (list<UndoTransaction*>::iterator it = UndoList.begin(); it != UndoList.end(); ++it) {
-		    node->add_child_nocopy((*it)->get_state());
-	    }
+	uint32_t in_memory = UndoList.size ();
+	uint32_t spilled = _spilled.size ();
 
-    } else {
+	if (depth > 0) {
+		in_memory = min ((uint32_t) depth, in_memory);
+		spilled = min ((uint32_t) depth - in_memory, spilled);
+	}
 
-	    /* just the last "depth" transactions */
+	list<Spilled>::iterator s = _spilled.end ();
+	advance (s, -(long) spilled);
 
-	    list<UndoTransaction*> in_order;
+	for (; s != _spilled.end (); ++s) {
+		if (s->kept) {
+			node->add_child_nocopy (s->kept->get_state ());
+			continue;
+		}
+		XMLTree tree;
+		if (tree.read (spill_path (s->file)) && tree.root ()) {
+			node->add_child_copy (*tree.root ());
+		}
+	}
 
-	    for (list<UndoTransaction*>::reverse_iterator it = UndoList.rbegin(); it != UndoList.rend() && depth; ++it, depth--) {
-		    in_order.push_front (*it);
-	    }
+	list<UndoTransaction*>::iterator it = UndoList.end ();
+	advance (it, -(long) in_memory);
 
-	    for (list<UndoTransaction*>::iterator it = in_order.begin(); it != in_order.end(); it++) {
-		    node->add_child_nocopy((*it)->get_state());
-	    }
-    }
+	for (; it != UndoList.end (); ++it) {
+		node->add_child_nocopy ((*it)->get_state ());
+	}
 
-    return *node;
+	return *node;
 }
-
-
@@ -798,3 +798,25 @@ XMLNode::dump (ostream& s, string p) const
 		s << p << "</" << _name << ">\n";
 	}
 }
+
+/** @return an estimate of the memory used by a node, its properties and
+ *  children, as held by undo records.
+ */
+size_t
+XMLNode::memory_cost () const
+{
+	size_t cost = sizeof (XMLNode) + _name.capacity () + _content.capacity ();
+
+	cost += (_children.capacity () + _selected_children.capacity ()) * sizeof (XMLNode*);
+	cost += _proplist.capacity () * sizeof (XMLProperty*);
+
+	for (XMLPropertyList::const_iterator i = _proplist.begin(); i != _proplist.end(); ++i) {
+		cost += sizeof (XMLProperty) + (*i)->name().capacity() + (*i)->value().capacity();
+	}
+
+	for (XMLNodeList::const_iterator i = _children.begin(); i != _children.end(); ++i) {
+		cost += (*i)->memory_cost ();
+	}
+
+	return cost;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "pbd/convert.h"
+#include "pbd/xml++.h"
+#include "pbd/xml_delta.h"
+
+using namespace std;
+
+/** Name of the children of a delta which refer to a child of the base */
+static const char* const shared_child = "XMLDeltaShared";
+
+/** @return a key which equal nodes share, to find candidates for a child
+ *  without comparing it to every child of the base.
+ */
+static string
+match_key (XMLNode const & node)
+{
+	if (node.is_content ()) {
+		return node.content ();
+	}
+
+	string key = node.name ();
+
+	for (XMLPropertyConstIterator i = node.properties().begin(); i != node.properties().end(); ++i) {
+		key += '\n';
+		key += (*i)->value ();
+	}
+
+	return key;
+}
+
+static bool
+has_shared_child (XMLNodeList const & children)
+{
+	for (XMLNodeConstIterator i = children.begin(); i != children.end(); ++i) {
+		if (!(*i)->is_content () && (*i)->name () == shared_child) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static XMLNode*
+copy_node_properties (XMLNode const & node)
+{
+	XMLNode* copy = new XMLNode (node.name ());
+
+	for (XMLPropertyConstIterator i = node.properties().begin(); i != node.properties().end(); ++i) {
+		copy->add_property ((*i)->name().c_str(), (*i)->value());
+	}
+
+	return copy;
+}
+
+XMLNode*
+PBD::xml_delta (XMLNode const & base, XMLNode const & target)
+{
+	XMLNodeList const & base_children = base.children ();
+	XMLNodeList const & target_children = target.children ();
+
+	if (target.is_content () || base_children.empty () ||
+	    has_shared_child (base_children) || has_shared_child (target_children)) {
+		return 0;
+	}
+
+	XMLNode* delta = copy_node_properties (target);
+	multimap<string, XMLNodeList::size_type> base_by_key;
+	XMLNodeList::size_type next = 0;
+	XMLNodeList::size_type shared = 0;
+	XMLNode* run = 0;
+	XMLNodeList::size_type run_start = 0;
+
+	for (XMLNodeConstIterator t = target_children.begin(); t != target_children.end(); ++t) {
+
+		XMLNodeList::size_type match = base_children.size ();
+
+		/* changes are mostly edits in place, so try the child following the
+		   last match before looking elsewhere.
+		*/
+
+		if (next < base_children.size () && *base_children[next] == **t) {
+			match = next;
+		} else {
+			if (base_by_key.empty ()) {
+				for (XMLNodeList::size_type n = 0; n < base_children.size (); ++n) {
+					base_by_key.insert (make_pair (match_key (*base_children[n]), n));
+				}
+			}
+
+			typedef multimap<string, XMLNodeList::size_type>::const_iterator KeyIterator;
+			pair<KeyIterator, KeyIterator> candidates = base_by_key.equal_range (match_key (**t));
+
+			for (KeyIterator c = candidates.first; c != candidates.second; ++c) {
+				if (*base_children[c->second] == **t) {
+					match = c->second;
+					break;
+				}
+			}
+		}
+
+		if (match == base_children.size ()) {
+			delta->add_child_copy (**t);
+			run = 0;
+			continue;
+		}
+
+		/* runs of children shared in order take one reference */
+
+		if (run && match == next) {
+			run->add_property ("count", (long) (match - run_start + 1));
+		} else {
+			run = delta->add_child (shared_child);
+			run->add_property ("first", (long) match);
+			run->add_property ("count", 1L);
+			run_start = match;
+		}
+
+		next = match + 1;
+		++shared;
+	}
+
+	if (shared == 0) {
+		delete delta;
+		return 0;
+	}
+
+	return delta;
+}
+
+XMLNode*
+PBD::xml_apply_delta (XMLNode const & base, XMLNode const & delta)
+{
+	XMLNodeList const & base_children = base.children ();
+	XMLNode* node = copy_node_properties (delta);
+
+	for (XMLNodeConstIterator i = delta.children().begin(); i != delta.children().end(); ++i) {
+
+		if ((*i)->is_content () || (*i)->name () != shared_child) {
+			node->add_child_copy (**i);
+			continue;
+		}
+
+		XMLProperty const * first = (*i)->property ("first");
+		XMLProperty const * count = (*i)->property ("count");
+
+		if (!first || !count) {
+			continue;
+		}
+
+		XMLNodeList::size_type n = max (0, PBD::atoi (first->value ()));
+		XMLNodeList::size_type const end = min (base_children.size (), n + max (0, PBD::atoi (count->value ())));
+
+		for (; n < end; ++n) {
+			node->add_child_copy (*base_children[n]);
+		}
+	}
+
+	return node;
+}
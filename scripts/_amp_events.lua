@@ -0,0 +1,73 @@
+ardour {
+	["type"]    = "dsp",
+	name        = "Simple Amp Events",
+	category    = "Example",
+	license     = "MIT",
+	author      = "Ardour Lua Task Force",
+	description = [[
+	An Example DSP Plugin for processing audio, to
+	be used with Ardour's Lua scripting facility.
+
+	Automation is applied sample-accurately when the
+	"plugin-automation-events" preference is enabled.]]
+}
+
+function dsp_ioconfig ()
+	return
+	{
+		{ audio_in = -1, audio_out = -1},
+	}
+end
+
+
+function dsp_params ()
+	return
+	{
+		{ ["type"] = "input", name = "Gain", min = -20, max = 20, default = 0, unit="dB"},
+	}
+end
+
+local events = nil -- control changes during the current cycle
+
+-- called before dsp_run () with the control changes of the cycle,
+-- a list of { time = sample, port = control-port, value = new-value }
+-- (1-based time and port) in time order.
+-- The value at the start of the cycle is already in CtrlPorts.
+function dsp_ctrl_events (ev)
+	events = ev
+end
+
+function dsp_run (ins, outs, n_samples)
+	local ctrl = CtrlPorts:array () -- get control port array
+	local gain = ctrl[1]
+	local off = 0 -- already processed samples
+	local e = 1 -- next event
+
+	while off < n_samples do
+		-- process up to the next event or the end of the cycle
+		local siz = n_samples - off
+		if events and events[e] then
+			siz = events[e].time - 1 - off
+		end
+
+		if siz > 0 then
+			local g = ARDOUR.DSP.dB_to_coefficient (gain)
+			for c = 1,#ins do
+				if ins[c] ~= outs[c] then
+					ARDOUR.DSP.copy_vector (outs[c]:offset (off), ins[c]:offset (off), siz)
+				end
+				ARDOUR.DSP.apply_gain_to_buffer (outs[c]:offset (off), siz, g)
+			end
+			off = off + siz
+		end
+
+		if events and events[e] then
+			if events[e].port == 1 then
+				gain = events[e].value
+			end
+			e = e + 1
+		end
+	end
+
+	events = nil
+end
@@ -0,0 +1,14 @@
+ardour { ["type"] = "Snippet", name = "Disk Refill Stats" }
+
+function factory () return function ()
+	-- time (in usec) that the butler and its disk I/O threads spent
+	-- reading each track from disk
+	for t in Session:get_tracks():iter() do
+		local s = t:refill_stats ()
+		local avg = 0
+		if s.count > 0 then avg = s.total / s.count end
+		print (string.format ("%-24s refills: %6d last: %6d max: %6d avg: %8.1f",
+		                      t:name(), s.count, s.last, s.max, avg))
+		t:reset_refill_stats ()
+	end
+end end